@@ -44,6 +44,11 @@ namespace estd
 	void ToUtf16(const char *s, size_t len, std::u16string &u16);
 	void ToUtf8(const char16_t *s, size_t len, std::string &u8, bool throwOnError = false);
 
+	// Converts into the given buffer, which must hold at least Utf16Size(s, len) char16s.
+	// Returns the number of char16s written.
+	//
+	size_t ToUtf16(const char *s, size_t len, char16_t *u16);
+
 	// Returns the number of chars (bytes) in the string
 	//
 	size_t Utf8Size(const std::string &str);
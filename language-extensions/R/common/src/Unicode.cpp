@@ -743,6 +743,40 @@ void ToUtf16(const char *s, size_t l, std::u16string &ans)
 	}
 }
 
+// -------------------------------------------------------------------------------------------------
+// Name: ToUtf16
+//
+// Description:
+//  Converts the given char string with the given length to utf-16 into the given buffer,
+//  which must hold at least Utf16Size(s, l) char16s. Ill-formed sequences are converted the
+//  same way as by the u16string version.
+//
+// Returns:
+//  The number of char16s written.
+//
+size_t ToUtf16(const char *s, size_t l, char16_t *ans)
+{
+	size_t i = 0;
+	size_t j = 0;
+
+	char32_t char32 = 0;
+	size_t char8Len;
+	size_t char16Len = 0;
+
+	bool isIll;
+
+	while (i < l)
+	{
+		GetChar32(s+i, l-i, &char32, &char8Len, &isIll);
+		GetChar16(char32, ans + j, &char16Len);
+
+		j += char16Len;
+		i += char8Len;
+	}
+
+	return j;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Name: ToUtf16
 //
@@ -0,0 +1,79 @@
+//**************************************************************************************************
+// RExtension : A language extension implementing the SQL Server
+// external language communication protocol for R.
+// Copyright (C) 2020 Microsoft Corporation.
+//
+// This file is part of RExtension.
+//
+// RExtension is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RExtension is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RExtension.  If not, see <https://www.gnu.org/licenses/>.
+//
+// @File: RBufferVector.h
+//
+// Purpose:
+//  Class creating R integer and numeric vectors backed by ExtHost column buffers via ALTREP.
+//
+//**************************************************************************************************
+
+#pragma once
+
+// ALTREP is available from R 3.5.0 on.
+//
+#if R_VERSION >= R_Version(3, 5, 0)
+#define REXTENSION_ALTREP
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Name: RBufferVector
+//
+// Description:
+//  Creates integer (INTSXP) and numeric (REALSXP) vectors reading their elements directly from
+//  an ExtHost column buffer instead of a copy, using an ALTREP class.
+//  A vector copies the buffer into memory owned by R the first time R asks to write to it,
+//  and must be detached before the buffer becomes invalid, i.e. before Execute returns.
+//
+class RBufferVector
+{
+public:
+
+	// Registers the ALTREP classes with the embedded R.
+	// Does nothing if ALTREP is not available in this version of R.
+	//
+	static void Init();
+
+	// Returns whether the vectors can be created.
+	//
+	static bool IsAvailable()
+	{
+		return sm_isInitialized;
+	}
+
+	// Creates a vector of the given type, INTSXP or REALSXP,
+	// exposing the rowsNumber elements of the given buffer.
+	//
+	static SEXP Create(
+		SEXPTYPE   type,
+		SQLPOINTER data,
+		SQLULEN    rowsNumber);
+
+	// Copies the buffer of the given vector into memory owned by R,
+	// so the vector stays valid after the buffer is released.
+	//
+	static void Detach(SEXP vectorInR);
+
+private:
+
+	// Whether the ALTREP classes have been registered.
+	//
+	static bool sm_isInitialized;
+};
@@ -161,6 +161,24 @@ public:
 	//
 	void AddDataFrameToEmbeddedR();
 
+	// Copies the column buffers exposed to R without a copy into memory owned by R.
+	//
+	void DetachBufferVectors();
+
+	// Sets whether BIGINT and DECIMAL(p <= 18, 0) columns are added as bit64::integer64.
+	//
+	void UseInteger64(bool useInteger64)
+	{
+		m_useInteger64 = useInteger64;
+	}
+
+	// Sets whether repeated values of character columns share their CHARSXP.
+	//
+	void DedupeStrings(bool dedupeStrings)
+	{
+		m_dedupeStrings = dedupeStrings;
+	}
+
 private:
 
 	// Adds a single column of values into the R DataFrame
@@ -180,6 +198,13 @@ private:
 		SQLULEN     rowsNumber,
 		SQLPOINTER  data);
 
+	// Adds a single column of binary values into the R DataFrame as a list of raw vectors.
+	//
+	void AddBinaryColumnToDataFrame(
+		SQLSMALLINT columnNumber,
+		SQLULEN     rowsNumber,
+		SQLPOINTER  data);
+
 	// Adds a single column of date(time) values into the R DataFrame.
 	//
 	template<class SQLType, class RVectorType, class DateTimeTypeInR>
@@ -195,6 +220,22 @@ private:
 		SQLULEN     rowsNumber,
 		SQLPOINTER  data);
 
+	// Adds a single column of BIGINT or DECIMAL(p <= 18, 0) values into the R DataFrame
+	// as bit64::integer64.
+	//
+	template<class SQLType>
+	void AddInteger64ColumnToDataFrame(
+		SQLSMALLINT columnNumber,
+		SQLULEN     rowsNumber,
+		SQLPOINTER  data);
+
+	// Returns whether any of the rows of a nullable column is null.
+	//
+	static bool HasNullValues(
+		SQLULEN     rowsNumber,
+		SQLINTEGER  *strLen_or_Ind,
+		SQLSMALLINT nullable);
+
 	using fnAddColumn = void (RInputDataSet::*)(
 		SQLSMALLINT columnNumber,
 		SQLULEN     rowsNumber,
@@ -207,6 +248,20 @@ private:
 	// Map typedef.
 	//
 	typedef std::unordered_map<SQLSMALLINT, fnAddColumn> AddColumnFnMap;
+
+	// Whether BIGINT and DECIMAL(p <= 18, 0) columns are added as bit64::integer64
+	// instead of double.
+	//
+	bool m_useInteger64 = false;
+
+	// Whether repeated values of character columns share their CHARSXP.
+	//
+	bool m_dedupeStrings = false;
+
+	// Columns exposed to R directly from the ExtHost buffers,
+	// which must be detached before Execute returns.
+	//
+	std::vector<Rcpp::RObject> m_bufferVectors;
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -271,6 +326,15 @@ private:
 		SQLSMALLINT  &decimalDigits,
 		SQLSMALLINT  &nullable);
 
+	// Gets the bit64::integer64 column information, adds data to m_data and nullmap to
+	// m_columnNullMap.
+	//
+	void GetInteger64ColumnFromDataFrame(
+		SQLUSMALLINT columnNumber,
+		SQLULEN      &columnSize,
+		SQLSMALLINT  &decimalDigits,
+		SQLSMALLINT  &nullable);
+
 	// Gets the character column information, adds data to m_data and nullmap to m_columnNullMap
 	// We always return the character data in utf-8 encoded strings in SQLCHAR character type
 	// since R uses utf-8 by default.
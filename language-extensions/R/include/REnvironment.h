@@ -61,6 +61,14 @@ public:
 	//
 	static std::string GetScriptWithTryCatch(const std::string &script);
 
+	// Parses the given script enclosed in a try catch block once, for repeated evaluation.
+	//
+	static SEXP ParseScript(const std::string &script);
+
+	// Evaluates the parsedScript returned by ParseScript for the given script.
+	//
+	static void EvaluateParsedScript(SEXP parsedScript, const std::string &script);
+
 private:
 
 	// An unique pointer to the embedded R environment via RInside.
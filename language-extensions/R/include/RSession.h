@@ -128,6 +128,13 @@ public:
 
 private:
 
+	// Returns whether the value of a reserved BIT or INT flag parameter is set and non-zero.
+	//
+	static bool IsFlagSet(
+		SQLSMALLINT dataType,
+		SQLPOINTER  paramValue,
+		SQLINTEGER  strLen_or_Ind);
+
 	// Session ID
 	//
 	SQLGUID m_sessionId {0, 0, 0, {0}};
@@ -144,6 +151,11 @@ private:
 	//
 	std::string m_script;
 
+	// The R script parsed once by Init, protected for the lifetime of the session.
+	// R_NilValue if the script could not be parsed.
+	//
+	Rcpp::RObject m_parsedScript;
+
 	// Parameter container.
 	//
 	RParamContainer m_paramContainer;
@@ -153,6 +165,16 @@ private:
 	const std::string m_streamingParamName = "@r_rowsPerRead";
 	bool m_isStreaming = false;
 
+	// r_useInteger64 is a reserved input param that, when set to a non-zero value, adds
+	// BIGINT and DECIMAL(p <= 18, 0) input columns as bit64::integer64 instead of double.
+	//
+	const std::string m_integer64ParamName = "@r_useInteger64";
+
+	// r_dedupeStrings is a reserved input param that, when set to a non-zero value, makes
+	// repeated values of character input columns share their R string.
+	//
+	const std::string m_dedupeStringsParamName = "@r_dedupeStrings";
+
 	std::vector<SQLSMALLINT> m_partitionByIndexes;
 	std::vector<SQLSMALLINT> m_orderByIndexes;
 
@@ -41,15 +41,45 @@ public:
 		SQLINTEGER  *strLen_or_Ind,
 		SQLSMALLINT nullable);
 
+	// Returns whether values of SQLType have the same in-memory representation as the elements
+	// of RVectorType, so a buffer of them can be copied into or used as an R vector as is.
+	//
+	template<class SQLType, class RVectorType, SQLSMALLINT DataType>
+	static constexpr bool HasSameRepresentation()
+	{
+		using ElementType = typename RVectorType::stored_type;
+
+		return DataType != SQL_C_BIT &&
+			sizeof(SQLType) == sizeof(ElementType) &&
+			std::is_floating_point_v<SQLType> == std::is_floating_point_v<ElementType> &&
+			std::is_signed_v<SQLType> == std::is_signed_v<ElementType>;
+	}
+
 	// Creates a character vector in R with the data of type CharType.
 	// CharType could be the default char with utf8 encoding,
 	// or char16_t with utf16 encoding.
+	// If dedupe is true, repeated values share their CHARSXP through a small cache.
 	//
 	template<class CharType>
 	static Rcpp::CharacterVector CreateCharacterVector(
 		SQLULEN    rowsNumber,
 		SQLPOINTER data,
-		SQLINTEGER *strLen_or_Ind);
+		SQLINTEGER *strLen_or_Ind,
+		bool       dedupe = false);
+
+	// Returns whether the given characters are all ASCII.
+	//
+	template<class CharType>
+	static bool IsAscii(
+		const CharType *str,
+		SQLULEN        length);
+
+	// Returns the CHARSXP of the given utf8 string, looking it up in dedupeCache if not empty.
+	//
+	static SEXP MakeCharacter(
+		const char        *str,
+		size_t            length,
+		std::vector<SEXP> &dedupeCache);
 
 	// Creates a raw vector in R corresponding to the given binary data.
 	//
@@ -58,15 +88,29 @@ public:
 		SQLPOINTER data,
 		SQLINTEGER *strLen_or_Ind);
 
-	// Creates a date/datetime vector in R corresponding to the given data.
+	// Creates a list in R with a raw vector for each element of the given binary data.
 	//
-	template<class SQLType, class RVectorType, class DateTimeTypeInR>
-	static RVectorType CreateDateTimeVector(
+	static Rcpp::List CreateRawListVector(
+		SQLULEN    rowsNumber,
+		SQLPOINTER data,
+		SQLINTEGER *strLen_or_Ind);
+
+	// Creates a Date/POSIXct classed numeric vector in R corresponding to the given data.
+	//
+	template<class SQLType, class DateTimeTypeInR>
+	static Rcpp::NumericVector CreateDateTimeVector(
 		SQLULEN     rowsNumber,
 		SQLPOINTER  data,
 		SQLINTEGER  *strLen_or_Ind,
 		SQLSMALLINT nullable);
 
+	// Computes the number of days between 1970-01-01 and the given date.
+	//
+	static long long GetDaysSinceEpoch(
+		SQLSMALLINT  year,
+		SQLUSMALLINT month,
+		SQLUSMALLINT day);
+
 	// Creates a numeric vector in R corresponding to the data of type SQL_NUMERIC_STRUCT.
 	//
 	static Rcpp::NumericVector CreateNumericVector(
@@ -76,8 +120,18 @@ public:
 		SQLSMALLINT decimalDigits,
 		SQLSMALLINT nullable);
 
+	// Creates a bit64::integer64 vector in R corresponding to the BIGINT or
+	// DECIMAL(p <= 18, 0) data.
+	//
+	template<class SQLType>
+	static Rcpp::NumericVector CreateInteger64Vector(
+		SQLULEN     rowsNumber,
+		SQLPOINTER  data,
+		SQLINTEGER  *strLen_or_Ind,
+		SQLSMALLINT nullable);
+
 	// Given a little endian byte array of max length SQL_MAX_NUMERIC_LEN,
-	// converts it into a double value of base 10.
+	// converts it into the nearest double value.
 	//
 	static double ConvertBytesToDouble(const SQLCHAR *leBytesArray);
 
@@ -98,15 +152,15 @@ public:
 		SQLINTEGER           *strLen_or_Ind,
 		SQLSMALLINT          &nullable);
 
-	// Given the unicode string, inserts it into the data vector based on the rowsNumber in the data
-	// and the length of the string adjusted as per allowedLen.
+	// Given the bit64::integer64 vectorInR, copies its content into the given std::vector
+	// pointed to by data.
 	//
-	template<class SQLType, class UnicodeString>
-	static SQLINTEGER InsertStringBasedOnLengthAndRowsNumber(
-		const SQLULEN         allowedLen,
-		const SQLULEN         rowsNumber,
-		std::vector<SQLType>  *data,
-		UnicodeString         &unicodeString);
+	static void FillDataFromInteger64Vector(
+		SQLULEN                rowsNumber,
+		Rcpp::NumericVector    vectorInR,
+		std::vector<SQLBIGINT> *data,
+		SQLINTEGER             *strLenOrInd,
+		SQLSMALLINT            &nullable);
 
 	// Given the vectorInR, copies its content into the given std::vector pointed to by charVector.
 	//
@@ -120,6 +174,27 @@ public:
 		SQLSMALLINT           &nullable,
 		SQLULEN               &maxLen);
 
+	// Sets the SQLType lengths of the strings of vectorInR in strLenOrInd
+	// and returns the number of SQLType characters needed to hold them all.
+	//
+	template<class SQLType>
+	static SQLULEN GetCharacterVectorLengths(
+		SQLULEN               rowsNumber,
+		Rcpp::CharacterVector vectorInR,
+		SQLULEN               allowedLen,
+		SQLINTEGER            *strLenOrInd,
+		SQLSMALLINT           &nullable,
+		SQLULEN               &maxLen);
+
+	// Copies the strings of vectorInR into data, with the lengths set by GetCharacterVectorLengths.
+	//
+	template<class SQLType>
+	static void CopyCharacterVector(
+		SQLULEN               rowsNumber,
+		Rcpp::CharacterVector vectorInR,
+		SQLINTEGER            *strLenOrInd,
+		SQLType               *data);
+
 	// Given the raw vectorInR, copies its content into the given std::vector
 	// pointed to by rawCharVector.
 	//
@@ -129,16 +204,40 @@ public:
 		std::vector<SQLCHAR> *data,
 		SQLINTEGER           *strLenOrInd);
 
-	// Given the vectorInR, copies its content into the given std::vector pointed to by data.
+	// Given the list of raw vectors listInR, copies the raw vectors one after the other into the
+	// given std::vector pointed to by data, one row per list item.
+	//
+	static void FillDataFromRawList(
+		SQLULEN              rowsNumber,
+		Rcpp::List           listInR,
+		std::vector<SQLCHAR> *data,
+		SQLINTEGER           *strLenOrInd,
+		SQLSMALLINT          &nullable,
+		SQLULEN              &maxLen);
+
+	// Returns whether the given vectorInR is a list whose items are all raw vectors or NULL.
+	//
+	static bool IsRawList(SEXP vectorInR);
+
+	// Given the Date/POSIXct vectorInR, copies its content into the given std::vector
+	// pointed to by data.
 	//
-	template<class SQLType, class RVectorType, class DateTimeTypeInR>
+	template<class SQLType, class DateTimeTypeInR>
 	static void FillDataFromDateTimeVector(
 		SQLULEN              rowsNumber,
-		RVectorType          vectorInR,
+		Rcpp::NumericVector  vectorInR,
 		std::vector<SQLType> *data,
 		SQLINTEGER           *strLenOrInd,
 		SQLSMALLINT          &nullable);
 
+	// Computes the date that is the given number of days after 1970-01-01.
+	//
+	static void GetDateFromDaysSinceEpoch(
+		long long    daysSinceEpoch,
+		SQLSMALLINT  &year,
+		SQLUSMALLINT &month,
+		SQLUSMALLINT &day);
+
 	// Given the vectorInR, copies its content into the given std::vector pointed to by data.
 	//
 	static void FillDataFromNumericVector(
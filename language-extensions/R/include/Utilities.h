@@ -53,20 +53,6 @@ public:
 	//
 	static int SetEnvVariable(const std::string &envVarName, const std::string &value);
 
-	// From the given nanoSeconds value, generates a string
-	// representing seconds after the decimal point.
-	//
-	static std::string GetSecondsAfterDecimalPointFromNanoSeconds(
-		SQLUINTEGER nanoSeconds);
-
-	// Finds the current time zone defined in R if any
-	//
-	static std::string GetTimeZoneInR();
-
-	// Sets the time zone in R to the given value or unset it if the value is empty.
-	//
-	static void SetTimeZoneInR(std::string valueToSet);
-
 	// Normalizes path strings by replacting \ with /
 	//
 	static std::string NormalizePathString(std::string pathString);
@@ -0,0 +1,307 @@
+//**************************************************************************************************
+// RExtension : A language extension implementing the SQL Server
+// external language communication protocol for R.
+// Copyright (C) 2020 Microsoft Corporation.
+//
+// This file is part of RExtension.
+//
+// RExtension is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RExtension is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RExtension.  If not, see <https://www.gnu.org/licenses/>.
+//
+// @File: RBufferVector.cpp
+//
+// Purpose:
+//  Class creating R integer and numeric vectors backed by ExtHost column buffers via ALTREP.
+//
+//**************************************************************************************************
+
+#include "Common.h"
+#include <cstring>
+
+#include "RBufferVector.h"
+
+#ifdef REXTENSION_ALTREP
+// R_ext/Altrep.h of R 3.5 uses "class" as a parameter name, which is reserved in C++.
+//
+#if R_VERSION < R_Version(3, 6, 0)
+#define class klass
+extern "C" {
+#include <R_ext/Altrep.h>
+}
+#undef class
+#else
+#include <R_ext/Altrep.h>
+#endif
+#include <R_ext/Rdynload.h>
+#endif
+
+using namespace std;
+
+bool RBufferVector::sm_isInitialized = false;
+
+#ifdef REXTENSION_ALTREP
+namespace
+{
+	// The ALTREP classes of the integer and numeric vectors.
+	// data1 of a vector is an external pointer to the buffer, tagged with the number of elements.
+	// data2 is R_NilValue until the buffer is copied into a standard vector, then it is that copy.
+	//
+	R_altrep_class_t integerBufferClass;
+	R_altrep_class_t realBufferClass;
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ElementSize
+	//
+	// Description:
+	//  Returns the size of an element of the given vector.
+	//
+	size_t ElementSize(SEXP vectorInR)
+	{
+		return TYPEOF(vectorInR) == INTSXP ? sizeof(int) : sizeof(double);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: Length
+	//
+	// Description:
+	//  ALTREP method returning the number of elements of the vector.
+	//
+	R_xlen_t Length(SEXP vectorInR)
+	{
+		return static_cast<R_xlen_t>(REAL(R_ExternalPtrTag(R_altrep_data1(vectorInR)))[0]);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: DataptrOrNull
+	//
+	// Description:
+	//  ALTREP method returning a read only pointer to the elements,
+	//  which is the buffer itself until it has been copied.
+	//
+	const void* DataptrOrNull(SEXP vectorInR)
+	{
+		SEXP copy = R_altrep_data2(vectorInR);
+		if (copy != R_NilValue)
+		{
+			return TYPEOF(copy) == INTSXP ?
+				static_cast<void*>(INTEGER(copy)) : static_cast<void*>(REAL(copy));
+		}
+
+		return R_ExternalPtrAddr(R_altrep_data1(vectorInR));
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: Materialize
+	//
+	// Description:
+	//  Copies the buffer into a standard vector stored as data2, and clears the buffer pointer.
+	//
+	// Returns:
+	//  The standard vector.
+	//
+	SEXP Materialize(SEXP vectorInR)
+	{
+		R_xlen_t length = Length(vectorInR);
+		SEXP buffer = R_altrep_data1(vectorInR);
+		Rcpp::Shield<SEXP> copy(Rf_allocVector(TYPEOF(vectorInR), length));
+		void *copyData = TYPEOF(copy) == INTSXP ?
+			static_cast<void*>(INTEGER(copy)) : static_cast<void*>(REAL(copy));
+
+		if (length > 0)
+		{
+			memcpy(copyData, R_ExternalPtrAddr(buffer), length * ElementSize(vectorInR));
+		}
+
+		R_set_altrep_data2(vectorInR, copy);
+		R_ClearExternalPtr(buffer);
+
+		return copy;
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: Dataptr
+	//
+	// Description:
+	//  ALTREP method returning a pointer to the elements.
+	//  The buffer is copied first if the pointer may be written to, since it is owned by ExtHost.
+	//
+	void* Dataptr(SEXP vectorInR, Rboolean writeable)
+	{
+		if (writeable && R_altrep_data2(vectorInR) == R_NilValue)
+		{
+			Materialize(vectorInR);
+		}
+
+		return const_cast<void*>(DataptrOrNull(vectorInR));
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: Duplicate
+	//
+	// Description:
+	//  ALTREP method duplicating the vector into a standard vector with a single copy,
+	//  without materializing the vector itself.
+	//
+	SEXP Duplicate(SEXP vectorInR, Rboolean deep)
+	{
+		R_xlen_t length = Length(vectorInR);
+		Rcpp::Shield<SEXP> duplicate(Rf_allocVector(TYPEOF(vectorInR), length));
+		void *duplicateData = TYPEOF(duplicate) == INTSXP ?
+			static_cast<void*>(INTEGER(duplicate)) : static_cast<void*>(REAL(duplicate));
+
+		if (length > 0)
+		{
+			memcpy(duplicateData, DataptrOrNull(vectorInR), length * ElementSize(vectorInR));
+		}
+
+		return duplicate;
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: IntegerElt
+	//
+	// Description:
+	//  ALTREP method returning a single element of an integer vector.
+	//
+	int IntegerElt(SEXP vectorInR, R_xlen_t index)
+	{
+		return static_cast<const int*>(DataptrOrNull(vectorInR))[index];
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: RealElt
+	//
+	// Description:
+	//  ALTREP method returning a single element of a numeric vector.
+	//
+	double RealElt(SEXP vectorInR, R_xlen_t index)
+	{
+		return static_cast<const double*>(DataptrOrNull(vectorInR))[index];
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: GetRegion
+	//
+	// Description:
+	//  Templatized ALTREP method copying up to count elements starting at start into buffer.
+	//
+	// Returns:
+	//  The number of elements copied.
+	//
+	template<class ElementType>
+	R_xlen_t GetRegion(SEXP vectorInR, R_xlen_t start, R_xlen_t count, ElementType *buffer)
+	{
+		R_xlen_t length = Length(vectorInR);
+		R_xlen_t copied = start < length ? min(count, length - start) : 0;
+
+		if (copied > 0)
+		{
+			memcpy(buffer,
+				static_cast<const ElementType*>(DataptrOrNull(vectorInR)) + start,
+				copied * sizeof(ElementType));
+		}
+
+		return copied;
+	}
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Name: RBufferVector::Init
+//
+// Description:
+//  Registers the ALTREP classes of the integer and numeric vectors with the embedded R.
+//  Must be called once the embedded R has been initialized.
+//
+void RBufferVector::Init()
+{
+	LOG("RBufferVector::Init");
+
+#ifdef REXTENSION_ALTREP
+	if (!sm_isInitialized)
+	{
+		DllInfo *dllInfo = R_getEmbeddingDllInfo();
+
+		integerBufferClass = R_make_altinteger_class("RExtensionIntegerBuffer", "RExtension", dllInfo);
+		R_set_altrep_Length_method(integerBufferClass, Length);
+		R_set_altrep_Duplicate_method(integerBufferClass, Duplicate);
+		R_set_altvec_Dataptr_method(integerBufferClass, Dataptr);
+		R_set_altvec_Dataptr_or_null_method(integerBufferClass, DataptrOrNull);
+		R_set_altinteger_Elt_method(integerBufferClass, IntegerElt);
+		R_set_altinteger_Get_region_method(integerBufferClass, GetRegion<int>);
+
+		realBufferClass = R_make_altreal_class("RExtensionRealBuffer", "RExtension", dllInfo);
+		R_set_altrep_Length_method(realBufferClass, Length);
+		R_set_altrep_Duplicate_method(realBufferClass, Duplicate);
+		R_set_altvec_Dataptr_method(realBufferClass, Dataptr);
+		R_set_altvec_Dataptr_or_null_method(realBufferClass, DataptrOrNull);
+		R_set_altreal_Elt_method(realBufferClass, RealElt);
+		R_set_altreal_Get_region_method(realBufferClass, GetRegion<double>);
+
+		sm_isInitialized = true;
+	}
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RBufferVector::Create
+//
+// Description:
+//  Creates a vector of the given type, INTSXP or REALSXP, exposing the rowsNumber elements of
+//  the given buffer. The buffer must hold elements of the same layout as R's int or double.
+//
+// Returns:
+//  The new vector, unprotected.
+//
+SEXP RBufferVector::Create(
+	SEXPTYPE   type,
+	SQLPOINTER data,
+	SQLULEN    rowsNumber)
+{
+	LOG("RBufferVector::Create");
+
+	if (!sm_isInitialized)
+	{
+		throw runtime_error("RBufferVector has not been initialized.");
+	}
+
+#ifdef REXTENSION_ALTREP
+	Rcpp::Shield<SEXP> length(Rf_ScalarReal(static_cast<double>(rowsNumber)));
+	Rcpp::Shield<SEXP> buffer(R_MakeExternalPtr(data, length, R_NilValue));
+
+	return R_new_altrep(type == INTSXP ? integerBufferClass : realBufferClass, buffer, R_NilValue);
+#else
+	return R_NilValue;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RBufferVector::Detach
+//
+// Description:
+//  Copies the buffer of the given vector into memory owned by R if it has not been copied yet,
+//  so the vector stays valid after ExtHost releases the buffer.
+//  Does nothing for vectors not created by RBufferVector::Create.
+//
+void RBufferVector::Detach(SEXP vectorInR)
+{
+#ifdef REXTENSION_ALTREP
+	if (sm_isInitialized &&
+		(R_altrep_inherits(vectorInR, integerBufferClass) ||
+		 R_altrep_inherits(vectorInR, realBufferClass)) &&
+		R_altrep_data2(vectorInR) == R_NilValue)
+	{
+		Materialize(vectorInR);
+	}
+#endif
+}
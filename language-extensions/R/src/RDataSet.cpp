@@ -26,16 +26,25 @@
 //**************************************************************************************************
 
 #include "Common.h"
+#include <algorithm>
 #include <limits>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "RBufferVector.h"
 #include "RColumn.h"
 #include "RDataSet.h"
 #include "RTypeUtils.h"
 
 using namespace std;
 
+//--------------------------------------------------------------------------------------------------
+// Max precision of the DECIMAL(p, 0) input columns added as bit64::integer64,
+// every such value fits in a 64-bit integer.
+//
+static constexpr SQLULEN x_MaxInteger64Precision = 18;
+
 //--------------------------------------------------------------------------------------------------
 // Function map - maps a ODBC C data type to the function for adding a column
 //
@@ -66,6 +75,8 @@ const RInputDataSet::AddColumnFnMap RInputDataSet::sm_FnAddColumnMap =
 		static_cast<fnAddColumn>(&RInputDataSet::AddCharacterColumnToDataFrame<char>)},
 	{static_cast<SQLSMALLINT>(SQL_C_WCHAR),                 // NCHAR(n), NVARCHAR(n), NVARCHAR(max)
 		static_cast<fnAddColumn>(&RInputDataSet::AddCharacterColumnToDataFrame<char16_t>)},
+	{static_cast<SQLSMALLINT>(SQL_C_BINARY),                // BINARY(n), VARBINARY(n), VARBINARY(max)
+		static_cast<fnAddColumn>(&RInputDataSet::AddBinaryColumnToDataFrame)},
 	{static_cast<SQLSMALLINT>(SQL_C_TYPE_DATE),             // DATE
 		static_cast<fnAddColumn>(&RInputDataSet::AddDateTimeColumnToDataFrame
 		<SQL_DATE_STRUCT, Rcpp::DateVector, Rcpp::Date>)},
@@ -89,6 +100,9 @@ const ROutputDataSet::GetColumnFnMap ROutputDataSet::sm_FnGetColumnMap =
 	{static_cast<SQLSMALLINT>(SQL_C_DOUBLE),
 	 static_cast<fnGetColumn>(
 		 &ROutputDataSet::GetColumnFromDataFrame<Rcpp::NumericVector, SQLDOUBLE, SQL_C_DOUBLE>)},
+	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT),
+	 static_cast<fnGetColumn>(
+		 &ROutputDataSet::GetInteger64ColumnFromDataFrame)},
 	{static_cast<SQLSMALLINT>(SQL_C_CHAR),
 	 static_cast<fnGetColumn>(
 		 &ROutputDataSet::GetCharacterColumnFromDataFrame)},
@@ -118,6 +132,9 @@ const ROutputDataSet::CleanupColumnFnMap ROutputDataSet::sm_FnCleanupColumnMap =
 	{static_cast<SQLSMALLINT>(SQL_C_DOUBLE),
 	 static_cast<fnCleanupColumn>(
 		 &ROutputDataSet::CleanupColumn<SQLDOUBLE>)},
+	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT),
+	 static_cast<fnCleanupColumn>(
+		 &ROutputDataSet::CleanupColumn<SQLBIGINT>)},
 	{static_cast<SQLSMALLINT>(SQL_C_CHAR),
 	 static_cast<fnCleanupColumn>(
 		 &ROutputDataSet::CleanupColumn<SQLCHAR>)},
@@ -287,16 +304,35 @@ void RInputDataSet::AddColumnsToDataFrame(
 			colData = data[columnNumber];
 		}
 
-		SQLSMALLINT dataType = m_columns[columnNumber].get()->DataType();
-		AddColumnFnMap::const_iterator it = sm_FnAddColumnMap.find(dataType);
+		const RColumn *column = m_columns[columnNumber].get();
+		SQLSMALLINT dataType = column->DataType();
+		fnAddColumn addColumn = nullptr;
 
-		if (it == sm_FnAddColumnMap.end())
+		if (m_useInteger64 && dataType == SQL_C_SBIGINT)
 		{
-			throw runtime_error("Unsupported input column type encountered when adding column #"
-				+ to_string(columnNumber));
+			addColumn = &RInputDataSet::AddInteger64ColumnToDataFrame<SQLBIGINT>;
 		}
+		else if (m_useInteger64 &&
+			dataType == SQL_C_NUMERIC &&
+			column->DecimalDigits() == 0 &&
+			column->Size() <= x_MaxInteger64Precision)
+		{
+			addColumn = &RInputDataSet::AddInteger64ColumnToDataFrame<SQL_NUMERIC_STRUCT>;
+		}
+		else
+		{
+			AddColumnFnMap::const_iterator it = sm_FnAddColumnMap.find(dataType);
 
-		(this->*it->second)(
+			if (it == sm_FnAddColumnMap.end())
+			{
+				throw runtime_error("Unsupported input column type encountered when adding column #"
+					+ to_string(columnNumber));
+			}
+
+			addColumn = it->second;
+		}
+
+		(this->*addColumn)(
 			columnNumber,
 			rowsNumber,
 			colData);
@@ -326,6 +362,27 @@ void RInputDataSet::AddColumnToDataFrame(
 	SQLINTEGER *strLen_or_Ind = m_columnNullMap[columnNumber];
 	SQLSMALLINT nullable = m_columns[columnNumber].get()->Nullable();
 
+	// A column without nulls whose values R can use as is is exposed to R without a copy,
+	// reading from the ExtHost buffer until it is detached at the end of Execute.
+	//
+	if constexpr (RTypeUtils::HasSameRepresentation<SQLType, RVectorType, DataType>())
+	{
+		if (RBufferVector::IsAvailable() &&
+			rowsNumber > 0 &&
+			data != nullptr &&
+			!HasNullValues(rowsNumber, strLen_or_Ind, nullable))
+		{
+			Rcpp::RObject bufferVector(RBufferVector::Create(
+				Rcpp::traits::r_sexptype_traits<typename RVectorType::stored_type>::rtype,
+				data,
+				rowsNumber));
+
+			m_bufferVectors.push_back(bufferVector);
+			m_dataFrame[name.c_str()] = bufferVector;
+			return;
+		}
+	}
+
 	m_dataFrame[name.c_str()] = RTypeUtils::CreateVector<SQLType, RVectorType, NAType, DataType>(
 		rowsNumber,
 		data,
@@ -333,6 +390,46 @@ void RInputDataSet::AddColumnToDataFrame(
 		nullable);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RInputDataSet::HasNullValues
+//
+// Description:
+//  Returns whether any of the rowsNumber cells of strLen_or_Ind is SQL_NULL_DATA.
+//  If nullable is SQL_NO_NULLS or strLen_or_Ind is nullptr, there are no null values.
+//
+bool RInputDataSet::HasNullValues(
+	SQLULEN     rowsNumber,
+	SQLINTEGER  *strLen_or_Ind,
+	SQLSMALLINT nullable)
+{
+	if (nullable != SQL_NULLABLE || strLen_or_Ind == nullptr)
+	{
+		return false;
+	}
+
+	return find(strLen_or_Ind, strLen_or_Ind + rowsNumber, SQL_NULL_DATA)
+		!= strLen_or_Ind + rowsNumber;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RInputDataSet::DetachBufferVectors
+//
+// Description:
+//  Copies the ExtHost buffers of the columns exposed to R without a copy into memory owned by R,
+//  since the buffers are only valid until Execute returns.
+//
+void RInputDataSet::DetachBufferVectors()
+{
+	LOG("RInputDataSet::DetachBufferVectors");
+
+	for (Rcpp::RObject &bufferVector : m_bufferVectors)
+	{
+		RBufferVector::Detach(bufferVector);
+	}
+
+	m_bufferVectors.clear();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RInputDataSet::AddCharacterColumnToDataFrame
 //
@@ -356,6 +453,35 @@ void RInputDataSet::AddCharacterColumnToDataFrame(
 	SQLINTEGER *strLen_or_Ind = m_columnNullMap[columnNumber];
 
 	m_dataFrame[name.c_str()] = RTypeUtils::CreateCharacterVector<CharType>(
+		rowsNumber,
+		data,
+		strLen_or_Ind,
+		m_dedupeStrings);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RInputDataSet::AddBinaryColumnToDataFrame
+//
+// Description:
+//  Adds a single column of binary values into the R DataFrame as a list of raw vectors,
+//  one per row, with NULL for the null rows.
+//
+void RInputDataSet::AddBinaryColumnToDataFrame(
+	SQLSMALLINT columnNumber,
+	SQLULEN     rowsNumber,
+	SQLPOINTER  data)
+{
+	LOG("RInputDataSet::AddBinaryColumnToDataFrame");
+
+	if (m_columns[columnNumber] == nullptr)
+	{
+		throw runtime_error("InitColumn not called for column #" + to_string(columnNumber));
+	}
+
+	string name = m_columns[columnNumber].get()->Name();
+	SQLINTEGER *strLen_or_Ind = m_columnNullMap[columnNumber];
+
+	m_dataFrame[name.c_str()] = RTypeUtils::CreateRawListVector(
 		rowsNumber,
 		data,
 		strLen_or_Ind);
@@ -384,7 +510,7 @@ void RInputDataSet::AddDateTimeColumnToDataFrame(
 	SQLINTEGER *strLen_or_Ind = m_columnNullMap[columnNumber];
 	SQLSMALLINT nullable = m_columns[columnNumber].get()->Nullable();
 
-	m_dataFrame[name.c_str()] = RTypeUtils::CreateDateTimeVector<SQLType, RVectorType, DateTimeTypeInR>(
+	m_dataFrame[name.c_str()] = RTypeUtils::CreateDateTimeVector<SQLType, DateTimeTypeInR>(
 		rowsNumber,
 		data,
 		strLen_or_Ind,
@@ -423,6 +549,37 @@ void RInputDataSet::AddNumericColumnToDataFrame(
 			nullable);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RInputDataSet::AddInteger64ColumnToDataFrame
+//
+// Description:
+//  Adds a single column of BIGINT or DECIMAL(p <= 18, 0) values into the R DataFrame
+//  as bit64::integer64, which holds them exactly unlike double.
+//
+template<class SQLType>
+void RInputDataSet::AddInteger64ColumnToDataFrame(
+	SQLSMALLINT columnNumber,
+	SQLULEN     rowsNumber,
+	SQLPOINTER  data)
+{
+	LOG("RInputDataSet::AddInteger64ColumnToDataFrame");
+
+	if (m_columns[columnNumber] == nullptr)
+	{
+		throw runtime_error("InitColumn not called for column #" + to_string(columnNumber));
+	}
+
+	string name = m_columns[columnNumber].get()->Name();
+	SQLINTEGER *strLen_or_Ind = m_columnNullMap[columnNumber];
+	SQLSMALLINT nullable = m_columns[columnNumber].get()->Nullable();
+
+	m_dataFrame[name.c_str()] = RTypeUtils::CreateInteger64Vector<SQLType>(
+		rowsNumber,
+		data,
+		strLen_or_Ind,
+		nullable);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RInputDataSet::AddDataFrameToEmbeddedR
 //
@@ -570,6 +727,51 @@ void ROutputDataSet::GetColumnFromDataFrame(
 	m_columnNullMap.push_back(strLenOrInd);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: ROutputDataSet::GetInteger64ColumnFromDataFrame
+//
+// Description:
+//  Gets bit64::integer64 column information from the underlying m_dataFrame,
+//  adds data to m_data and nullmap to m_columnNullMap.
+//  The column is returned as BIGINT, so that BIGINT input columns added as integer64
+//  when r_useInteger64 is set are returned exactly.
+//
+void ROutputDataSet::GetInteger64ColumnFromDataFrame(
+	SQLUSMALLINT columnNumber,
+	SQLULEN      &columnSize,
+	SQLSMALLINT  &decimalDigits,
+	SQLSMALLINT  &nullable)
+{
+	LOG("ROutputDataSet::GetInteger64ColumnFromDataFrame");
+
+	decimalDigits = 0;
+	nullable = SQL_NO_NULLS;
+	columnSize = sizeof(SQLBIGINT);
+
+	vector<SQLBIGINT> columnData;
+	SQLINTEGER *strLenOrInd = nullptr;
+
+	if(m_rowsNumber > 0)
+	{
+		strLenOrInd = new SQLINTEGER[m_rowsNumber];
+
+		Rcpp::NumericVector column = m_dataFrame[columnNumber];
+		RTypeUtils::FillDataFromInteger64Vector(
+			m_rowsNumber,
+			column,
+			&columnData,
+			strLenOrInd,
+			nullable);
+		m_data.push_back(RTypeUtils::CopySQLTypeVector<SQLBIGINT>(columnData).release());
+	}
+	else
+	{
+		m_data.push_back(nullptr);
+	}
+
+	m_columnNullMap.push_back(strLenOrInd);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: ROutputDataSet::GetCharacterColumnFromDataFrame
 //
@@ -588,7 +790,6 @@ void ROutputDataSet::GetCharacterColumnFromDataFrame(
 	decimalDigits = 0;
 	nullable = SQL_NO_NULLS;
 
-	vector<SQLCHAR> columnData;
 	SQLINTEGER *strLenOrInd = nullptr;
 
 	// maxLen determines the columnSize, which is a property of this column's data type
@@ -606,17 +807,25 @@ void ROutputDataSet::GetCharacterColumnFromDataFrame(
 		// We always return the character data from R as utf-8 encoded
 		// strings since that is the default and so we use SQLCHAR
 		// as the character data type.
+		// The buffer is sized exactly by a first pass, then filled directly by a second one.
 		//
-		RTypeUtils::FillDataFromCharacterVector<SQLCHAR>(
+		SQLULEN totalLength = RTypeUtils::GetCharacterVectorLengths<SQLCHAR>(
 			m_rowsNumber,
 			column,
 			numeric_limits<SQLULEN>::max(),
-			&columnData,
 			strLenOrInd,
 			nullable,
 			maxLen);
 
-		m_data.push_back(RTypeUtils::CopySQLTypeVector<SQLCHAR>(columnData).release());
+		unique_ptr<SQLCHAR[]> columnData(new SQLCHAR[totalLength]);
+
+		RTypeUtils::CopyCharacterVector<SQLCHAR>(
+			m_rowsNumber,
+			column,
+			strLenOrInd,
+			columnData.get());
+
+		m_data.push_back(columnData.release());
 	}
 	else
 	{
@@ -633,6 +842,8 @@ void ROutputDataSet::GetCharacterColumnFromDataFrame(
 // Description:
 //  Gets raw column information from the underlying m_dataFrame,
 //  adds data to m_data and nullmap to m_columnNullMap.
+//  A list of raw vectors, such as a binary input column, is returned with one row per list item.
+//  A raw vector is returned with all its bytes in a single row.
 //
 void ROutputDataSet::GetRawColumnFromDataFrame(
 	SQLUSMALLINT columnNumber,
@@ -646,6 +857,39 @@ void ROutputDataSet::GetRawColumnFromDataFrame(
 	nullable = SQL_NO_NULLS;
 
 	vector<SQLCHAR> columnData;
+
+	if (TYPEOF(VECTOR_ELT(static_cast<SEXP>(m_dataFrame), columnNumber)) == VECSXP)
+	{
+		SQLINTEGER *strLenOrInd = nullptr;
+
+		// Since binary(0) is an illegal data type, columnSize has to be at least sizeof(SQLCHAR).
+		//
+		SQLULEN maxLen = sizeof(SQLCHAR);
+
+		if (m_rowsNumber > 0)
+		{
+			strLenOrInd = new SQLINTEGER[m_rowsNumber];
+
+			RTypeUtils::FillDataFromRawList(
+				m_rowsNumber,
+				m_dataFrame[columnNumber],
+				&columnData,
+				strLenOrInd,
+				nullable,
+				maxLen);
+
+			m_data.push_back(RTypeUtils::CopySQLTypeVector<SQLCHAR>(columnData).release());
+		}
+		else
+		{
+			m_data.push_back(nullptr);
+		}
+
+		columnSize = maxLen;
+		m_columnNullMap.push_back(strLenOrInd);
+		return;
+	}
+
 	SQLINTEGER* strLenOrInd = new SQLINTEGER[m_rowsNumber];
 
 	Rcpp::RawVector column = m_dataFrame[columnNumber];
@@ -729,8 +973,8 @@ void ROutputDataSet::GetDateTimeColumnFromDataFrame(
 	{
 		strLenOrInd = new SQLINTEGER[m_rowsNumber];
 
-		RVectorType column = m_dataFrame[columnNumber];
-		RTypeUtils::FillDataFromDateTimeVector<SQLType, RVectorType, DateTimeTypeInR>(
+		Rcpp::NumericVector column = m_dataFrame[columnNumber];
+		RTypeUtils::FillDataFromDateTimeVector<SQLType, DateTimeTypeInR>(
 			m_rowsNumber,
 			column,
 			&columnData,
@@ -779,7 +1023,11 @@ void ROutputDataSet::GetColumnsDataType()
 // Name: ROutputDataSet::GetColumnDataType
 //
 // Description:
-//  First, evaluates class(m_name[1,columnNumber+1]) to give the R class.
+//  First, finds the R class of the column from the column vector itself: the first element of
+//  its class attribute if it has one, e.g. "POSIXct" for c("POSIXct", "POSIXt"),
+//  otherwise the implicit class given by its SEXP type, or "matrix" if it has dimensions.
+//  This is the same class as class(m_name[1,columnNumber+1])[1] without evaluating any R code.
+//  A list of raw vectors or NULLs, e.g. a binary input column returned as is, has the class "raw".
 //  Then gets the column data type by looking up the map with the R class as the key.
 //
 // Returns:
@@ -789,26 +1037,56 @@ SQLSMALLINT ROutputDataSet::GetColumnDataType(SQLUSMALLINT columnNumber)
 {
 	LOG("ROutputDataSet::GetColumnDataType");
 
-	// R follows 1-based indices so need to add 1 to columnNumber.
-	//
-	SQLUSMALLINT columnNumberInR = columnNumber + 1;
+	SEXP column = VECTOR_ELT(static_cast<SEXP>(m_dataFrame), columnNumber);
+	SEXP classAttribute = Rf_getAttrib(column, R_ClassSymbol);
+	string classInR;
 
-	// Construct the script to find class in R.
-	// For POSIXct data type, the class is a vector with 2 elements : "POSIXct" "POSIXt"
-	// but we need only the first element hence add the subscript [1].
-	// For other data types, the class is only a one element vector so getting such a subscript
-	// does not affect other data types.
-	//
-	string scriptToFindRClass = "class(" +  m_name + "[1," + to_string(columnNumberInR) + "])[1]";
-
-	// Evaluate the script and store the result in a string
-	//
-	Rcpp::CharacterVector classInR(ExecuteScriptAndGetResult(scriptToFindRClass));
+	if (RTypeUtils::IsRawList(column))
+	{
+		// A list of raw vectors, classed AsIs when it comes from a binary input column,
+		// is output as a binary column.
+		//
+		classInR = "raw";
+	}
+	else if (TYPEOF(classAttribute) == STRSXP && Rf_length(classAttribute) > 0)
+	{
+		classInR = CHAR(STRING_ELT(classAttribute, 0));
+	}
+	else if (Rf_getAttrib(column, R_DimSymbol) != R_NilValue)
+	{
+		// Matrix columns are not supported.
+		//
+		classInR = "matrix";
+	}
+	else
+	{
+		switch (TYPEOF(column))
+		{
+		case LGLSXP:
+			classInR = "logical";
+			break;
+		case INTSXP:
+			classInR = "integer";
+			break;
+		case REALSXP:
+			classInR = "numeric";
+			break;
+		case STRSXP:
+			classInR = "character";
+			break;
+		case RAWSXP:
+			classInR = "raw";
+			break;
+		default:
+			classInR = Rf_type2char(TYPEOF(column));
+			break;
+		}
+	}
 
 	// Look up the map with the key classInR.
 	//
 	RTypeUtils::RToOdbcTypeMap::const_iterator it =
-		RTypeUtils::sm_classInRToOdbcTypeMap.find(string(classInR[0]));
+		RTypeUtils::sm_classInRToOdbcTypeMap.find(classInR);
 
 	if (it == RTypeUtils::sm_classInRToOdbcTypeMap.end())
 	{
@@ -825,26 +1103,37 @@ SQLSMALLINT ROutputDataSet::GetColumnDataType(SQLUSMALLINT columnNumber)
 //
 // Description:
 //  Set the number of rows from the underlying DataFrame.
-//  If there is a binary raw column, number of rows is always set to 1 even if
+//  If there is a binary column that is a raw vector, number of rows is always set to 1 even if
 //  the underlying DataFrame has more or less rows since all the bytes are returned
-//  in a single row.
+//  in a single row. Binary columns that are lists of raw vectors have one row per list item,
+//  so they do not change the number of rows.
 //
 void ROutputDataSet::PopulateRowsNumber()
 {
 	LOG("ROutputDataSet::PopulateRowsNumber");
 
-	vector<SQLSMALLINT>::const_iterator it =
-		find(m_columnsDataType.begin(),m_columnsDataType.end(), SQL_C_BINARY);
+	bool hasRawVectorColumn = false;
+
+	for (SQLUSMALLINT columnNumber = 0; columnNumber < m_columnsDataType.size(); ++columnNumber)
+	{
+		if (m_columnsDataType[columnNumber] == SQL_C_BINARY &&
+			TYPEOF(VECTOR_ELT(static_cast<SEXP>(m_dataFrame), columnNumber)) == RAWSXP)
+		{
+			hasRawVectorColumn = true;
+			break;
+		}
+	}
 
-	if (it == m_columnsDataType.end())
+	if (!hasRawVectorColumn)
 	{
-		// No binary column found; set the DataFrame rows as the number of rows for ROutputDataSet.
+		// No raw vector column found; set the DataFrame rows as the number of rows
+		// for ROutputDataSet.
 		//
 		m_rowsNumber = GetDataFrameRowsNumber();
 	}
 	else
 	{
-		// Raw binary column found; set number of rows of ROutputDatSet = 1
+		// Raw vector column found; set number of rows of ROutputDatSet = 1
 		// even if DataFrame has no row or more than one row.
 		//
 		m_rowsNumber = 1;
@@ -26,7 +26,9 @@
 //**************************************************************************************************
 
 #include "Common.h"
+#include <R_ext/Parse.h>
 
+#include "RBufferVector.h"
 #include "RLibrarySession.h"
 
 using namespace std;
@@ -35,7 +37,7 @@ unique_ptr<RInside> REnvironment::sm_embeddedREnvPtr = nullptr;
 unique_ptr<Rcpp::CharacterVector> REnvironment::sm_originalPath = nullptr;
 
 //--------------------------------------------------------------------------------------------------
-// Name: GetScriptWithTryCatch
+// Name: REnvironment::GetScriptWithTryCatch
 //
 // Description:
 //  Encloses the given script in a try catch block.
@@ -43,7 +45,7 @@ unique_ptr<Rcpp::CharacterVector> REnvironment::sm_originalPath = nullptr;
 // Returns:
 //  Modified script enclosed in try catch
 //
-string GetScriptWithTryCatch(const string &script)
+string REnvironment::GetScriptWithTryCatch(const string &script)
 {
 	stringstream tryCatchScript;
 	tryCatchScript << "tryCatch("
@@ -82,7 +84,7 @@ void ExecuteScript(const string &script)
 	LOG("ExecuteScript");
 
 	RInside* embeddedREnvPtr = REnvironment::EmbeddedREnvironment();
-	string tryCatchScript = GetScriptWithTryCatch(script);
+	string tryCatchScript = REnvironment::GetScriptWithTryCatch(script);
 	LOG(tryCatchScript);
 
 	// If evaluation of script fails, this throws an exception.
@@ -107,7 +109,7 @@ SEXP ExecuteScriptAndGetResult(const string &script)
 	SEXP result = nullptr;
 	RInside* embeddedREnvPtr = REnvironment::EmbeddedREnvironment();
 
-	string tryCatchScript = GetScriptWithTryCatch(script);
+	string tryCatchScript = REnvironment::GetScriptWithTryCatch(script);
 	LOG(tryCatchScript);
 	result = static_cast<SEXP>(embeddedREnvPtr->parseEval(tryCatchScript));
 
@@ -164,6 +166,10 @@ void REnvironment::Init(SQLULEN extensionParamsLength)
 		throw runtime_error("Embedded R is not initialized.");
 	}
 
+	// Register the ALTREP classes exposing input column buffers to R without a copy.
+	//
+	RBufferVector::Init();
+
 	string privateLibPath = Utilities::NormalizePathString(RPathSettings::PrivateLibraryPath());
 	string publicLibPath = Utilities::NormalizePathString(RPathSettings::PublicLibraryPath());
 
@@ -187,6 +193,62 @@ void REnvironment::Init(SQLULEN extensionParamsLength)
 	ExecuteScript(prependToLibPathsScript);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: REnvironment::ParseScript
+//
+// Description:
+//  Parses the given script enclosed in a try catch block, the same way ExecuteScript does,
+//  so that it can be evaluated repeatedly with EvaluateParsedScript without being parsed again.
+//
+// Returns:
+//  The parsed expression vector, unprotected, or R_NilValue if the script could not be parsed,
+//  in which case ExecuteScript reports the parse error when the script is executed.
+//
+SEXP REnvironment::ParseScript(const string &script)
+{
+	LOG("REnvironment::ParseScript");
+
+	string tryCatchScript = GetScriptWithTryCatch(script);
+	LOG(tryCatchScript);
+
+	ParseStatus status = PARSE_NULL;
+	Rcpp::Shield<SEXP> scriptInR(Rf_mkString(tryCatchScript.c_str()));
+	Rcpp::Shield<SEXP> parsedScript(R_ParseVector(scriptInR, -1, &status, R_NilValue));
+
+	if (status != PARSE_OK)
+	{
+		return R_NilValue;
+	}
+
+	return parsedScript;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: REnvironment::EvaluateParsedScript
+//
+// Description:
+//  Evaluates each expression of the given parsedScript, returned by ParseScript for the given
+//  script, in the global R environment.
+//
+// Remarks:
+//  This throws the same exception as ExecuteScript if the evaluation fails.
+//
+void REnvironment::EvaluateParsedScript(SEXP parsedScript, const string &script)
+{
+	LOG("REnvironment::EvaluateParsedScript");
+
+	for (R_xlen_t index = 0; index < Rf_xlength(parsedScript); ++index)
+	{
+		int errorOccurred = 0;
+		R_tryEval(VECTOR_ELT(parsedScript, index), R_GlobalEnv, &errorOccurred);
+
+		if (errorOccurred)
+		{
+			throw runtime_error("Error evaluating: " + GetScriptWithTryCatch(script));
+		}
+	}
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: REnvironment::Cleanup
 //
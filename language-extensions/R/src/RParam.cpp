@@ -452,20 +452,22 @@ void RDateTimeParam<SQLType, RVectorType, DateTimeTypeInR>::SetRcppVector(SQLPOI
 	if (strLenOrInd == SQL_NULL_DATA)
 	{
 		SQLINTEGER strLen_or_Ind[1] = { SQL_NULL_DATA };
-		m_RcppVector = RTypeUtils::CreateDateTimeVector<SQLType, RVectorType, DateTimeTypeInR>(
-			1, // rowsNumber
-			paramValue,
-			strLen_or_Ind,
-			SQL_NULLABLE);
+		m_RcppVector = RVectorType(static_cast<SEXP>(
+			RTypeUtils::CreateDateTimeVector<SQLType, DateTimeTypeInR>(
+				1, // rowsNumber
+				paramValue,
+				strLen_or_Ind,
+				SQL_NULLABLE)));
 	}
 	else
 	{
 		SQLINTEGER strLen_or_IndArray[1] = { strLenOrInd };
-		m_RcppVector = RTypeUtils::CreateDateTimeVector<SQLType, RVectorType, DateTimeTypeInR>(
-			1, // rowsNumber
-			paramValue,
-			strLen_or_IndArray,
-			SQL_NO_NULLS);
+		m_RcppVector = RVectorType(static_cast<SEXP>(
+			RTypeUtils::CreateDateTimeVector<SQLType, DateTimeTypeInR>(
+				1, // rowsNumber
+				paramValue,
+				strLen_or_IndArray,
+				SQL_NO_NULLS)));
 	}
 }
 
@@ -487,19 +489,20 @@ void RDateTimeParam<SQLType, RVectorType, DateTimeTypeInR>::RetrieveValueAndStrL
 		Logger::LogRVariable(m_name);
 		RInside* embeddedREnvPtr = REnvironment::EmbeddedREnvironment();
 
-		m_RcppVector = (*embeddedREnvPtr)[m_name.c_str()];
+		Rcpp::NumericVector valueInR = (*embeddedREnvPtr)[m_name.c_str()];
+		m_RcppVector = RVectorType(static_cast<SEXP>(valueInR));
 
-		if (m_RcppVector.size() > 0)
+		if (valueInR.size() > 0)
 		{
 			SQLSMALLINT nullable = SQL_NO_NULLS;
 
-			// m_RcppVector could possibly have size > 1,
+			// valueInR could possibly have size > 1,
 			// but fill only the first value as the parameter value.
 			// hence pass in rowsNumber = 1.
 			//
-			RTypeUtils::FillDataFromDateTimeVector<SQLType, RVectorType, DateTimeTypeInR>(
+			RTypeUtils::FillDataFromDateTimeVector<SQLType, DateTimeTypeInR>(
 				1,  // rowsNumber
-				m_RcppVector,
+				valueInR,
 				&m_value,
 				&m_strLenOrInd,
 				nullable);
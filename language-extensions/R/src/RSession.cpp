@@ -80,6 +80,11 @@ void RSession::Init(
 	//
 	m_script.erase(remove(m_script.begin(), m_script.end(), 0x0D), m_script.end());
 
+	// Parse the script once, it is evaluated for every Execute call of the session,
+	// i.e. for every stream batch and partition.
+	//
+	m_parsedScript = REnvironment::ParseScript(m_script);
+
 	// Initialize the InputDataSet
 	//
 	m_inputDataSet.Init(inputDataName, inputDataNameLength, inputSchemaColumnsNumber);
@@ -175,6 +180,22 @@ void RSession::InitParam(
 		m_outputDataSet.IsStreaming(true);
 	}
 
+	// If the input param "r_useInteger64" is set to a non-zero value, add BIGINT and
+	// DECIMAL(p <= 18, 0) input columns as bit64::integer64.
+	//
+	if (strcmp(reinterpret_cast<const char *>(paramName), m_integer64ParamName.c_str()) == 0)
+	{
+		m_inputDataSet.UseInteger64(IsFlagSet(dataType, paramValue, strLen_or_Ind));
+	}
+
+	// If the input param "r_dedupeStrings" is set to a non-zero value, repeated values of
+	// character input columns share their R string.
+	//
+	if (strcmp(reinterpret_cast<const char *>(paramName), m_dedupeStringsParamName.c_str()) == 0)
+	{
+		m_inputDataSet.DedupeStrings(IsFlagSet(dataType, paramValue, strLen_or_Ind));
+	}
+
 	// Add parameter to the container and embedded R environment.
 	//
 	m_paramContainer.AddParamToEmbeddedR(
@@ -189,6 +210,33 @@ void RSession::InitParam(
 		inputOutputType);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RSession::IsFlagSet
+//
+// Description:
+//  Returns whether the value of a reserved BIT or INT flag parameter is set and non-zero.
+//  Values of other types are considered set if they are not null.
+//
+bool RSession::IsFlagSet(
+	SQLSMALLINT dataType,
+	SQLPOINTER  paramValue,
+	SQLINTEGER  strLen_or_Ind)
+{
+	bool isSet = paramValue != nullptr && strLen_or_Ind != SQL_NULL_DATA;
+
+	if (isSet && dataType == SQL_C_BIT)
+	{
+		SQLCHAR value = *static_cast<SQLCHAR *>(paramValue);
+		isSet = value != '0' && value != 0;
+	}
+	else if (isSet && dataType == SQL_C_SLONG)
+	{
+		isSet = *static_cast<SQLINTEGER *>(paramValue) != 0;
+	}
+
+	return isSet;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RSession::ExecuteWorkflow
 //
@@ -203,40 +251,61 @@ void RSession::ExecuteWorkflow(
 {
 	LOG("RSession::ExecuteWorkflow");
 
-	// Add columns to the input DataFrame.
-	//
-	m_inputDataSet.AddColumnsToDataFrame(rowsNumber, data, strLen_or_Ind);
-
-	// Add the DataFrame for InputDataSet to the R environment.
-	//
-	m_inputDataSet.AddDataFrameToEmbeddedR();
-
-	// Execute the script, any standard output or error is flushed to the console.
+	// Input columns may read directly from the ExtHost buffers, which are only valid during
+	// Execute, so they are detached once the script and the output no longer need them.
 	//
-	ExecuteScript(m_script);
-
-	// In case of streaming clean up the previous stream batch's output buffers
-	//
-	if (m_isStreaming)
+	try
 	{
-		m_outputDataSet.CleanupColumns();
+		// Add columns to the input DataFrame.
+		//
+		m_inputDataSet.AddColumnsToDataFrame(rowsNumber, data, strLen_or_Ind);
+
+		// Add the DataFrame for InputDataSet to the R environment.
+		//
+		m_inputDataSet.AddDataFrameToEmbeddedR();
+
+		// Execute the script, any standard output or error is flushed to the console.
+		// A script that could not be parsed is executed from its text, to report the error.
+		//
+		if (m_parsedScript != R_NilValue)
+		{
+			REnvironment::EvaluateParsedScript(m_parsedScript, m_script);
+		}
+		else
+		{
+			ExecuteScript(m_script);
+		}
+
+		// In case of streaming clean up the previous stream batch's output buffers
+		//
+		if (m_isStreaming)
+		{
+			m_outputDataSet.CleanupColumns();
+		}
+
+		// After script evaluation, retrieve the DataFrame for OutputDataSet.
+		//
+		m_outputDataSet.RetrieveDataFrameFromEmbeddedR();
+
+		// Get the column number from the underlying DataFrame
+		// and set it to be the outputSchemaColumnsNumber.
+		//
+		*outputSchemaColumnsNumber = m_outputDataSet.GetDataFrameColumnsNumber();
+
+		if (*outputSchemaColumnsNumber > 0)
+		{
+			m_outputDataSet.GetColumnsDataType();
+			m_outputDataSet.PopulateRowsNumber();
+			m_outputDataSet.GetColumnsFromDataFrame();
+		}
 	}
-
-	// After script evaluation, retrieve the DataFrame for OutputDataSet.
-	//
-	m_outputDataSet.RetrieveDataFrameFromEmbeddedR();
-
-	// Get the column number from the underlying DataFrame
-	// and set it to be the outputSchemaColumnsNumber.
-	//
-	*outputSchemaColumnsNumber = m_outputDataSet.GetDataFrameColumnsNumber();
-
-	if (*outputSchemaColumnsNumber > 0)
+	catch (...)
 	{
-		m_outputDataSet.GetColumnsDataType();
-		m_outputDataSet.PopulateRowsNumber();
-		m_outputDataSet.GetColumnsFromDataFrame();
+		m_inputDataSet.DetachBufferVectors();
+		throw;
 	}
+
+	m_inputDataSet.DetachBufferVectors();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -350,4 +419,6 @@ void RSession::Cleanup()
 	m_inputDataSet.Cleanup();
 	m_outputDataSet.CleanupColumns();
 	m_outputDataSet.Cleanup();
+
+	m_parsedScript = R_NilValue;
 }
@@ -26,9 +26,13 @@
 //**************************************************************************************************
 
 #include "Common.h"
+#include <algorithm>
 #include <climits>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
 #include "RTypeUtils.h"
 #include "Unicode.h"
@@ -38,6 +42,12 @@ using namespace std;
 //--------------------------------------------------------------------------------------------------
 static constexpr SQLUSMALLINT x_MaxScale = 38;
 static constexpr SQLUSMALLINT x_HexaDecimalBase = 16;
+static constexpr double x_SecondsPerDay = 86400.0;
+static constexpr long long x_MicroSecondsPerSecond = 1000000;
+static constexpr int64_t x_NaInteger64 = LLONG_MIN;
+static constexpr size_t x_DedupeCacheSize = 1024;
+static constexpr size_t x_MaxDedupeLength = 64;
+static constexpr size_t x_EncodingCacheSize = 256;
 const double x_PowersOf10[x_MaxScale + 1] =
 	{ 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
 	  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24,
@@ -67,6 +77,7 @@ const unordered_map<string, SQLSMALLINT> RTypeUtils::sm_classInRToOdbcTypeMap =
 	{"logical", SQL_C_BIT},
 	{"integer", SQL_C_SLONG},
 	{"numeric", SQL_C_DOUBLE},
+	{"integer64", SQL_C_SBIGINT},
 	{"character", SQL_C_CHAR},
 	{"raw", SQL_C_BINARY},
 	{"Date", SQL_C_TYPE_DATE},
@@ -80,10 +91,12 @@ const unordered_map<string, SQLSMALLINT> RTypeUtils::sm_classInRToOdbcTypeMap =
 //  Templatized function to create an Rcpp vector encapsulating SEXP pointers to the equivalent R
 //  objects for the given SQL type with given data. This is only for numeric,
 //  integer or logical R types. rowsNumber indicates the number of elements to be added in the vector.
-//  Iterates over data to set the value at each index of the vector.
+//  When SQLType has the same representation as the R element type, data is copied in bulk,
+//  otherwise each value is converted (widened) in a plain loop the compiler can vectorize.
 //  strLen_or_Ind if non-null is an array, where each cell represents the size of the SQL data type
 //  and null values are indicated by SQL_NULL_DATA.
-//  If at any index strLen_or_Ind is SQL_NULL_DATA, we fill the equivalent R NA value in Rcpp vector.
+//  If at any index strLen_or_Ind is SQL_NULL_DATA, we fill the equivalent R NA value in Rcpp vector,
+//  overwriting the copied value in a second pass.
 //  If strLen_or_Ind is nullptr, there are no null values in the data.
 //  If nullable is SQL_NO_NULLS, we ignore strLen_or_Ind.
 //
@@ -96,35 +109,49 @@ RVectorType RTypeUtils::CreateVector(
 {
 	LOG("RTypeUtils::CreateVector");
 
+	using ElementType = typename RVectorType::stored_type;
+
 	// Note: Always preallocate the Rcpp vector with the size instead of using
 	// push_back since Rcpp push_back involves copying to create a new vector in R environment.
+	// Every element is written below, so there is no need to zero it first.
 	//
-	RVectorType vectorInR(rowsNumber);
-	bool isNullable = nullable == SQL_NULLABLE;
+	RVectorType vectorInR(Rcpp::no_init(rowsNumber));
 
-	for (SQLULEN index = 0; index < rowsNumber; ++index)
+	if (rowsNumber == 0 || data == nullptr)
 	{
-		if (isNullable &&
-			strLen_or_Ind != nullptr &&
-			strLen_or_Ind[index] == SQL_NULL_DATA)
+		return vectorInR;
+	}
+
+	ElementType *elementsInR = vectorInR.begin();
+	const SQLType *values = static_cast<const SQLType *>(data);
+
+	if constexpr (DataType == SQL_C_BIT)
+	{
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
 		{
-			// It is NULL (NA) only in this case.
-			//
-			NAType valueForNA = *(static_cast<NAType*>(sm_dataTypeToNAMap.at(DataType)));
-			vectorInR[index] = valueForNA;
+			elementsInR[index] = values[index] != '0' && values[index] != 0;
 		}
-		else
+	}
+	else if constexpr (HasSameRepresentation<SQLType, RVectorType, DataType>())
+	{
+		memcpy(elementsInR, values, rowsNumber * sizeof(SQLType));
+	}
+	else
+	{
+		copy(values, values + rowsNumber, elementsInR);
+	}
+
+	if (nullable == SQL_NULLABLE && strLen_or_Ind != nullptr)
+	{
+		// It is NULL (NA) only in this case.
+		//
+		NAType valueForNA = *(static_cast<NAType*>(sm_dataTypeToNAMap.at(DataType)));
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
 		{
-			// In all other scenarios, it is not NULL (NA).
-			//
-			SQLType value = static_cast<SQLType *>(data)[index];
-			if constexpr (DataType != SQL_C_BIT)
-			{
-				vectorInR[index] = value;
-			}
-			else
+			if (strLen_or_Ind[index] == SQL_NULL_DATA)
 			{
-				vectorInR[index] = value != '0' && value != 0;
+				elementsInR[index] = valueForNA;
 			}
 		}
 	}
@@ -136,84 +163,209 @@ RVectorType RTypeUtils::CreateVector(
 // Name: RTypeUtils::CreateCharacterVector
 //
 // Description:
-//  Creates a character Rcpp vector encapsulating SEXP pointers to the equivalent R character
-//  objects with the given data. If the given data is wide character utf16, convert it to utf8
-//  first before creating the Rcpp vector since R only accepts utf-8 encoding.
+//  Creates a character Rcpp vector holding the equivalent R character objects (CHARSXP)
+//  of the given data. If the given data is wide character utf16, convert it to utf8
+//  first since R only accepts utf-8 encoding.
 //  rowsNumber indicates the number of elements to be added in the vector.
-//  Iterates over data to set the value at each index of the vector.
 //  strLen_or_Ind if non-null is an array, where each cell represents the number of bytes occupied
 //  by the corresponding string in the given data and null strings are indicated by SQL_NULL_DATA.
 //  If at any index strLen_or_Ind is SQL_NULL_DATA, we fill in the NA_STRING value in Rcpp vector.
 //  If strLen_or_Ind is nullptr, all the values in the data are null.
+//  The whole column buffer is checked for ASCII once: an ASCII column needs no per-string
+//  validation, and an ASCII utf16 column is narrowed instead of transcoded.
+//  Each CHARSXP is created directly from the buffer or a single reused utf8 buffer.
+//  If dedupe is true, repeated values reuse the CHARSXP of a previous row found through
+//  a small cache instead of looking it up in the global CHARSXP cache of R.
 //
 template<class CharType>
 Rcpp::CharacterVector RTypeUtils::CreateCharacterVector(
 	SQLULEN    rowsNumber,
 	SQLPOINTER data,
-	SQLINTEGER *strLen_or_Ind)
+	SQLINTEGER *strLen_or_Ind,
+	bool       dedupe)
 {
 	LOG("RTypeUtils::CreateCharacterVector");
 
-	CharType *baseCharData = static_cast<CharType *>(data);
-	SQLULEN cumulativeLength = 0;
+	const CharType *baseCharData = static_cast<const CharType *>(data);
+	SQLULEN totalLength = 0;
+
+	if (strLen_or_Ind != nullptr)
+	{
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			if (strLen_or_Ind[index] != SQL_NULL_DATA)
+			{
+				totalLength += strLen_or_Ind[index] / sizeof(CharType);
+			}
+		}
+	}
+
+	bool isAscii = IsAscii(baseCharData, totalLength);
 
 	// Note: Always preallocate the Rcpp vector with the size instead of using
 	// push_back since Rcpp push_back involves copying to create a new vector in R environment.
 	//
 	Rcpp::CharacterVector charVector(rowsNumber);
+	SEXP charVectorInR = charVector;
+
+	vector<SEXP> dedupeCache(dedupe ? x_DedupeCacheSize : 0, nullptr);
+	string utf8Value;
+	SQLULEN cumulativeLength = 0;
 
 	for (SQLULEN index = 0; index < rowsNumber; ++index)
 	{
 		if (strLen_or_Ind == nullptr || strLen_or_Ind[index] == SQL_NULL_DATA)
 		{
-			charVector[index] = NA_STRING;
+			SET_STRING_ELT(charVectorInR, index, NA_STRING);
+			continue;
 		}
-		else
-		{
-			CharType *str = baseCharData + cumulativeLength;
-			SQLINTEGER strlen = strLen_or_Ind[index] / sizeof(CharType);
-			string value;
 
-			// If there are bad characters w.r.t CharType
-			// throws an error
-			//
-			if constexpr (is_same_v<CharType, char16_t>)
+		const CharType *str = baseCharData + cumulativeLength;
+		SQLINTEGER strlen = strLen_or_Ind[index] / sizeof(CharType);
+		const char *utf8Str = nullptr;
+		size_t utf8Length = 0;
+
+		cumulativeLength += strlen;
+
+		// If there are bad characters w.r.t CharType
+		// throws an error
+		//
+		if constexpr (is_same_v<CharType, char16_t>)
+		{
+			if (isAscii)
 			{
-				estd::ToUtf8(str, strlen, value, true /*throwOnError*/);
+				utf8Value.resize(strlen);
+				copy(str, str + strlen, utf8Value.begin());
 			}
 			else
-			{	
-				// Check if string is a valid UTF8
-				//
-				bool isValidUTF8 = estd::IsValidUTF8(const_cast<char*>(str), strlen);
-
-				if(!isValidUTF8)
-				{
-					throw std::invalid_argument("There is a bad UTF-8 character");
-				}
+			{
+				estd::ToUtf8(str, strlen, utf8Value, true /*throwOnError*/);
+			}
 
-				value = string(str, strlen);
+			utf8Str = utf8Value.data();
+			utf8Length = utf8Value.size();
+		}
+		else
+		{
+			// Check if string is a valid UTF8
+			//
+			if (!isAscii && !estd::IsValidUTF8(str, strlen))
+			{
+				throw std::invalid_argument("There is a bad UTF-8 character");
 			}
 
-			charVector[index] = value.c_str();
-			cumulativeLength += strlen;
+			utf8Str = str;
+			utf8Length = strlen;
 		}
+
+		// R strings cannot hold embedded nulls, the value ends at the first one as it does
+		// for a C string.
+		//
+		const void *firstNull = memchr(utf8Str, '\0', utf8Length);
+		if (firstNull != nullptr)
+		{
+			utf8Length = static_cast<const char *>(firstNull) - utf8Str;
+		}
+
+		SET_STRING_ELT(charVectorInR, index, MakeCharacter(utf8Str, utf8Length, dedupeCache));
 	}
 
 	return charVector;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::IsAscii
+//
+// Description:
+//  Templatized function returning whether the given length characters are all ASCII.
+//  The characters are checked a 64-bit word at a time, which the compiler can vectorize further.
+//
+template<class CharType>
+bool RTypeUtils::IsAscii(
+	const CharType *str,
+	SQLULEN        length)
+{
+	// The bits that are set in a word only if one of its characters is not ASCII.
+	//
+	constexpr uint64_t nonAsciiMask = is_same_v<CharType, char16_t> ?
+		0xFF80FF80FF80FF80ULL : 0x8080808080808080ULL;
+	constexpr SQLULEN charsPerWord = sizeof(uint64_t) / sizeof(CharType);
+
+	uint64_t nonAsciiBits = 0;
+	SQLULEN index = 0;
+
+	for (; index + charsPerWord <= length; index += charsPerWord)
+	{
+		uint64_t word;
+		memcpy(&word, str + index, sizeof(uint64_t));
+		nonAsciiBits |= word;
+	}
+
+	for (; index < length; ++index)
+	{
+		nonAsciiBits |= static_cast<make_unsigned_t<CharType>>(str[index]) >= 0x80 ? nonAsciiMask : 0;
+	}
+
+	return (nonAsciiBits & nonAsciiMask) == 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::MakeCharacter
+//
+// Description:
+//  Returns the CHARSXP of the given utf8 string with the given length in bytes.
+//  If dedupeCache is not empty, strings of up to x_MaxDedupeLength bytes are looked up in it
+//  by hash first, and a new CHARSXP is stored in it. The cached CHARSXPs must be kept alive by
+//  the caller, e.g. by being elements of the vector under construction.
+//
+SEXP RTypeUtils::MakeCharacter(
+	const char   *str,
+	size_t       length,
+	vector<SEXP> &dedupeCache)
+{
+	SEXP *cachedChar = nullptr;
+
+	if (!dedupeCache.empty() && length <= x_MaxDedupeLength)
+	{
+		// FNV-1a hash of the string.
+		//
+		uint64_t hash = 14695981039346656037ULL;
+		for (size_t index = 0; index < length; ++index)
+		{
+			hash = (hash ^ static_cast<unsigned char>(str[index])) * 1099511628211ULL;
+		}
+
+		cachedChar = &dedupeCache[hash % dedupeCache.size()];
+
+		if (*cachedChar != nullptr &&
+			static_cast<size_t>(LENGTH(*cachedChar)) == length &&
+			memcmp(CHAR(*cachedChar), str, length) == 0)
+		{
+			return *cachedChar;
+		}
+	}
+
+	SEXP charInR = Rf_mkCharLenCE(str, static_cast<int>(length), CE_UTF8);
+
+	if (cachedChar != nullptr)
+	{
+		*cachedChar = charInR;
+	}
+
+	return charInR;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::CreateRawVector
 //
 // Description:
-//  Creates a raw Rcpp vector in R encapsulating SEXP pointers to the equivalent R raw objects
-//  with the given data. rowsNumber indicates the number of elements to be added in the data.
+//  Creates a raw Rcpp vector in R holding the concatenated bytes of the given binary data.
+//  rowsNumber indicates the number of elements in the data.
 //  Each cell in a non-null strLen_or_Ind array indicates the length of each element.
 //  If strLen_or_Ind is nullptr, returns an empty RawVector,
-//  Otherwise, iterates over data and for each element, if strLen_or_Ind at any index is not 
-//  SQL_NULL_DATA, go over each of its byte to push_back the value to the vector.
-//  If strLen_or_Ind at any index is SQL_NULL_DATA, does not push_back anything.
+//  Otherwise, the total length of the non-null elements is computed first so that the vector
+//  is allocated once, then each element is copied into it with a single memcpy.
+//  Elements for which strLen_or_Ind is SQL_NULL_DATA add no bytes.
 //
 Rcpp::RawVector RTypeUtils::CreateRawVector(
 	SQLULEN    rowsNumber,
@@ -222,48 +374,96 @@ Rcpp::RawVector RTypeUtils::CreateRawVector(
 {
 	LOG("RTypeUtils::CreateRawVector");
 
-	Rcpp::RawVector rawVector = Rcpp::RawVector::create();
-	SQLCHAR* baseRawData = static_cast<SQLCHAR *>(data);
-	int cumulativeRawDataLength = 0;
-	
+	SQLULEN totalLength = 0;
+
 	if (strLen_or_Ind != nullptr)
 	{
 		for (SQLULEN index = 0; index < rowsNumber; ++index)
 		{
 			if (strLen_or_Ind[index] != SQL_NULL_DATA)
 			{
-				SQLCHAR *rawData = static_cast<SQLCHAR *>(baseRawData) + cumulativeRawDataLength;
-				for(int rawByteIndex = 0; rawByteIndex < strLen_or_Ind[index]; ++rawByteIndex)
-				{
-					SQLCHAR value = *(rawData + rawByteIndex);
-					rawVector.push_back(value);
-				}
-
-				cumulativeRawDataLength += strLen_or_Ind[index];
+				totalLength += strLen_or_Ind[index];
 			}
 		}
 	}
 
+	// Note: Never push_back into an Rcpp vector, every push_back allocates a new vector
+	// in the R environment and copies all the existing bytes into it.
+	//
+	Rcpp::RawVector rawVector(Rcpp::no_init(totalLength));
+
+	if (totalLength > 0)
+	{
+		memcpy(rawVector.begin(), data, totalLength);
+	}
+
 	return rawVector;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::CreateRawListVector
+//
+// Description:
+//  Creates a list in R with one raw vector per element of the given binary data, keeping the
+//  boundaries between the elements. rowsNumber indicates the number of elements in the data.
+//  Each cell in a non-null strLen_or_Ind array indicates the length of each element.
+//  If strLen_or_Ind at any index is SQL_NULL_DATA, or strLen_or_Ind is nullptr,
+//  the list item is NULL.
+//  The list is classed AsIs so that it is added as a single column to a DataFrame.
+//
+Rcpp::List RTypeUtils::CreateRawListVector(
+	SQLULEN    rowsNumber,
+	SQLPOINTER data,
+	SQLINTEGER *strLen_or_Ind)
+{
+	LOG("RTypeUtils::CreateRawListVector");
+
+	const SQLCHAR *baseRawData = static_cast<const SQLCHAR *>(data);
+	SQLULEN cumulativeLength = 0;
+
+	Rcpp::List rawList(rowsNumber);
+
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
+	{
+		if (strLen_or_Ind != nullptr && strLen_or_Ind[index] != SQL_NULL_DATA)
+		{
+			SQLINTEGER length = strLen_or_Ind[index];
+			Rcpp::RawVector rawVector(Rcpp::no_init(length));
+
+			if (length > 0)
+			{
+				memcpy(rawVector.begin(), baseRawData + cumulativeLength, length);
+			}
+
+			rawList[index] = rawVector;
+			cumulativeLength += length;
+		}
+	}
+
+	rawList.attr("class") = "AsIs";
+
+	return rawList;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::CreateDateTimeVector
 //
 // Description:
-//  Templatized function to create an Rcpp vector encapsulating SEXP pointers to the equivalent R
-//  objects for the given data types with given data. This is only for date, datetime(2)
-//  SQL data types mapping to Rcpp::DateVector and DateTimeVector respectively.
+//  Templatized function to create a numeric Rcpp vector holding the equivalent R values
+//  for the given data types with given data. This is only for date, datetime(2)
+//  SQL data types mapping to the R classes Date and POSIXct respectively.
 //  rowsNumber indicates the number of elements to be added in the vector.
-//  Iterates over data to set the value at each index of the vector.
+//  Iterates over data to set the value at each index of the vector: Date values are the days
+//  and POSIXct values the seconds since 1970-01-01 in UTC, computed directly from the SQL struct.
+//  The class (and for POSIXct the "UTC" tzone) attribute is set once on the whole vector.
 //  strLen_or_Ind if non-null is an array, where each cell represents the size of the SQL data type
 //  and null values are indicated by SQL_NULL_DATA.
 //  If at any index strLen_or_Ind is SQL_NULL_DATA, we fill the equivalent R NA value in Rcpp vector.
 //  If strLen_or_Ind is nullptr, there are no null values in the data.
 //  If nullable is SQL_NO_NULLS, we ignore strLen_or_Ind.
 //
-template<class SQLType, class RVectorType, class DateTimeTypeInR>
-RVectorType RTypeUtils::CreateDateTimeVector(
+template<class SQLType, class DateTimeTypeInR>
+Rcpp::NumericVector RTypeUtils::CreateDateTimeVector(
 	SQLULEN     rowsNumber,
 	SQLPOINTER  data,
 	SQLINTEGER  *strLen_or_Ind,
@@ -271,81 +471,87 @@ RVectorType RTypeUtils::CreateDateTimeVector(
 {
 	LOG("RTypeUtils::CreateDateTimeVector");
 
-	// Note: Always preallocate the Rcpp vector with the size instead of using
-	// push_back since Rcpp push_back involves copying to create a new vector in R environment.
-	//
-	RVectorType vectorInR(rowsNumber);
-
-	// Get the time zone if any that R is set to and store it in a temporary variable.
+	// Every element is written below, so there is no need to zero the vector first.
 	//
-	string previousTimeZoneInR = "";
+	Rcpp::NumericVector vectorInR(Rcpp::no_init(rowsNumber));
+	double *valuesInR = vectorInR.begin();
+	SQLType *values = static_cast<SQLType *>(data);
+	bool isNullable = nullable == SQL_NULLABLE && strLen_or_Ind != nullptr;
 
-	try
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
 	{
-		previousTimeZoneInR = Utilities::GetTimeZoneInR();
-
-		// Interpret the value sent by Exthost in UTC irrespective of what time zone R had been set to.
-		//
-		Utilities::SetTimeZoneInR("UTC");
-		bool isNullable = nullable == SQL_NULLABLE;
-
-		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		if (isNullable && strLen_or_Ind[index] == SQL_NULL_DATA)
+		{
+			// It is NULL (NA) only in this case.
+			//
+			valuesInR[index] = R_NaReal;
+		}
+		else
 		{
-			if (isNullable &&
-				strLen_or_Ind != nullptr &&
-				strLen_or_Ind[index] == SQL_NULL_DATA)
+			// In all other scenarios, it is not NULL (NA).
+			// The value sent by Exthost is interpreted in UTC.
+			//
+			const SQLType &value = values[index];
+			double daysSinceEpoch = GetDaysSinceEpoch(value.year, value.month, value.day);
+
+			if constexpr (is_same_v<DateTimeTypeInR, Rcpp::Datetime>)
 			{
-				// It is NULL (NA) only in this case.
+				// "fraction" is stored in nanoseconds.
 				//
-				vectorInR[index] = DateTimeTypeInR(R_NaReal);
+				valuesInR[index] = daysSinceEpoch * x_SecondsPerDay +
+					value.hour * 3600.0 +
+					value.minute * 60.0 +
+					value.second +
+					value.fraction / 1e9;
 			}
 			else
 			{
-				// In all other scenarios, it is not NULL (NA).
-				//
-
-				SQLType value = static_cast<SQLType *>(data)[index];
-
-				// Rcpp::Date accepts date in "YYYY-mm-dd" and
-				// Rcpp::Datetime accepts datetime in "YYYY-mm-dd HH:MM:SS.MICROSEC"
-				// string formats so generate the date time string.
-				//
-				string dateTimeInStringFormat =
-					to_string(value.year) + "-" +
-					to_string(value.month) + "-" +
-					to_string(value.day);
-
-				if constexpr (is_same_v<DateTimeTypeInR, Rcpp::Datetime>)
-				{
-					// "fraction" is stored in nanoseconds, we need to know the digits after the decimal point.
-					//
-					string secondsAfterDecimalPoint
-						= Utilities::GetSecondsAfterDecimalPointFromNanoSeconds(value.fraction);
-
-					dateTimeInStringFormat =
-						dateTimeInStringFormat + " " +
-						to_string(value.hour) + ":" +
-						to_string(value.minute) + ":" +
-						to_string(value.second) + "." +
-						secondsAfterDecimalPoint;
-				}
-
-				vectorInR[index] = DateTimeTypeInR(dateTimeInStringFormat);
+				valuesInR[index] = daysSinceEpoch;
 			}
 		}
 	}
-	catch (...)
-	{
-		Utilities::SetTimeZoneInR(previousTimeZoneInR);
 
-		throw runtime_error("Unable to set UTC time zone and create date(time) vector");
+	if constexpr (is_same_v<DateTimeTypeInR, Rcpp::Datetime>)
+	{
+		vectorInR.attr("class") = Rcpp::CharacterVector::create("POSIXct", "POSIXt");
+		vectorInR.attr("tzone") = "UTC";
+	}
+	else
+	{
+		vectorInR.attr("class") = "Date";
 	}
-
-	Utilities::SetTimeZoneInR(previousTimeZoneInR);
 
 	return vectorInR;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::GetDaysSinceEpoch
+//
+// Description:
+//  Computes the number of days between 1970-01-01 and the given date of the proleptic
+//  Gregorian calendar, negative for earlier dates.
+//  Counts from March 1st so that the leap day is the last day of the year,
+//  then adds up the whole 400-year eras, years and days of the year.
+//
+// Returns:
+//  The number of days since 1970-01-01.
+//
+long long RTypeUtils::GetDaysSinceEpoch(
+	SQLSMALLINT  year,
+	SQLUSMALLINT month,
+	SQLUSMALLINT day)
+{
+	long long yearFromMarch = static_cast<long long>(year) - (month <= 2 ? 1 : 0);
+	long long era = (yearFromMarch >= 0 ? yearFromMarch : yearFromMarch - 399) / 400;
+	long long yearOfEra = yearFromMarch - era * 400;
+	long long dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+	// 719468 is the number of days from 0000-03-01 to 1970-01-01.
+	//
+	return era * 146097 + dayOfEra - 719468;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::CreateNumericVector
 //
@@ -395,7 +601,9 @@ Rcpp::NumericVector RTypeUtils::CreateNumericVector(
 			// The val array in the numeric struct contains the little endian byte representation
 			// of the (decimal number * 10 ^ decimalDigits).
 			// e.g. for type numeric(8, 3) i.e. 8 precision and 3 as the scale i.e. decimalDigits,
-			// a value of 3.4 will have the val array = 3.4 * 10 ^ 3 = 3400
+			// a value of 3.4 will have the val array = 3.4 * 10 ^ 3 = 3400.
+			// Both the scaled value up to 2^53 and the powers of 10 up to 10^22 are exact doubles,
+			// so for those the division is the only rounding.
 			//
 			double scaledValue = ConvertBytesToDouble(value.val);
 			double numeric = scaledValue / x_PowersOf10[decimalDigits];
@@ -417,39 +625,123 @@ Rcpp::NumericVector RTypeUtils::CreateNumericVector(
 // Description:
 //  Given a little endian byte array of max length SQL_MAX_NUMERIC_LEN,
 //  converts it into a double value of base 10.
-//  It views each byte as two hexadecimal digits. Starting with the lowest powerOf16 = 1,
-//  it incrementally multiplies the digits (both least significant and most significant)
-//  with the correct powerOf16, and cumulatively keeps adding the product to the result.
+//  It reads the array as an unsigned 128-bit integer held in two 64-bit halves.
+//  If the upper half is zero, the lower half is converted directly.
+//  Otherwise the value is shifted right until it fits in 64 bits, with the shifted out bits
+//  folded into the lowest bit so that the single conversion of those 64 bits
+//  rounds exactly like the whole 128-bit value would.
 //
 // Returns:
-//  A double value of base 10 equivalent to the given little endian byte array.
-//
-// Remarks:
-//  We do not convert the given byte array into a long integer
-//  since the range occupied by long is limited whereas a double value can accommodate the max
-//  value of represented by the array.
+//  The double value nearest to the given little endian byte array.
 //
 double RTypeUtils::ConvertBytesToDouble(const SQLCHAR *leBytesArray)
 {
-	double result = 0.0;
-	double powerOf16 = 1.0;
-	int currentByteValue = 0;
-	int lsd = 0, msd = 0;
+	const int halfLength = SQL_MAX_NUMERIC_LEN / 2;
+	uint64_t low = 0;
+	uint64_t high = 0;
+
+	for (int byte = halfLength - 1; byte >= 0; --byte)
+	{
+		low = (low << 8) | leBytesArray[byte];
+		high = (high << 8) | leBytesArray[byte + halfLength];
+	}
 
-	for(int byte = 0; byte < SQL_MAX_NUMERIC_LEN; ++byte)
+	if (high == 0)
 	{
-		currentByteValue = static_cast<int>(leBytesArray[byte]);
-		lsd = currentByteValue % x_HexaDecimalBase; // Obtain LSD
-		msd = currentByteValue / x_HexaDecimalBase; // Obtain MSD
+		return static_cast<double>(low);
+	}
+
+	// The shift is the number of significant bits in the upper half.
+	//
+	int shift = 0;
+	while (shift < 64 && (high >> shift) != 0)
+	{
+		++shift;
+	}
+
+	uint64_t mostSignificantBits = 0;
+	bool hasShiftedOutBits = false;
+
+	if (shift == 64)
+	{
+		mostSignificantBits = high;
+		hasShiftedOutBits = low != 0;
+	}
+	else
+	{
+		mostSignificantBits = (high << (64 - shift)) | (low >> shift);
+		hasShiftedOutBits = (low & ((uint64_t(1) << shift) - 1)) != 0;
+	}
+
+	if (hasShiftedOutBits)
+	{
+		mostSignificantBits |= 1;
+	}
+
+	return ldexp(static_cast<double>(mostSignificantBits), shift);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::CreateInteger64Vector
+//
+// Description:
+//  Templatized function to create a bit64::integer64 vector in R for BIGINT (SQLBIGINT)
+//  or DECIMAL(p <= 18, 0) (SQL_NUMERIC_STRUCT) data.
+//  integer64 stores each 64-bit integer as the raw bits of a double in a numeric vector
+//  with the "integer64" class, so BIGINT data is copied into it as a whole
+//  and numeric structs are converted into 64-bit integers.
+//  Null values are set to NA_integer64, the min value of a 64-bit integer.
+//  If strLen_or_Ind is nullptr or nullable is SQL_NO_NULLS, there are no null values in the data.
+//
+template<class SQLType>
+Rcpp::NumericVector RTypeUtils::CreateInteger64Vector(
+	SQLULEN     rowsNumber,
+	SQLPOINTER  data,
+	SQLINTEGER  *strLen_or_Ind,
+	SQLSMALLINT nullable)
+{
+	LOG("RTypeUtils::CreateInteger64Vector");
+
+	Rcpp::NumericVector vectorInR(Rcpp::no_init(rowsNumber));
+	int64_t *valuesInR = reinterpret_cast<int64_t *>(vectorInR.begin());
+	bool isNullable = nullable == SQL_NULLABLE && strLen_or_Ind != nullptr;
+
+	if constexpr (is_same_v<SQLType, SQLBIGINT>)
+	{
+		if (rowsNumber > 0)
+		{
+			memcpy(valuesInR, data, rowsNumber * sizeof(int64_t));
+		}
+	}
 
-		result += static_cast<double>(powerOf16 * lsd);
-		powerOf16 = powerOf16 * x_HexaDecimalBase;
+	if (isNullable || !is_same_v<SQLType, SQLBIGINT>)
+	{
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			if (isNullable && strLen_or_Ind[index] == SQL_NULL_DATA)
+			{
+				valuesInR[index] = x_NaInteger64;
+			}
+			else if constexpr (is_same_v<SQLType, SQL_NUMERIC_STRUCT>)
+			{
+				// A precision of at most 18 digits fits in the lower 8 bytes of the val array.
+				//
+				const SQL_NUMERIC_STRUCT &value = static_cast<SQL_NUMERIC_STRUCT *>(data)[index];
+				uint64_t magnitude = 0;
+				for (int byte = 7; byte >= 0; --byte)
+				{
+					magnitude = (magnitude << 8) | value.val[byte];
+				}
 
-		result += static_cast<double>(powerOf16 * msd);
-		powerOf16 = powerOf16 * x_HexaDecimalBase;
+				valuesInR[index] = value.sign == 1 ? static_cast<int64_t>(magnitude) :
+					-static_cast<int64_t>(magnitude);
+			}
+		}
 	}
 
-	return result;
+	vectorInR.attr("class") = "integer64";
+
+	return vectorInR;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -499,72 +791,60 @@ void RTypeUtils::FillDataFromRVector(
 }
 
 //--------------------------------------------------------------------------------------------------
-// Name: RTypeUtils::InsertStringBasedOnLengthAndRowsNumber
+// Name: RTypeUtils::FillDataFromInteger64Vector
 //
 // Description:
-//  Given the unicode string, inserts it into the data vector based on the
-//  rowsNumber(total number of rows) in the data
-//  and the length of the string adjusted as per allowedLen.
-//  We trim the string upto the allowedLen if the original length goes beyond it.
-//  For multiple rows with interspersed empty strings in the data, it doesn't add 0 length strings
-//  between two non-empty strings. But for a single row, it adds a 0 length string explicitly.
-//
-// Returns:
-//  The length of the string that is inserted.
-//
-// Remarks:
-//  In the case when an empty string is inserted in the vector, the return value is 0 since the
-//  length of the string inserted is 0 but the vector's size is still 1.
+//  Given the bit64::integer64 vectorInR, copies its content into the given std::vector pointed
+//  to by data. Copies the content only as far as the rowsNumber indicates.
+//  integer64 stores each 64-bit integer as the raw bits of a double, so the values are copied
+//  as a whole. The cells in the strLenOrInd array are set to the size of SQLBIGINT
+//  if the corresponding rows in the vectorInR are not NA_integer64.
+//  Otherwise if they are NA, sets nullable to true and the corresponding cells in
+//  the array strLenOrInd to SQL_NULL_DATA.
 //
-template<class SQLType, class UnicodeString>
-SQLINTEGER RTypeUtils::InsertStringBasedOnLengthAndRowsNumber(
-	const SQLULEN   allowedLen,
-	const SQLULEN   rowsNumber,
-	vector<SQLType> *data,
-	UnicodeString   &unicodeString)
+void RTypeUtils::FillDataFromInteger64Vector(
+	SQLULEN             rowsNumber,
+	Rcpp::NumericVector vectorInR,
+	vector<SQLBIGINT>   *data,
+	SQLINTEGER          *strLenOrInd,
+	SQLSMALLINT         &nullable)
 {
-	SQLINTEGER lengthOfStringToInsert = unicodeString.length();
+	LOG("RTypeUtils::FillDataFromInteger64Vector");
 
-	// Truncate size of return data to only be the size allowed,
-	// unless allowed length is equal to or greater than USHRT_MAX.
-	// In this case do not truncate as we have a max sized variable,
-	// ie: varchar(max) 
-	//
-	lengthOfStringToInsert =
-		static_cast<SQLULEN>(lengthOfStringToInsert) <= allowedLen || allowedLen >= USHRT_MAX
-		? lengthOfStringToInsert
-		: static_cast<SQLINTEGER>(allowedLen);
+	data->resize(rowsNumber);
 
-	if (rowsNumber > 1 || lengthOfStringToInsert > 0)
+	if (rowsNumber > 0)
 	{
-		// Do this when there are multiple rows in the data OR
-		// in case of single row, only when it is not an empty string.
-		//
-		data->insert(data->end(), unicodeString.begin(),
-			unicodeString.begin() + lengthOfStringToInsert);
+		memcpy(data->data(), vectorInR.begin(), rowsNumber * sizeof(SQLBIGINT));
 	}
-	else
+
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
 	{
-		// When its a single row and is an empty string,
-		// add a single element of value '\0' to the vector.
-		//
-		data->push_back(unicodeString[0]);
+		if ((*data)[index] != x_NaInteger64)
+		{
+			strLenOrInd[index] = sizeof(SQLBIGINT);
+		}
+		else
+		{
+			strLenOrInd[index] = SQL_NULL_DATA;
+			nullable = SQL_NULLABLE;
+		}
 	}
-
-	return lengthOfStringToInsert;
 }
 
 //--------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::FillDataFromCharacterVector
 //
 // Description:
-//  Given the vectorInR, copies its content into the given std::vector pointed to by data of SQLType.
+//  Given the vectorInR, appends its content to the given std::vector pointed to by data of SQLType.
 //  Copies the content only as far as the rowsNumber indicates.
 //  The cells in the strLenOrInd array are set to the number of bytes occupied by the
 //  corresponding strings in the vector being filled if the strings are not NA.
 //  Otherwise if they are NA strings, sets nullable and the corresponding cells in the array
 //  strLenOrInd to SQL_NULL_DATA. Also, returns the maxLen of character string identified after all
 //  the strings are scanned. maxLen or any of the string lengths cannot exceed the allowedLen.
+//  data is resized once to the exact length computed by GetCharacterVectorLengths, then the
+//  strings are copied into it by CopyCharacterVector.
 //
 template<class SQLType>
 void RTypeUtils::FillDataFromCharacterVector(
@@ -578,58 +858,210 @@ void RTypeUtils::FillDataFromCharacterVector(
 {
 	LOG("RTypeUtils::FillDataFromCharacterVector");
 
-	// Insert the character vectorInR into the charVector contiguously.
+	SQLULEN offset = data->size();
+	SQLULEN totalLength = GetCharacterVectorLengths<SQLType>(
+		rowsNumber,
+		vectorInR,
+		allowedLen,
+		strLenOrInd,
+		nullable,
+		maxLen);
+
+	data->resize(offset + totalLength);
+
+	CopyCharacterVector<SQLType>(
+		rowsNumber,
+		vectorInR,
+		strLenOrInd,
+		data->data() + offset);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::GetCharacterVectorLengths
+//
+// Description:
+//  First pass over the strings of vectorInR, up to rowsNumber. Sets the cells of strLenOrInd to
+//  the number of bytes the strings occupy once encoded as SQLType, utf-8 for SQLCHAR and utf-16
+//  for SQLWCHAR, or to SQL_NULL_DATA for NA strings in which case nullable is set.
+//  The utf-8 length is the LENGTH of the CHARSXP, the utf-16 length is computed once for each
+//  distinct CHARSXP found in a small cache, since R interns identical strings.
+//  A string longer than allowedLen characters of SQLType is truncated, unless allowedLen is equal
+//  to or greater than USHRT_MAX in which case we have a max sized variable, ie: varchar(max).
+//  Sets maxLen to the length of the longest string if it is greater.
+//
+// Returns:
+//  The number of SQLType characters needed to hold all the strings. For multiple rows, empty
+//  strings take no space, but a single row empty string takes a single '\0'.
+//
+template<class SQLType>
+SQLULEN RTypeUtils::GetCharacterVectorLengths(
+	SQLULEN               rowsNumber,
+	Rcpp::CharacterVector vectorInR,
+	SQLULEN               allowedLen,
+	SQLINTEGER            *strLenOrInd,
+	SQLSMALLINT           &nullable,
+	SQLULEN               &maxLen)
+{
+	LOG("RTypeUtils::GetCharacterVectorLengths");
+
+	SEXP vectorSexp = vectorInR;
+	SQLULEN totalLength = 0;
+
+	// Caches the utf-16 length of recently seen CHARSXPs.
 	//
-	for(SQLULEN index = 0 ; index < rowsNumber; ++index)
+	vector<pair<SEXP, SQLULEN>> lengthCache(
+		is_same_v<SQLType, SQLWCHAR> ? min<SQLULEN>(rowsNumber, x_EncodingCacheSize) : 0,
+		{ nullptr, 0 });
+
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
 	{
-		if (!Rcpp::CharacterVector::is_na(vectorInR[index]))
+		SEXP charInR = STRING_ELT(vectorSexp, index);
+
+		if (charInR == NA_STRING)
 		{
-			// This calculates the total number of bytes occupied by the character in R
-			// Since R utilizes utf-8 encoding, there could be characters that occupy
-			// more than 1 byte, so this may not correspond to the string length i.e. the
-			// number of characters.
-			//
-			SQLINTEGER bytesOccupied = strlen(vectorInR[index]);
+			nullable = SQL_NULLABLE;
+			strLenOrInd[index] = SQL_NULL_DATA;
+			continue;
+		}
 
-			// When generating a string from utf-8 encoded R data, use the bytesOccupied
-			// as the length of string.
-			//
-			string utf8String(vectorInR[index], bytesOccupied);
+		// This is the total number of bytes occupied by the character in R.
+		// Since R utilizes utf-8 encoding, there could be characters that occupy
+		// more than 1 byte, so this may not correspond to the string length i.e. the
+		// number of characters.
+		//
+		SQLULEN length = LENGTH(charInR);
 
-			SQLINTEGER lengthOfStringInserted = 0;
+		if constexpr (is_same_v<SQLType, SQLWCHAR>)
+		{
+			pair<SEXP, SQLULEN> &cachedLength = lengthCache[
+				(reinterpret_cast<uintptr_t>(charInR) >> 4) % lengthCache.size()];
 
-			if constexpr (is_same_v<SQLType, SQLWCHAR>)
+			if (cachedLength.first != charInR)
 			{
-				u16string utf16String;
-				estd::ToUtf16(utf8String.c_str(), bytesOccupied, utf16String);
-				lengthOfStringInserted =
-					InsertStringBasedOnLengthAndRowsNumber<SQLWCHAR, u16string>(
-						allowedLen,
-						rowsNumber,
-						data,
-						utf16String);
+				const char *utf8String = CHAR(charInR);
+				cachedLength.first = charInR;
+				cachedLength.second = IsAscii(utf8String, length) ?
+					length : estd::Utf16Size(utf8String, length);
 			}
-			else
+
+			length = cachedLength.second;
+		}
+
+		if (length > allowedLen && allowedLen < USHRT_MAX)
+		{
+			length = allowedLen;
+		}
+
+		strLenOrInd[index] = static_cast<SQLINTEGER>(length * sizeof(SQLType));
+		totalLength += length;
+
+		if (maxLen < length)
+		{
+			maxLen = length;
+		}
+
+		// When it is a single row and is an empty string,
+		// a single element of value '\0' is added.
+		//
+		if (rowsNumber == 1 && length == 0)
+		{
+			totalLength = 1;
+		}
+	}
+
+	return totalLength;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::CopyCharacterVector
+//
+// Description:
+//  Second pass over the strings of vectorInR, up to rowsNumber. Copies the non NA strings
+//  contiguously into data, which must hold the length returned by GetCharacterVectorLengths,
+//  using the lengths it set in strLenOrInd.
+//  utf-8 strings are copied as is, utf-16 strings are transcoded directly into data.
+//  A repeated CHARSXP found in a small cache is copied from its first utf-16 encoding in data
+//  instead of being transcoded again.
+//
+template<class SQLType>
+void RTypeUtils::CopyCharacterVector(
+	SQLULEN               rowsNumber,
+	Rcpp::CharacterVector vectorInR,
+	SQLINTEGER            *strLenOrInd,
+	SQLType               *data)
+{
+	LOG("RTypeUtils::CopyCharacterVector");
+
+	SEXP vectorSexp = vectorInR;
+	SQLULEN offset = 0;
+
+	// Caches the offset in data of the utf-16 encoding of recently seen CHARSXPs.
+	//
+	vector<pair<SEXP, SQLULEN>> encodingCache(
+		is_same_v<SQLType, SQLWCHAR> ? min<SQLULEN>(rowsNumber, x_EncodingCacheSize) : 0,
+		{ nullptr, 0 });
+
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
+	{
+		if (strLenOrInd[index] == SQL_NULL_DATA)
+		{
+			continue;
+		}
+
+		SEXP charInR = STRING_ELT(vectorSexp, index);
+		const char *utf8String = CHAR(charInR);
+		SQLULEN utf8Length = LENGTH(charInR);
+		SQLULEN length = strLenOrInd[index] / sizeof(SQLType);
+
+		if (length == 0)
+		{
+			if (rowsNumber == 1)
 			{
-				lengthOfStringInserted =
-					InsertStringBasedOnLengthAndRowsNumber<SQLCHAR, string>(
-						allowedLen,
-						rowsNumber,
-						data,
-						utf8String);
+				data[0] = 0;
 			}
 
-			strLenOrInd[index] = lengthOfStringInserted * sizeof(SQLType);
-			if (maxLen < static_cast<SQLULEN>(lengthOfStringInserted))
+			continue;
+		}
+
+		SQLType *str = data + offset;
+
+		if constexpr (is_same_v<SQLType, SQLWCHAR>)
+		{
+			static_assert(sizeof(SQLWCHAR) == sizeof(char16_t), "SQLWCHAR must be utf-16");
+
+			pair<SEXP, SQLULEN> &cachedEncoding = encodingCache[
+				(reinterpret_cast<uintptr_t>(charInR) >> 4) % encodingCache.size()];
+
+			if (cachedEncoding.first == charInR)
+			{
+				memcpy(str, data + cachedEncoding.second, length * sizeof(SQLType));
+			}
+			else if (IsAscii(utf8String, utf8Length))
 			{
-				maxLen = lengthOfStringInserted;
+				copy(utf8String, utf8String + length, str);
 			}
+			else if (estd::Utf16Size(utf8String, utf8Length) == length)
+			{
+				estd::ToUtf16(utf8String, utf8Length, reinterpret_cast<char16_t *>(str));
+			}
+			else
+			{
+				// The string is truncated, transcode it whole then copy only the allowed length.
+				//
+				u16string utf16String;
+				estd::ToUtf16(utf8String, utf8Length, utf16String);
+				memcpy(str, utf16String.data(), length * sizeof(SQLType));
+			}
+
+			cachedEncoding.first = charInR;
+			cachedEncoding.second = offset;
 		}
 		else
 		{
-			nullable = SQL_NULLABLE;
-			strLenOrInd[index] = SQL_NULL_DATA;
+			memcpy(str, utf8String, length);
 		}
+
+		offset += length;
 	}
 }
 
@@ -665,64 +1097,172 @@ void RTypeUtils::FillDataFromRawVector(
 	}
 }
 
-//-------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::FillDataFromRawList
+//
+// Description:
+//  Given the listInR of raw vectors, such as a binary input column, copies the raw vectors
+//  one after the other into the given std::vector pointed to by data.
+//  Copies the content only as far as the rowsNumber indicates; rows past the end of listInR
+//  are NULL. The cells in the strLenOrInd array are set to the length of each raw vector,
+//  or to SQL_NULL_DATA for the NULL items, in which case nullable is set to SQL_NULLABLE.
+//  maxLen is set to the length of the longest raw vector if it is greater.
+//
+void RTypeUtils::FillDataFromRawList(
+	SQLULEN         rowsNumber,
+	Rcpp::List      listInR,
+	vector<SQLCHAR> *data,
+	SQLINTEGER      *strLenOrInd,
+	SQLSMALLINT     &nullable,
+	SQLULEN         &maxLen)
+{
+	LOG("RTypeUtils::FillDataFromRawList");
+
+	SQLULEN listLength = listInR.size();
+
+	for (SQLULEN index = 0; index < rowsNumber; ++index)
+	{
+		SEXP item = index < listLength ? VECTOR_ELT(listInR, index) : R_NilValue;
+
+		if (TYPEOF(item) == RAWSXP)
+		{
+			SQLULEN length = XLENGTH(item);
+			data->insert(data->end(), RAW(item), RAW(item) + length);
+
+			strLenOrInd[index] = static_cast<SQLINTEGER>(length);
+			maxLen = max(maxLen, length);
+		}
+		else
+		{
+			strLenOrInd[index] = SQL_NULL_DATA;
+			nullable = SQL_NULLABLE;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::IsRawList
+//
+// Description:
+//  Checks whether the given vectorInR is a list whose items are all raw vectors or NULL,
+//  i.e. a list as created by CreateRawListVector for a binary column.
+//
+// Returns:
+//  true if vectorInR is such a list, false otherwise.
+//
+bool RTypeUtils::IsRawList(SEXP vectorInR)
+{
+	LOG("RTypeUtils::IsRawList");
+
+	if (TYPEOF(vectorInR) != VECSXP)
+	{
+		return false;
+	}
+
+	R_xlen_t length = XLENGTH(vectorInR);
+
+	for (R_xlen_t index = 0; index < length; ++index)
+	{
+		SEXPTYPE itemType = TYPEOF(VECTOR_ELT(vectorInR, index));
+
+		if (itemType != RAWSXP && itemType != NILSXP)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::FillDataFromDateTimeVector
 //
 // Description:
 //  Given the vectorInR, copies its content into the given std::vector pointed to by data.
 //  Copies the content only as far as the rowsNumber indicates.
+//  vectorInR holds the days (Date) or the seconds (POSIXct) since 1970-01-01 in UTC,
+//  which are converted into the SQL struct directly without going through Rcpp date objects.
+//  Seconds are rounded to microseconds, the precision of POSIXct in R.
 //  The cells in the strLenOrInd array are set to the size of the SQL data type if the
 //  corresponding rows in the vectorInR are not NA.
 //  Otherwise if they are NA, sets nullable to true, pushes back an empty zeroed struct
 //  into data, and sets the corresponding cells in the array strLenOrInd to SQL_NULL_DATA.
 //
-template<class SQLType, class RVectorType, class DateTimeTypeInR>
+template<class SQLType, class DateTimeTypeInR>
 void RTypeUtils::FillDataFromDateTimeVector(
-	SQLULEN         rowsNumber,
-	RVectorType     vectorInR,
-	vector<SQLType> *data,
-	SQLINTEGER      *strLenOrInd,
-	SQLSMALLINT     &nullable)
+	SQLULEN             rowsNumber,
+	Rcpp::NumericVector vectorInR,
+	vector<SQLType>     *data,
+	SQLINTEGER          *strLenOrInd,
+	SQLSMALLINT         &nullable)
 {
 	LOG("RTypeUtils::FillDataFromDateTimeVector");
 
+	const double *valuesInR = vectorInR.begin();
+	data->reserve(data->size() + rowsNumber);
+
 	for(SQLULEN index = 0 ; index < rowsNumber; ++index)
 	{
-		DateTimeTypeInR valueInR = static_cast<DateTimeTypeInR>(vectorInR[index]);
-		if (!valueInR.is_na())
+		double valueInR = valuesInR[index];
+
+		// The zeroed value is also the placeholder for null.
+		// The ODBC protocol used for exchange of data between Exthost and the extension expects
+		// empty value for null if the type is fixed and date/datetime/datetime2 are all
+		// fixed types.
+		//
+		SQLType value;
+		memset(&value, 0, sizeof(SQLType));
+
+		if (isfinite(valueInR))
 		{
-			// The valueInR is stored internally in UTC time zone in Rcpp
-			// and is returned back to Exthost in UTC as well.
-			//
-			SQLType value;
-			value.year = valueInR.getYear();
-			value.month = valueInR.getMonth();
-			value.day = valueInR.getDay();
+			long long daysSinceEpoch = 0;
 
-			if constexpr (is_same_v<RVectorType, Rcpp::DatetimeVector>)
+			if constexpr (is_same_v<DateTimeTypeInR, Rcpp::Datetime>)
 			{
-				value.hour = valueInR.getHours();
-				value.minute = valueInR.getMinutes();
-				value.second = valueInR.getSeconds();
+				// Round only the fractional part to microseconds, so that the rounding does not
+				// lose precision for the large epoch values of distant years.
+				//
+				double wholeSeconds = floor(valueInR);
+				long long secondsSinceEpoch = static_cast<long long>(wholeSeconds);
+				long long microSeconds = llround((valueInR - wholeSeconds) * x_MicroSecondsPerSecond);
+				if (microSeconds == x_MicroSecondsPerSecond)
+				{
+					++secondsSinceEpoch;
+					microSeconds = 0;
+				}
+
+				// Floor the division so that times before 1970 fall on the previous day.
+				//
+				const long long secondsPerDay = static_cast<long long>(x_SecondsPerDay);
+				daysSinceEpoch = secondsSinceEpoch / secondsPerDay;
+				long long secondsOfDay = secondsSinceEpoch % secondsPerDay;
+				if (secondsOfDay < 0)
+				{
+					secondsOfDay += secondsPerDay;
+					--daysSinceEpoch;
+				}
+
+				value.hour = static_cast<SQLUSMALLINT>(secondsOfDay / 3600);
+				value.minute = static_cast<SQLUSMALLINT>(secondsOfDay / 60 % 60);
+				value.second = static_cast<SQLUSMALLINT>(secondsOfDay % 60);
 
 				// "fraction" in TIMESTAMP_STRUCT is stored in nanoseconds,
 				// we convert from microseconds.
 				//
-				value.fraction = valueInR.getMicroSeconds() * 1000;
+				value.fraction = static_cast<SQLUINTEGER>(microSeconds) * 1000;
+			}
+			else
+			{
+				daysSinceEpoch = static_cast<long long>(floor(valueInR));
 			}
 
+			GetDateFromDaysSinceEpoch(daysSinceEpoch, value.year, value.month, value.day);
+
 			data->push_back(value);
 			strLenOrInd[index] = sizeof(SQLType);
 		}
 		else
 		{
-			// Add zeroed value for the null placeholder.
-			// The ODBC protocol used for exchange of data between Exthost and the extension expects
-			// empty value for null if the type is fixed and date/datetime/datetime2 are all
-			// fixed types.
-			//
-			SQLType value;
-			memset(&value, 0, sizeof(SQLType));
 			data->push_back(value);
 
 			strLenOrInd[index] = SQL_NULL_DATA;
@@ -731,6 +1271,34 @@ void RTypeUtils::FillDataFromDateTimeVector(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: RTypeUtils::GetDateFromDaysSinceEpoch
+//
+// Description:
+//  Computes the date of the proleptic Gregorian calendar that is the given number of days
+//  after 1970-01-01. This is the inverse of GetDaysSinceEpoch.
+//
+void RTypeUtils::GetDateFromDaysSinceEpoch(
+	long long    daysSinceEpoch,
+	SQLSMALLINT  &year,
+	SQLUSMALLINT &month,
+	SQLUSMALLINT &day)
+{
+	// Count from 0000-03-01 so that the leap day is the last day of the year.
+	//
+	long long daysSinceMarch = daysSinceEpoch + 719468;
+	long long era = (daysSinceMarch >= 0 ? daysSinceMarch : daysSinceMarch - 146096) / 146097;
+	long long dayOfEra = daysSinceMarch - era * 146097;
+	long long yearOfEra =
+		(dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	long long monthFromMarch = (5 * dayOfYear + 2) / 153;
+
+	day = static_cast<SQLUSMALLINT>(dayOfYear - (153 * monthFromMarch + 2) / 5 + 1);
+	month = static_cast<SQLUSMALLINT>(monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9);
+	year = static_cast<SQLSMALLINT>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+}
+
 //-------------------------------------------------------------------------------------------------
 // Name: RTypeUtils::FillDataFromNumericVector
 //
@@ -910,27 +1478,49 @@ template Rcpp::LogicalVector RTypeUtils::CreateVector<SQLCHAR, Rcpp::LogicalVect
 template Rcpp::CharacterVector RTypeUtils::CreateCharacterVector<char>(
 	SQLULEN    rowsNumber,
 	SQLPOINTER data,
-	SQLINTEGER *strLen_or_Ind);
+	SQLINTEGER *strLen_or_Ind,
+	bool       dedupe);
 
 template Rcpp::CharacterVector RTypeUtils::CreateCharacterVector<char16_t>(
 	SQLULEN    rowsNumber,
 	SQLPOINTER data,
-	SQLINTEGER *strLen_or_Ind);
+	SQLINTEGER *strLen_or_Ind,
+	bool       dedupe);
 
-template Rcpp::DateVector RTypeUtils::CreateDateTimeVector
-	<SQL_DATE_STRUCT, Rcpp::DateVector, Rcpp::Date>(
+template bool RTypeUtils::IsAscii<char>(
+	const char *str,
+	SQLULEN    length);
+
+template bool RTypeUtils::IsAscii<char16_t>(
+	const char16_t *str,
+	SQLULEN        length);
+
+template Rcpp::NumericVector RTypeUtils::CreateDateTimeVector
+	<SQL_DATE_STRUCT, Rcpp::Date>(
 		SQLULEN     rowsNumber,
 		SQLPOINTER  data,
 		SQLINTEGER  *strLen_or_Ind,
 		SQLSMALLINT nullable);
 
-template Rcpp::DatetimeVector RTypeUtils::CreateDateTimeVector
-	<SQL_TIMESTAMP_STRUCT, Rcpp::DatetimeVector, Rcpp::Datetime>(
+template Rcpp::NumericVector RTypeUtils::CreateDateTimeVector
+	<SQL_TIMESTAMP_STRUCT, Rcpp::Datetime>(
 		SQLULEN     rowsNumber,
 		SQLPOINTER  data,
 		SQLINTEGER  *strLen_or_Ind,
 		SQLSMALLINT nullable);
 
+template Rcpp::NumericVector RTypeUtils::CreateInteger64Vector<SQLBIGINT>(
+	SQLULEN     rowsNumber,
+	SQLPOINTER  data,
+	SQLINTEGER  *strLen_or_Ind,
+	SQLSMALLINT nullable);
+
+template Rcpp::NumericVector RTypeUtils::CreateInteger64Vector<SQL_NUMERIC_STRUCT>(
+	SQLULEN     rowsNumber,
+	SQLPOINTER  data,
+	SQLINTEGER  *strLen_or_Ind,
+	SQLSMALLINT nullable);
+
 template void RTypeUtils::FillDataFromRVector<SQLINTEGER, Rcpp::IntegerVector, SQL_C_SLONG>(
 	SQLULEN             rowsNumber,
 	Rcpp::IntegerVector vectorInR,
@@ -998,18 +1588,32 @@ template void RTypeUtils::FillDataFromCharacterVector<SQLWCHAR>(
 	SQLSMALLINT           &nullable,
 	SQLULEN               &maxLen);
 
+template SQLULEN RTypeUtils::GetCharacterVectorLengths<SQLCHAR>(
+	SQLULEN               rowsNumber,
+	Rcpp::CharacterVector vectorInR,
+	SQLULEN               allowedLen,
+	SQLINTEGER            *strLenOrInd,
+	SQLSMALLINT           &nullable,
+	SQLULEN               &maxLen);
+
+template void RTypeUtils::CopyCharacterVector<SQLCHAR>(
+	SQLULEN               rowsNumber,
+	Rcpp::CharacterVector vectorInR,
+	SQLINTEGER            *strLenOrInd,
+	SQLCHAR               *data);
+
 template void RTypeUtils::FillDataFromDateTimeVector
-	<SQL_DATE_STRUCT, Rcpp::DateVector, Rcpp::Date>(
+	<SQL_DATE_STRUCT, Rcpp::Date>(
 		SQLULEN                 rowsNumber,
-		Rcpp::DateVector        vectorInR,
+		Rcpp::NumericVector     vectorInR,
 		vector<SQL_DATE_STRUCT> *data,
 		SQLINTEGER              *strLenOrInd,
 		SQLSMALLINT             &nullable);
 
 template void RTypeUtils::FillDataFromDateTimeVector
-	<SQL_TIMESTAMP_STRUCT, Rcpp::DatetimeVector, Rcpp::Datetime>(
+	<SQL_TIMESTAMP_STRUCT, Rcpp::Datetime>(
 		SQLULEN                      rowsNumber,
-		Rcpp::DatetimeVector         vectorInR,
+		Rcpp::NumericVector          vectorInR,
 		vector<SQL_TIMESTAMP_STRUCT> *data,
 		SQLINTEGER                   *strLenOrInd,
 		SQLSMALLINT                  &nullable);
@@ -1023,6 +1627,9 @@ template unique_ptr<SQLDOUBLE[]> RTypeUtils::CopySQLTypeVector
 template unique_ptr<SQLINTEGER[]> RTypeUtils::CopySQLTypeVector
 	<SQLINTEGER>(const vector<SQLINTEGER> &src);
 
+template unique_ptr<SQLBIGINT[]> RTypeUtils::CopySQLTypeVector
+	<SQLBIGINT>(const vector<SQLBIGINT> &src);
+
 template unique_ptr<SQL_DATE_STRUCT[]> RTypeUtils::CopySQLTypeVector
 	<SQL_DATE_STRUCT>(const vector<SQL_DATE_STRUCT> &src);
 
@@ -29,11 +29,6 @@
 
 using namespace std;
 
-// Represents the max number of digits after the decimal point in the string representation
-// of nanoseconds converted to seconds.
-//
-#define MAXDIGITS_IN_NANOSECONDS 9
-
 const char* GuidFormat="%08lX-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X";
 
 //--------------------------------------------------------------------------------------------------
@@ -108,93 +103,6 @@ void Utilities::Tokenize(
 	}
 }
 
-//--------------------------------------------------------------------------------------------------
-// Name: Utilities::GetSecondsAfterDecimalPointFromNanoSeconds
-//
-// Description:
-//  From the given nanoSeconds value, generates a string representing seconds
-//  after the decimal point.
-//
-// Returns:
-//  string representing seconds after the decimal point.
-//
-string Utilities::GetSecondsAfterDecimalPointFromNanoSeconds(
-	SQLUINTEGER nanoSeconds)
-{
-	string secondsAfterDecimalPoint = to_string(nanoSeconds);
-	size_t digitsInNanoSeconds = strlen(secondsAfterDecimalPoint.c_str());
-
-	// 1 second = 10^9 nanoseconds = 10^6 microseconds;
-	// 0.100'000'000 second = 10^8 nanoseconds = 10^5 microseconds.
-	// We need to prefix with zeros the string representation of the seconds after decimal point
-	// if digits in nanoseconds are less than 9 to represent the correct seconds value.
-	//
-	if (digitsInNanoSeconds < MAXDIGITS_IN_NANOSECONDS)
-	{
-		size_t numberOfZeros = MAXDIGITS_IN_NANOSECONDS - digitsInNanoSeconds;
-		secondsAfterDecimalPoint = string(numberOfZeros, '0') + secondsAfterDecimalPoint;
-	}
-
-	return secondsAfterDecimalPoint;
-}
-
-//--------------------------------------------------------------------------------------------------
-// Name: Utilities::GetTimeZoneInR
-//
-// Description:
-//  Finds the current time zone defined in R if any
-//
-// Returns:
-//  The time zone environment variable's value as a string if it is set or an empty string if not.
-//
-string Utilities::GetTimeZoneInR()
-{
-	// This script finds the value of the environment variable TZ that defines the time zone if set
-	//
-	string scriptToFindTimeZoneInR = "Sys.getenv('TZ')[1]";
-	RInside* embeddedREnvPtr = REnvironment::EmbeddedREnvironment();
-
-	// Evaluate the script and store the result in a string
-	//
-	Rcpp::CharacterVector timeZoneInRVector(static_cast<SEXP>(
-		embeddedREnvPtr->parseEval(scriptToFindTimeZoneInR)));
-
-	string timeZoneInR = "";
-
-	if (timeZoneInRVector.size() > 0)
-	{
-		timeZoneInR = timeZoneInRVector[0];
-	}
-
-	return timeZoneInR;
-}
-
-//--------------------------------------------------------------------------------------------------
-// Name: Utilities::SetTimeZoneInR
-//
-// Description:
-//  Sets the time zone in R to the given value or unset it if the value is empty.
-//
-// Returns:
-//  Nothing.
-//
-void Utilities::SetTimeZoneInR(string valueToSet)
-{
-	if (valueToSet.length() > 0)
-	{
-		// Reset the stored time zone using the temporary variable above.
-		//
-		ExecuteScript("Sys.setenv(TZ = '" + valueToSet + "')");
-	}
-	else
-	{
-		// If time zone was not set, unset it again.
-		// On Windows, it default is UTC while on Linux it is the local time zone.
-		//
-		ExecuteScript("Sys.unsetenv('TZ')");
-	}
-}
-
 //--------------------------------------------------------------------------------------------------
 // Name: Utilities::NormalizePathString
 //
@@ -40,6 +40,7 @@ function build {
 
 	# Move the generated libs to configuration folder
 	mv RExtension-test ${CMAKE_CONFIGURATION}/
+	mv RExtension-benchmark ${CMAKE_CONFIGURATION}/
 
 	popd
 }
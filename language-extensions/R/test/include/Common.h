@@ -53,7 +53,11 @@
 #include "Rcpp.h"
 #include "RInside.h"
 
-#define TOTAL_NUMBER_OF_TEST_SUITES 2
+// The benchmarks define it to the number of their own test suites
+//
+#ifndef TOTAL_NUMBER_OF_TEST_SUITES
+	#define TOTAL_NUMBER_OF_TEST_SUITES 2
+#endif
 
 #include "RExtensionApiTests.h"
 #include "Unicode.h"
@@ -523,6 +523,15 @@ namespace ExtensionApiTest
 			(*m_dateTimeInfo).m_dataSet.data(),
 			(*m_dateTimeInfo).m_strLen_or_Ind.data(),
 			(*m_dateTimeInfo).m_columnNames);
+
+		// Datetime input columns are in UTC irrespective of the time zone R is set to.
+		//
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+		for (const string &columnName : (*m_dateTimeInfo).m_columnNames)
+		{
+			Rcpp::NumericVector column = inputDataSet[columnName.c_str()];
+			EXPECT_EQ(Rcpp::as<string>(column.attr("tzone")), "UTC");
+		}
 	}
 
 	//----------------------------------------------------------------------------------------------
@@ -579,6 +588,520 @@ namespace ExtensionApiTest
 			expectedDataSet);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteInteger64ColumnsTest
+	//
+	// Description:
+	//  Tests Execute with the r_useInteger64 parameter set, using an InputDataSet of BIGINT and
+	//  DECIMAL(18, 0) columns that must be added as exact bit64::integer64 values.
+	//
+	TEST_F(RExtensionApiTests, ExecuteInteger64ColumnsTest)
+	{
+		string scriptString = "OutputDataSet <- data.frame(RowsNumber = nrow(InputDataSet))";
+
+		InitializeSession(
+			2,  // inputSchemaColumnsNumber
+			scriptString,
+			1); // parametersNumber
+
+		string paramNameString = "@r_useInteger64";
+		SQLCHAR *paramName = static_cast<SQLCHAR*>(
+			static_cast<void*>(const_cast<char *>(paramNameString.c_str())));
+		SQLCHAR paramValue = 1;
+
+		SQLRETURN result = (*sm_initParamFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,                        // paramNumber
+			paramName,
+			paramNameString.length(), // paramNameLength
+			SQL_C_BIT,                // dataType
+			sizeof(SQLCHAR),          // paramSize
+			0,                        // decimalDigits
+			&paramValue,
+			sizeof(SQLCHAR),          // strLenOrInd
+			SQL_PARAM_INPUT);         // inputOutputType
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		string bigIntColumnName = "BigIntColumn";
+		InitializeColumn(0, // columnNumber
+			bigIntColumnName,
+			SQL_C_SBIGINT,
+			m_BigIntSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		string decimalColumnName = "DecimalColumn";
+		InitializeColumn(1, // columnNumber
+			decimalColumnName,
+			SQL_C_NUMERIC,
+			18,             // columnSize
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		const SQLINTEGER numericSize = sizeof(SQL_NUMERIC_STRUCT);
+		SQLULEN rowsNumber = 4;
+
+		vector<SQLBIGINT> bigIntColumn{ m_MaxBigInt, m_MinBigInt + 1, 0, -1 };
+
+		// 123456789012345678, -999999999999999999, NULL and 0.
+		//
+		vector<SQL_NUMERIC_STRUCT> decimalColumn{
+			{ 18, 0, 1, { 0x4E, 0xF3, 0x30, 0xA6, 0x4B, 0x9B, 0xB6, 0x01 } },
+			{ 18, 0, 0, { 0xFF, 0xFF, 0x63, 0xA7, 0xB3, 0xB6, 0xE0, 0x0D } },
+			{},
+			{ 18, 0, 1, { 0 } } };
+		vector<SQLINTEGER> bigIntStrLenOrInd{ m_BigIntSize, m_BigIntSize,
+			SQL_NULL_DATA, m_BigIntSize };
+		vector<SQLINTEGER> decimalStrLenOrInd{ numericSize, numericSize,
+			SQL_NULL_DATA, numericSize };
+
+		vector<void*> dataSet{ bigIntColumn.data(), decimalColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ bigIntStrLenOrInd.data(), decimalStrLenOrInd.data() };
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			rowsNumber,
+			dataSet.data(),
+			strLen_or_Ind.data(),
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		// NA_integer64 is the min value of a 64-bit integer.
+		//
+		vector<vector<SQLBIGINT>> expectedDataSet = {
+			{ m_MaxBigInt, m_MinBigInt + 1, m_MinBigInt, -1 },
+			{ 123456789012345678, -999999999999999999, m_MinBigInt, 0 }
+		};
+		vector<string> columnNames{ bigIntColumnName, decimalColumnName };
+
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+
+		for (size_t columnNumber = 0; columnNumber < columnNames.size(); ++columnNumber)
+		{
+			Rcpp::NumericVector column = inputDataSet[columnNames[columnNumber].c_str()];
+			EXPECT_EQ(Rcpp::as<string>(column.attr("class")), "integer64");
+			ASSERT_EQ(static_cast<SQLULEN>(column.size()), rowsNumber);
+
+			const SQLBIGINT *values = reinterpret_cast<const SQLBIGINT *>(column.begin());
+			for (SQLULEN index = 0; index < rowsNumber; ++index)
+			{
+				EXPECT_EQ(values[index], expectedDataSet[columnNumber][index]);
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteDedupeStringsTest
+	//
+	// Description:
+	//  Tests Execute with the r_dedupeStrings parameter set, using an InputDataSet of character
+	//  columns with repeated, null and non-ASCII values. The cache only saves lookups in the
+	//  global CHARSXP cache of R, which returns the same CHARSXP for equal strings either way,
+	//  so the test checks the values the cache returns.
+	//
+	TEST_F(RExtensionApiTests, ExecuteDedupeStringsTest)
+	{
+		string scriptString = "OutputDataSet <- data.frame(RowsNumber = nrow(InputDataSet))";
+
+		InitializeSession(
+			2,  // inputSchemaColumnsNumber
+			scriptString,
+			1); // parametersNumber
+
+		string paramNameString = "@r_dedupeStrings";
+		SQLCHAR *paramName = static_cast<SQLCHAR*>(
+			static_cast<void*>(const_cast<char *>(paramNameString.c_str())));
+		SQLINTEGER paramValue = 1;
+
+		SQLRETURN result = (*sm_initParamFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,                        // paramNumber
+			paramName,
+			paramNameString.length(), // paramNameLength
+			SQL_C_SLONG,              // dataType
+			sizeof(SQLINTEGER),       // paramSize
+			0,                        // decimalDigits
+			&paramValue,
+			sizeof(SQLINTEGER),       // strLenOrInd
+			SQL_PARAM_INPUT);         // inputOutputType
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		string charColumnName = "CharColumn";
+		InitializeColumn(0, // columnNumber
+			charColumnName,
+			SQL_C_CHAR,
+			m_CharSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		string ncharColumnName = "NCharColumn";
+		InitializeColumn(1, // columnNumber
+			ncharColumnName,
+			SQL_C_WCHAR,
+			m_NCharSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		SQLULEN rowsNumber = 5;
+		string charColumn = "redblueredr\xC3\xA9" "dred";
+		u16string ncharColumn = u"redblueredr\u00E9dred";
+		vector<SQLINTEGER> charStrLenOrInd{ 3, 4, 3, 4, SQL_NULL_DATA };
+		vector<SQLINTEGER> ncharStrLenOrInd{ 6, 8, 6, 6, SQL_NULL_DATA };
+
+		// The last values of the buffers are not used since the last rows are null.
+		//
+		vector<void*> dataSet{ charColumn.data(), ncharColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ charStrLenOrInd.data(), ncharStrLenOrInd.data() };
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			rowsNumber,
+			dataSet.data(),
+			strLen_or_Ind.data(),
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+		Rcpp::CharacterVector charValues = inputDataSet[charColumnName.c_str()];
+		Rcpp::CharacterVector ncharValues = inputDataSet[ncharColumnName.c_str()];
+
+		vector<string> expectedValues{ "red", "blue", "red", "r\xC3\xA9" "d" };
+
+		for (size_t index = 0; index < expectedValues.size(); ++index)
+		{
+			EXPECT_EQ(string(charValues[index]), expectedValues[index]);
+			EXPECT_EQ(string(ncharValues[index]), expectedValues[index]);
+		}
+
+		EXPECT_TRUE(Rcpp::CharacterVector::is_na(charValues[4]));
+		EXPECT_TRUE(Rcpp::CharacterVector::is_na(ncharValues[4]));
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteDedupeStringsCollisionsTest
+	//
+	// Description:
+	//  Tests Execute with the r_dedupeStrings parameter set, using a character column with more
+	//  distinct values than the cache has entries, so that different values share cache entries,
+	//  and with values too long to be cached.
+	//
+	TEST_F(RExtensionApiTests, ExecuteDedupeStringsCollisionsTest)
+	{
+		string scriptString = "OutputDataSet <- data.frame(RowsNumber = nrow(InputDataSet))";
+
+		InitializeSession(
+			1,  // inputSchemaColumnsNumber
+			scriptString,
+			1); // parametersNumber
+
+		string paramNameString = "@r_dedupeStrings";
+		SQLCHAR *paramName = static_cast<SQLCHAR*>(
+			static_cast<void*>(const_cast<char *>(paramNameString.c_str())));
+		SQLINTEGER paramValue = 1;
+
+		SQLRETURN result = (*sm_initParamFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,                        // paramNumber
+			paramName,
+			paramNameString.length(), // paramNameLength
+			SQL_C_SLONG,              // dataType
+			sizeof(SQLINTEGER),       // paramSize
+			0,                        // decimalDigits
+			&paramValue,
+			sizeof(SQLINTEGER),       // strLenOrInd
+			SQL_PARAM_INPUT);         // inputOutputType
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		string charColumnName = "CharColumn";
+		InitializeColumn(0, // columnNumber
+			charColumnName,
+			SQL_C_CHAR,
+			m_CharSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		// 1500 distinct short values repeated twice, and every tenth row a value longer than
+		// the strings that are cached.
+		//
+		SQLULEN rowsNumber = 3000;
+		vector<string> expectedValues(rowsNumber);
+		vector<SQLINTEGER> strLenOrInd(rowsNumber);
+		string charColumn;
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			if (index % 10 == 9)
+			{
+				expectedValues[index] = string(70, static_cast<char>('a' + index % 26))
+					+ to_string(index % 7);
+			}
+			else
+			{
+				expectedValues[index] = "value" + to_string(index % 1500);
+			}
+
+			strLenOrInd[index] = static_cast<SQLINTEGER>(expectedValues[index].size());
+			charColumn += expectedValues[index];
+		}
+
+		vector<void*> dataSet{ charColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ strLenOrInd.data() };
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			rowsNumber,
+			dataSet.data(),
+			strLen_or_Ind.data(),
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+		Rcpp::CharacterVector charValues = inputDataSet[charColumnName.c_str()];
+
+		ASSERT_EQ(static_cast<SQLULEN>(charValues.size()), rowsNumber);
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			ASSERT_EQ(string(charValues[index]), expectedValues[index]) << "at row " << index;
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteBinaryColumnsTest
+	//
+	// Description:
+	//  Tests Execute using an InputDataSet of a binary column,
+	//  which must be added as a list with a raw vector per row and NULL for null rows.
+	//
+	TEST_F(RExtensionApiTests, ExecuteBinaryColumnsTest)
+	{
+		string scriptString = "OutputDataSet <- data.frame(RowsNumber = nrow(InputDataSet))";
+
+		InitializeSession(
+			1, // inputSchemaColumnsNumber
+			scriptString);
+
+		string binaryColumnName = "BinaryColumn";
+		InitializeColumn(0, // columnNumber
+			binaryColumnName,
+			SQL_C_BINARY,
+			m_BinarySize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		SQLULEN rowsNumber = 4;
+		vector<SQLCHAR> binaryColumn{ 0x00, 0x01, 0xFF, 0x7F, 0x80 };
+		vector<SQLINTEGER> strLenOrInd{ 3, SQL_NULL_DATA, 0, 2 };
+
+		vector<void*> dataSet{ binaryColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ strLenOrInd.data() };
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			rowsNumber,
+			dataSet.data(),
+			strLen_or_Ind.data(),
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+		ASSERT_EQ(inputDataSet.nrows(), 4);
+
+		Rcpp::List column = inputDataSet[binaryColumnName.c_str()];
+		vector<vector<SQLCHAR>> expectedColumn{ { 0x00, 0x01, 0xFF }, {}, {}, { 0x7F, 0x80 } };
+
+		EXPECT_TRUE(Rf_isNull(column[1]));
+		for (SQLULEN index : { 0, 2, 3 })
+		{
+			Rcpp::RawVector value = column[index];
+			EXPECT_EQ(vector<SQLCHAR>(value.begin(), value.end()), expectedColumn[index]);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteBufferColumnsTest
+	//
+	// Description:
+	//  Tests Execute using an InputDataSet of INT and FLOAT columns without nulls, which R reads
+	//  directly from the input buffers. The script modifies one of the columns, and the
+	//  DataFrames must keep their values after Execute even when the buffers are overwritten.
+	//
+	TEST_F(RExtensionApiTests, ExecuteBufferColumnsTest)
+	{
+		string scriptString = "OutputDataSet <- InputDataSet;"
+			"InputDataSet$IntColumn[1] <- -1L;";
+
+		InitializeSession(
+			2, // inputSchemaColumnsNumber
+			scriptString);
+
+		string intColumnName = "IntColumn";
+		InitializeColumn(0, // columnNumber
+			intColumnName,
+			SQL_C_SLONG,
+			m_IntSize,
+			0,              // decimalDigits
+			SQL_NO_NULLS);
+
+		string doubleColumnName = "DoubleColumn";
+		InitializeColumn(1, // columnNumber
+			doubleColumnName,
+			SQL_C_DOUBLE,
+			m_DoubleSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		SQLULEN rowsNumber = 3;
+		vector<SQLINTEGER> intColumn{ 1, 2, 3 };
+		vector<SQLDOUBLE> doubleColumn{ 1.5, -2.25, 1e300 };
+		vector<SQLINTEGER> intStrLenOrInd(rowsNumber, m_IntSize);
+		vector<SQLINTEGER> doubleStrLenOrInd(rowsNumber, m_DoubleSize);
+
+		vector<void*> dataSet{ intColumn.data(), doubleColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ intStrLenOrInd.data(), doubleStrLenOrInd.data() };
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			rowsNumber,
+			dataSet.data(),
+			strLen_or_Ind.data(),
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+		EXPECT_EQ(outputschemaColumnsNumber, 2);
+
+		// The buffers are owned by the caller and may be reused once Execute returns.
+		//
+		fill(intColumn.begin(), intColumn.end(), 0);
+		fill(doubleColumn.begin(), doubleColumn.end(), 0.0);
+
+		Rcpp::DataFrame inputDataSet = m_globalEnvironment[m_inputDataNameString.c_str()];
+		Rcpp::DataFrame outputDataSet = m_globalEnvironment[m_outputDataNameString.c_str()];
+
+		Rcpp::IntegerVector modifiedIntColumn = inputDataSet[intColumnName.c_str()];
+		Rcpp::IntegerVector outputIntColumn = outputDataSet[intColumnName.c_str()];
+		Rcpp::NumericVector inputDoubleColumn = inputDataSet[doubleColumnName.c_str()];
+		Rcpp::NumericVector outputDoubleColumn = outputDataSet[doubleColumnName.c_str()];
+
+		vector<int> expectedIntColumn{ 1, 2, 3 };
+		vector<double> expectedDoubleColumn{ 1.5, -2.25, 1e300 };
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			EXPECT_EQ(modifiedIntColumn[index], index == 0 ? -1 : expectedIntColumn[index]);
+			EXPECT_EQ(outputIntColumn[index], expectedIntColumn[index]);
+			EXPECT_EQ(inputDoubleColumn[index], expectedDoubleColumn[index]);
+			EXPECT_EQ(outputDoubleColumn[index], expectedDoubleColumn[index]);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteScriptRepeatedlyTest
+	//
+	// Description:
+	//  Tests Execute called several times in the same session, as for stream batches.
+	//  The script is parsed once by Init and must be evaluated anew by every Execute.
+	//
+	TEST_F(RExtensionApiTests, ExecuteScriptRepeatedlyTest)
+	{
+		string scriptString = "if (!exists('executeCount')) executeCount <- 0L;"
+			"executeCount <- executeCount + 1L;"
+			"OutputDataSet <- InputDataSet;"
+			"OutputDataSet$IntColumn <- OutputDataSet$IntColumn * executeCount;";
+
+		InitializeSession(
+			1, // inputSchemaColumnsNumber
+			scriptString);
+
+		string intColumnName = "IntColumn";
+		InitializeColumn(0, // columnNumber
+			intColumnName,
+			SQL_C_SLONG,
+			m_IntSize,
+			0,              // decimalDigits
+			SQL_NO_NULLS);
+
+		SQLULEN rowsNumber = 2;
+		vector<SQLINTEGER> intColumn{ 1, 2 };
+		vector<SQLINTEGER> intStrLenOrInd(rowsNumber, m_IntSize);
+
+		vector<void*> dataSet{ intColumn.data() };
+		vector<SQLINTEGER*> strLen_or_Ind{ intStrLenOrInd.data() };
+
+		for (int executeCount = 1; executeCount <= 3; ++executeCount)
+		{
+			SQLUSMALLINT outputschemaColumnsNumber = 0;
+			SQLRETURN result = (*sm_executeFuncPtr)(
+				*m_sessionId,
+				m_taskId,
+				rowsNumber,
+				dataSet.data(),
+				strLen_or_Ind.data(),
+				&outputschemaColumnsNumber);
+			ASSERT_EQ(result, SQL_SUCCESS);
+			EXPECT_EQ(outputschemaColumnsNumber, 1);
+
+			Rcpp::DataFrame outputDataSet = m_globalEnvironment[m_outputDataNameString.c_str()];
+			Rcpp::IntegerVector outputIntColumn = outputDataSet[intColumnName.c_str()];
+
+			for (SQLULEN index = 0; index < rowsNumber; ++index)
+			{
+				EXPECT_EQ(outputIntColumn[index], intColumn[index] * executeCount);
+			}
+		}
+
+		m_globalEnvironment.remove("executeCount");
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: ExecuteInvalidScriptTest
+	//
+	// Description:
+	//  Tests Execute with a script that cannot be parsed and a script that fails when evaluated.
+	//  Both must make Execute return SQL_ERROR.
+	//
+	TEST_F(RExtensionApiTests, ExecuteInvalidScriptTest)
+	{
+		vector<string> scriptStrings{ "OutputDataSet <- (InputDataSet;",
+			"stop('Execution failed');" };
+
+		for (size_t scriptIndex = 0; scriptIndex < scriptStrings.size(); ++scriptIndex)
+		{
+			// The last session is cleaned up by TearDown.
+			//
+			if (scriptIndex > 0)
+			{
+				CleanupSession();
+			}
+
+			InitializeSession(
+				0, // inputSchemaColumnsNumber
+				scriptStrings[scriptIndex]);
+
+			SQLUSMALLINT outputschemaColumnsNumber = 0;
+			SQLRETURN result = (*sm_executeFuncPtr)(
+				*m_sessionId,
+				m_taskId,
+				0,
+				nullptr, // dataSet
+				nullptr, // strLen_or_Ind
+				&outputschemaColumnsNumber);
+			EXPECT_EQ(result, SQL_ERROR);
+		}
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: RExtensionApiTest::Execute
 	//
@@ -739,6 +739,91 @@ namespace ExtensionApiTest
 			expectedStrLenOrInd);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetNCharSupplementaryOutputParamTest
+	//
+	// Description:
+	//  Tests nvarchar values transcoded from utf-8 to utf-16: characters outside the Basic
+	//  Multilingual Plane, which take a surrogate pair, mixed with one, two and three byte utf-8
+	//  characters, a truncated multi-byte string, a long multi-byte string, NA and an empty string.
+	//
+	TEST_F(RExtensionApiTests, GetNCharSupplementaryOutputParamTest)
+	{
+		int paramsNumber = 6;
+
+		string scriptString = "param1 <- '\\U0001F600';"
+			"param2 <- 'a\\u00e9\\u4e2d\\U0001F600b';"
+			"param3 <- '\\u00e9\\u00e9\\u00e9';"
+			"param4 <- strrep('\\u00e9', 5000);"
+			"param5 <- as.character(NA);"
+			"param6 <- '';";
+
+		// Initialize with a Session that executes the above script
+		// that sets output parameters.
+		//
+		InitializeSession(
+			0,  // inputSchemaColumnsNumber
+			scriptString,
+			paramsNumber);
+
+		vector<bool> isFixedType = { false, false, false, false, false, false };
+		vector<SQLULEN> paramSizes = { 2, 10, 2, USHRT_MAX, 5, 5 };
+		vector<const wchar_t*> initParamValues(paramsNumber, L"");
+		vector<SQLSMALLINT> inputOutputTypes(paramsNumber, SQL_PARAM_INPUT_OUTPUT);
+
+		InitCharParam<wchar_t, SQL_C_WCHAR>(
+			initParamValues,
+			paramSizes,
+			isFixedType,
+			inputOutputTypes,
+			false);           // validate
+
+		SQLUSMALLINT outputSchemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,       // rowsNumber
+			nullptr, // dataSet
+			nullptr, // strLen_or_Ind
+			&outputSchemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputSchemaColumnsNumber, 0);
+
+		// The expected values are utf-16, which is what wchar_t holds with -fshort-wchar.
+		//
+		u16string longString(5000, u'\u00e9');
+
+		vector<const wchar_t*> expectedParamValues = {
+			// Test a single character taking a surrogate pair in NVARCHAR(2)
+			//
+			reinterpret_cast<const wchar_t*>(u"\U0001F600"),
+			// Test a surrogate pair among characters of one, two and three utf-8 bytes
+			//
+			reinterpret_cast<const wchar_t*>(u"a\u00e9\u4e2d\U0001F600b"),
+			// Test NVARCHAR(2) value with more multi-byte characters than the type allows
+			//
+			reinterpret_cast<const wchar_t*>(u"\u00e9\u00e9"),
+			// Test NVARCHAR(max) value with 5000 multi-byte characters
+			//
+			reinterpret_cast<const wchar_t*>(longString.c_str()),
+			nullptr,
+			L""};
+
+		vector<SQLINTEGER> expectedStrLenOrInd = {
+			static_cast<SQLINTEGER>(2 * sizeof(char16_t)),
+			static_cast<SQLINTEGER>(6 * sizeof(char16_t)),
+			static_cast<SQLINTEGER>(2 * sizeof(char16_t)),
+			static_cast<SQLINTEGER>(5000 * sizeof(char16_t)),
+			SQL_NULL_DATA,
+			0
+		};
+
+		GetNCharOutputParam(
+			expectedParamValues,
+			expectedStrLenOrInd);
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetRawOutputParamTest
 	//
@@ -846,6 +846,66 @@ namespace ExtensionApiTest
 			SQL_NO_NULLS); // nullable
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetClassedResultColumnsTest
+	//
+	// Description:
+	//  Test GetResultColumn with a script that returns a dataset with an integer backed Date
+	//  column and a POSIXct column, whose types come from their class attribute, then with a
+	//  script that returns an unsupported factor column, for which Execute fails.
+	//
+	TEST_F(RExtensionApiTests, GetClassedResultColumnsTest)
+	{
+		string scriptString =
+			"OutputDataSet <- data.frame(dateColumn = structure(c(0L, 1L), class = 'Date'),"
+				" dateTimeColumn = as.POSIXct(c(0, 1), origin = '1970-01-01', tz = 'UTC'));";
+
+		InitializeSession(
+			0,             // inputSchemaColumnsNumber
+			scriptString);
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,
+			nullptr,
+			nullptr,
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputschemaColumnsNumber, 2);
+
+		GetResultColumn(0,   // columnNumber
+			SQL_C_TYPE_DATE, // dataType
+			m_DateSize,      // columnSize
+			0,               // decimalDigits
+			SQL_NO_NULLS);   // nullable
+
+		GetResultColumn(1,        // columnNumber
+			SQL_C_TYPE_TIMESTAMP, // dataType
+			m_DateTimeSize,       // columnSize
+			6,                    // decimalDigits
+			SQL_NO_NULLS);        // nullable
+
+		CleanupSession();
+
+		scriptString = "OutputDataSet <- data.frame(factorColumn = factor(c('a', 'b')));";
+
+		InitializeSession(
+			0,             // inputSchemaColumnsNumber
+			scriptString);
+
+		result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,
+			nullptr,
+			nullptr,
+			&outputschemaColumnsNumber);
+		EXPECT_EQ(result, SQL_ERROR);
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetStreamIntegerResultColumnsTest
 	//
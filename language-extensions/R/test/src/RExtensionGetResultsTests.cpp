@@ -186,6 +186,99 @@ namespace ExtensionApiTest
 			(*m_bigIntInfo).m_columnNames);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetInteger64ResultsTest
+	//
+	// Description:
+	//  Tests GetResults with the r_useInteger64 parameter set and a script returning its
+	//  InputDataSet of a BIGINT column. The bit64::integer64 column must be returned as BIGINT,
+	//  keeping the values that a double cannot hold exactly.
+	//
+	TEST_F(RExtensionApiTests, GetInteger64ResultsTest)
+	{
+		InitializeSession(
+			1,  // inputSchemaColumnsNumber
+			"OutputDataSet <- InputDataSet",
+			1); // parametersNumber
+
+		string paramNameString = "@r_useInteger64";
+		SQLCHAR *paramName = static_cast<SQLCHAR*>(
+			static_cast<void*>(const_cast<char *>(paramNameString.c_str())));
+		SQLCHAR paramValue = 1;
+
+		SQLRETURN result = (*sm_initParamFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,                        // paramNumber
+			paramName,
+			paramNameString.length(), // paramNameLength
+			SQL_C_BIT,                // dataType
+			sizeof(SQLCHAR),          // paramSize
+			0,                        // decimalDigits
+			&paramValue,
+			sizeof(SQLCHAR),          // strLenOrInd
+			SQL_PARAM_INPUT);         // inputOutputType
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		InitializeColumn(0, // columnNumber
+			"BigIntColumn",
+			SQL_C_SBIGINT,
+			m_BigIntSize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		vector<SQLBIGINT> bigIntColumn{ m_MaxBigInt, m_MinBigInt + 1, 0, -1, 9007199254740993 };
+		vector<SQLINTEGER> bigIntStrLenOrInd{ m_BigIntSize, m_BigIntSize,
+			SQL_NULL_DATA, m_BigIntSize, m_BigIntSize };
+		SQLULEN inputRowsNumber = bigIntColumn.size();
+
+		vector<void*> inputDataSet{ bigIntColumn.data() };
+		vector<SQLINTEGER*> inputStrLen_or_Ind{ bigIntStrLenOrInd.data() };
+
+		SQLUSMALLINT outputSchemaColumnsNumber = 0;
+		result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			inputRowsNumber,
+			inputDataSet.data(),
+			inputStrLen_or_Ind.data(),
+			&outputSchemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputSchemaColumnsNumber, 1);
+
+		SQLULEN    rowsNumber = 0;
+		SQLPOINTER *data = nullptr;
+		SQLINTEGER **strLen_or_Ind = nullptr;
+
+		result = (*sm_getResultsFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			&rowsNumber,
+			&data,
+			&strLen_or_Ind);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		ASSERT_EQ(rowsNumber, inputRowsNumber);
+
+		const SQLBIGINT *bigIntData = static_cast<const SQLBIGINT*>(data[0]);
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			EXPECT_EQ(strLen_or_Ind[0][index], bigIntStrLenOrInd[index]) << "at row " << index;
+
+			if (bigIntStrLenOrInd[index] != SQL_NULL_DATA)
+			{
+				EXPECT_EQ(bigIntData[index], bigIntColumn[index]) << "at row " << index;
+			}
+		}
+
+		GetResultColumn(0,  // columnNumber
+			SQL_C_SBIGINT,  // dataType
+			m_BigIntSize,   // columnSize
+			0,              // decimalDigits
+			SQL_NULLABLE);  // nullable
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetSmallIntResultsTest
 	//
@@ -462,6 +555,68 @@ namespace ExtensionApiTest
 			columnNames);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetCharResultsFromScriptTest
+	//
+	// Description:
+	//  Tests GetResults with a script creating a character column with NA, an empty string,
+	//  multi-byte utf-8 strings, a character outside the Basic Multilingual Plane and a string
+	//  longer than all the others together. The column is returned as contiguous utf-8 strings.
+	//
+	TEST_F(RExtensionApiTests, GetCharResultsFromScriptTest)
+	{
+		string scriptString = "OutputDataSet <- data.frame(CharColumn = c('abc', NA, '', "
+			"'\\u00e9t\\u00e9', '\\u4e2d\\u6587', '\\U0001F600', strrep('xyz', 1000)), "
+			"stringsAsFactors = FALSE)";
+
+		InitializeSession(
+			0,             // inputSchemaColumnsNumber
+			scriptString);
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,  // input rowsNumber
+			nullptr,
+			nullptr,
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputschemaColumnsNumber, 1);
+
+		string longString;
+		for (int repetition = 0; repetition < 1000; ++repetition)
+		{
+			longString += "xyz";
+		}
+
+		// été, 中文 and U+1F600 encoded in utf-8
+		//
+		vector<const char*> expectedCharCol{ "abc", nullptr, "", "\xc3\xa9t\xc3\xa9",
+			"\xe4\xb8\xad\xe6\x96\x87", "\xf0\x9f\x98\x80", longString.c_str() };
+		vector<SQLINTEGER> expectedStrLenOrInd{ 3, SQL_NULL_DATA, 0, 5, 6, 4, 3000 };
+
+		vector<char> expectedCharColData =
+			GenerateContiguousData<char>(expectedCharCol, expectedStrLenOrInd.data());
+		void *expectedDataSet[] = { expectedCharColData.data() };
+		vector<SQLINTEGER*> expectedStrLen_or_Ind{ expectedStrLenOrInd.data() };
+
+		GetCharResults(
+			expectedCharCol.size(),
+			expectedDataSet,
+			expectedStrLen_or_Ind.data(),
+			{ "CharColumn" });
+
+		// The column size is the byte length of the longest string
+		//
+		GetResultColumn(0, // columnNumber
+			SQL_C_CHAR,    // dataType
+			3000,          // columnSize
+			0,             // decimalDigits
+			SQL_NULLABLE); // nullable
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetRawResultsTest
 	//
@@ -559,6 +714,79 @@ namespace ExtensionApiTest
 		EXPECT_EQ(strLen_or_Ind[0][0], SQL_NULL_DATA);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetRawResultsFromInputTest
+	//
+	// Description:
+	//  Tests GetResults with a script that returns its InputDataSet of a binary column as is.
+	//  The list of raw vectors the column is added as must be returned with one row per item.
+	//
+	TEST_F(RExtensionApiTests, GetRawResultsFromInputTest)
+	{
+		string scriptString = "OutputDataSet <- InputDataSet";
+
+		InitializeSession(
+			1, // inputSchemaColumnsNumber
+			scriptString);
+
+		InitializeColumn(0, // columnNumber
+			"BinaryColumn",
+			SQL_C_BINARY,
+			m_BinarySize,
+			0,              // decimalDigits
+			SQL_NULLABLE);
+
+		SQLULEN inputRowsNumber = 4;
+		vector<SQLCHAR> binaryColumn{ 0x00, 0x01, 0xFF, 0x7F, 0x80 };
+		vector<SQLINTEGER> inputStrLenOrInd{ 3, SQL_NULL_DATA, 0, 2 };
+
+		vector<void*> inputDataSet{ binaryColumn.data() };
+		vector<SQLINTEGER*> inputStrLen_or_Ind{ inputStrLenOrInd.data() };
+
+		SQLUSMALLINT outputSchemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			inputRowsNumber,
+			inputDataSet.data(),
+			inputStrLen_or_Ind.data(),
+			&outputSchemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputSchemaColumnsNumber, 1);
+
+		SQLULEN    rowsNumber = 0;
+		SQLPOINTER *data = nullptr;
+		SQLINTEGER **strLen_or_Ind = nullptr;
+
+		result = (*sm_getResultsFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			&rowsNumber,
+			&data,
+			&strLen_or_Ind);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(rowsNumber, inputRowsNumber);
+
+		SQLCHAR *rawData = static_cast<SQLCHAR*>(data[0]);
+		ASSERT_NE(rawData, nullptr);
+		EXPECT_EQ(vector<SQLCHAR>(rawData, rawData + binaryColumn.size()), binaryColumn);
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			EXPECT_EQ(strLen_or_Ind[0][index], inputStrLenOrInd[index]) << "at row " << index;
+		}
+
+		// The column size is the length of the longest value
+		//
+		GetResultColumn(0, // columnNumber
+			SQL_C_BINARY,  // dataType
+			3,             // columnSize
+			0,             // decimalDigits
+			SQL_NULLABLE); // nullable
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetDateResultsTest
 	//
@@ -622,6 +850,176 @@ namespace ExtensionApiTest
 			(*m_dateTimeInfo).m_columnNames);
 	}
 
+	//----------------------------------------------------------------------------------------------
+	// Name: GetDateTimeResultsFromScriptTest
+	//
+	// Description:
+	//  Tests GetResults with a script creating Date and POSIXct columns before 1970,
+	//  on a leap day, with fractional seconds and with integer storage for the Date column.
+	//
+	TEST_F(RExtensionApiTests, GetDateTimeResultsFromScriptTest)
+	{
+		string scriptString = ""
+			"OutputDataSet <- data.frame("
+			"DateColumn = structure(c(-1L, 11016L, NA, -719162L), class = 'Date'), "
+			"DateTimeColumn = as.POSIXct(c(-0.5, 951782400.25, NA, 253402300799.000092), "
+			"origin = '1970-01-01', tz = 'UTC'))";
+
+		// Initialize with a Session that executes the above script
+		// that creates a 4 row 2 column OutputDataSet.
+		//
+		InitializeSession(
+			0,             // inputSchemaColumnsNumber
+			scriptString);
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,  // input rowsNumber
+			nullptr,
+			nullptr,
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputschemaColumnsNumber, 2);
+
+		SQLULEN    rowsNumber = 0;
+		SQLPOINTER *data = nullptr;
+		SQLINTEGER **strLen_or_Ind = nullptr;
+		result = (*sm_getResultsFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			&rowsNumber,
+			&data,
+			&strLen_or_Ind);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		SQLULEN expectedRowsNumber = 4;
+		ASSERT_EQ(rowsNumber, expectedRowsNumber);
+
+		vector<SQL_DATE_STRUCT> expectedDates{
+			{ 1969, 12, 31 },
+			{ 2000, 2, 29 },
+			{},
+			{ 1, 1, 1 } };
+		vector<SQL_TIMESTAMP_STRUCT> expectedDateTimes{
+			{ 1969, 12, 31, 23, 59, 59, 500000000 },
+			{ 2000, 2, 29, 0, 0, 0, 250000000 },
+			{},
+			{ 9999, 12, 31, 23, 59, 59, 92000 } };
+		vector<SQLINTEGER> expectedDateStrLenOrInd{ m_DateSize, m_DateSize,
+			SQL_NULL_DATA, m_DateSize };
+		vector<SQLINTEGER> expectedDateTimeStrLenOrInd{ m_DateTimeSize, m_DateTimeSize,
+			SQL_NULL_DATA, m_DateTimeSize };
+
+		SQL_DATE_STRUCT *dates = static_cast<SQL_DATE_STRUCT *>(data[0]);
+		SQL_TIMESTAMP_STRUCT *dateTimes = static_cast<SQL_TIMESTAMP_STRUCT *>(data[1]);
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			EXPECT_EQ(strLen_or_Ind[0][index], expectedDateStrLenOrInd[index]);
+			EXPECT_EQ(strLen_or_Ind[1][index], expectedDateTimeStrLenOrInd[index]);
+
+			EXPECT_EQ(dates[index].year, expectedDates[index].year);
+			EXPECT_EQ(dates[index].month, expectedDates[index].month);
+			EXPECT_EQ(dates[index].day, expectedDates[index].day);
+
+			EXPECT_EQ(dateTimes[index].year, expectedDateTimes[index].year);
+			EXPECT_EQ(dateTimes[index].month, expectedDateTimes[index].month);
+			EXPECT_EQ(dateTimes[index].day, expectedDateTimes[index].day);
+			EXPECT_EQ(dateTimes[index].hour, expectedDateTimes[index].hour);
+			EXPECT_EQ(dateTimes[index].minute, expectedDateTimes[index].minute);
+			EXPECT_EQ(dateTimes[index].second, expectedDateTimes[index].second);
+			EXPECT_EQ(dateTimes[index].fraction, expectedDateTimes[index].fraction);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: GetLargeDateTimeResultsTest
+	//
+	// Description:
+	//  Tests GetResults with a script creating a POSIXct column of a few thousand rows that
+	//  crosses 1970-01-01, with a null row every thousand rows. Every value is a multiple of a
+	//  quarter second, so the fractions are exact.
+	//
+	TEST_F(RExtensionApiTests, GetLargeDateTimeResultsTest)
+	{
+		string scriptString = ""
+			"values <- seq(-5e6, by = 3661.25, length.out = 3000);"
+			"values[seq(1, length(values), by = 1000)] <- NA;"
+			"OutputDataSet <- data.frame(DateTimeColumn = as.POSIXct(values, "
+			"origin = '1970-01-01', tz = 'UTC'))";
+
+		InitializeSession(
+			0,             // inputSchemaColumnsNumber
+			scriptString);
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,  // input rowsNumber
+			nullptr,
+			nullptr,
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		EXPECT_EQ(outputschemaColumnsNumber, 1);
+
+		SQLULEN    rowsNumber = 0;
+		SQLPOINTER *data = nullptr;
+		SQLINTEGER **strLen_or_Ind = nullptr;
+		result = (*sm_getResultsFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			&rowsNumber,
+			&data,
+			&strLen_or_Ind);
+		ASSERT_EQ(result, SQL_SUCCESS);
+
+		SQLULEN expectedRowsNumber = 3000;
+		ASSERT_EQ(rowsNumber, expectedRowsNumber);
+
+		for (SQLULEN index = 0; index < rowsNumber; ++index)
+		{
+			SQLINTEGER expectedStrLenOrInd = index % 1000 == 0 ? SQL_NULL_DATA : m_DateTimeSize;
+			ASSERT_EQ(strLen_or_Ind[0][index], expectedStrLenOrInd) << "at row " << index;
+		}
+
+		// Rows on both sides of 1970-01-01 and of the null rows, with each quarter second
+		//
+		vector<SQLULEN> rows{ 0, 1, 2, 999, 1000, 1001, 1365, 1366, 1367, 2001, 2999 };
+		vector<SQL_TIMESTAMP_STRUCT> expectedDateTimes{
+			{},
+			{ 1969, 11, 4, 4, 7, 41, 250000000 },
+			{ 1969, 11, 4, 5, 8, 42, 500000000 },
+			{ 1969, 12, 16, 11, 6, 28, 750000000 },
+			{},
+			{ 1969, 12, 16, 13, 8, 31, 250000000 },
+			{ 1969, 12, 31, 23, 20, 6, 250000000 },
+			{ 1970, 1, 1, 0, 21, 7, 500000000 },
+			{ 1970, 1, 1, 1, 22, 8, 750000000 },
+			{ 1970, 1, 27, 22, 9, 21, 250000000 },
+			{ 1970, 3, 11, 5, 8, 8, 750000000 } };
+
+		SQL_TIMESTAMP_STRUCT *dateTimes = static_cast<SQL_TIMESTAMP_STRUCT *>(data[0]);
+
+		for (SQLULEN index = 0; index < rows.size(); ++index)
+		{
+			const SQL_TIMESTAMP_STRUCT &dateTime = dateTimes[rows[index]];
+			const SQL_TIMESTAMP_STRUCT &expectedDateTime = expectedDateTimes[index];
+
+			EXPECT_EQ(dateTime.year, expectedDateTime.year) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.month, expectedDateTime.month) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.day, expectedDateTime.day) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.hour, expectedDateTime.hour) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.minute, expectedDateTime.minute) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.second, expectedDateTime.second) << "at row " << rows[index];
+			EXPECT_EQ(dateTime.fraction, expectedDateTime.fraction) << "at row " << rows[index];
+		}
+	}
+
 	//----------------------------------------------------------------------------------------------
 	// Name: GetDifferentColumnResultsTest
 	//
@@ -143,7 +143,7 @@ namespace ExtensionApiTest
 				0,
 				m_columnName,
 				m_columnNameString.length(),
-				SQL_C_BINARY,   // Unsupported dataType
+				SQL_C_GUID,     // Unsupported dataType
 				m_CharSize,     // columnSize
 				0,              // decimalDigits
 				1,              // nullable
@@ -161,4 +161,37 @@ namespace ExtensionApiTest
 			0);                         // outputDataNameLength
 		EXPECT_EQ(result, SQL_ERROR);
 	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: InitSessionAndExecuteTest
+	//
+	// Description:
+	//  Tests InitSession() followed by Execute(), which evaluates the script parsed once by
+	//  InitSession in the global R environment.
+	//
+	TEST_F(RExtensionApiTests, InitSessionAndExecuteTest)
+	{
+		string scriptString = "parsedValue <- sum(1:10);"
+			"OutputDataSet <- data.frame(ParsedValue = parsedValue);";
+
+		InitializeSession(
+			0, // inputSchemaColumnsNumber
+			scriptString);
+
+		SQLUSMALLINT outputschemaColumnsNumber = 0;
+		SQLRETURN result = (*sm_executeFuncPtr)(
+			*m_sessionId,
+			m_taskId,
+			0,
+			nullptr, // dataSet
+			nullptr, // strLen_or_Ind
+			&outputschemaColumnsNumber);
+		ASSERT_EQ(result, SQL_SUCCESS);
+		EXPECT_EQ(outputschemaColumnsNumber, 1);
+
+		Rcpp::IntegerVector parsedValue = m_globalEnvironment["parsedValue"];
+		EXPECT_EQ(parsedValue[0], 55);
+
+		m_globalEnvironment.remove("parsedValue");
+	}
 }
@@ -7,6 +7,6 @@ apt-get update
 
 apt-get --no-install-recommends -y install curl zip unzip apt-transport-https
 
-apt-get install -y openjdk-17-jdk libc++1 libc6 libc++-dev libc++abi-dev libc++abi1
+apt-get install -y openjdk-17-jdk junit4 libc++1 libc6 libc++-dev libc++abi-dev libc++abi1
 
 exit $?
@@ -22,7 +22,13 @@ public:
 	// Constructor
 	//
 	JavaDataset() :
-		m_object(nullptr), m_env(nullptr), m_class(nullptr)
+		m_object(nullptr),
+		m_env(nullptr),
+		m_class(nullptr),
+		m_isDirectBufferDataset(false),
+		m_hasColumnMetadata(false),
+		m_setColumnNullBitmapMethod(nullptr),
+		m_getColumnNullBitmapMethod(nullptr)
 	{}
 
 	// Destructor, releases global references
@@ -39,11 +45,22 @@ public:
 			m_env->DeleteGlobalRef(m_class);
 		}
 
+		ReleaseArrays(m_columnArrays);
+		ReleaseArrays(m_secondaryArrays);
+		ReleaseArrays(m_nullMapArrays);
+
 		m_object = nullptr;
 		m_class = nullptr;
 		m_env = nullptr;
 	}
 
+	// Sets the JNI environment of the thread using the dataset
+	//
+	void SetEnv(JNIEnv *env)
+	{
+		m_env = env;
+	}
+
 	// Initializes the object
 	//
 	void Init(JNIEnv *env, const std::string &className);
@@ -72,7 +89,7 @@ public:
 		const SQLPOINTER data,
 		const SQLINTEGER *nullMap);
 
-	// Adds each column
+	// Adds each column, and the column metadata the first time columns are added
 	//
 	void AddColumns(
 		SQLUSMALLINT             numCols,
@@ -118,7 +135,17 @@ public:
 		std::vector<SQLSMALLINT> &colDecimalDigits,
 		std::vector<SQLSMALLINT> &nullableCols,
 		std::vector<SQLPOINTER>  &data,
-		std::vector<SQLINTEGER*> &nullMaps);
+		std::vector<SQLINTEGER*> &nullMaps,
+		std::vector<jobject>     &dataBuffers,
+		std::vector<jobject>     &nullMapBuffers);
+
+	// Gets the size in bytes of the data of the columns exchanged with ExtHost
+	//
+	static SQLULEN GetColumnsSizeInBytes(
+		SQLUSMALLINT                   numCols,
+		SQLULEN                        numRows,
+		const std::vector<SQLSMALLINT> &colTypes,
+		SQLINTEGER *const              *nullMaps);
 
 	// Get the jobject of the Java dataset
 	//
@@ -162,9 +189,20 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
-	// Internal add string column
+	// Internal add column backed by a direct buffer over the ODBC data
+	//
+	template<typename cType>
+	void AddColumnBufferInternal(
+		jint             colId,
+		SQLSMALLINT      colType,
+		SQLULEN          colSize,
+		SQLSMALLINT      decimalDigits,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
+	// Internal add Unicode string column
 	//
-	template<bool isUTF8>
 	void AddStringColumnInternal(
 		jint             colId,
 		SQLSMALLINT      colType,
@@ -174,6 +212,17 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add UTF-8 string column
+	//
+	void AddUtf8StringColumnInternal(
+		jint             colId,
+		SQLSMALLINT      colType,
+		SQLULEN          colSize,
+		SQLSMALLINT      decimalDigits,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal add binary column
 	//
 	void AddBinaryColumnInternal(
@@ -185,6 +234,14 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add binary column as one byte array and the offset of each row
+	//
+	bool AddOffsetBinaryColumnInternal(
+		jint             colId,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal add GUID column
 	//
 	void AddGuidColumnInternal(
@@ -196,6 +253,14 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add GUID column as the most and least significant 64 bits of each GUID
+	//
+	bool AddGuidBitsColumnInternal(
+		jint             colId,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal add date column
 	//
 	void AddDateColumnInternal(
@@ -207,6 +272,14 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add date column as days since 1970-01-01
+	//
+	bool AddEpochDateColumnInternal(
+		jint             colId,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal add numeric column
 	//
 	void AddNumericColumnInternal(
@@ -218,6 +291,15 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add numeric column as unscaled 64 bit values
+	//
+	bool AddUnscaledNumericColumnInternal(
+		jint             colId,
+		SQLSMALLINT      decimalDigits,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal add timestamp column
 	//
 	void AddTimestampColumnInternal(
@@ -229,6 +311,14 @@ private:
 		SQLPOINTER       data,
 		const SQLINTEGER *nullMap);
 
+	// Internal add timestamp column as seconds since 1970-01-01 00:00:00 and nanoseconds
+	//
+	bool AddEpochTimestampColumnInternal(
+		jint             colId,
+		jsize            numRows,
+		SQLPOINTER       data,
+		const SQLINTEGER *nullMap);
+
 	// Internal get column
 	//
 	template<typename jArrayType, typename jType, typename cType>
@@ -253,6 +343,16 @@ private:
 		SQLPOINTER  *data,
 		SQLINTEGER  **nullMap);
 
+	// Copies a string or binary column encoded by the Dataset into one byte array
+	//
+	void CopyEncodedColumn(
+		jint       colId,
+		jobject    jEncodedColumn,
+		SQLULEN    &numRows,
+		SQLULEN    &dataSizeInBytes,
+		SQLPOINTER *data,
+		SQLINTEGER **nullMap);
+
 	// Internal get binary column
 	//
 	void GetBinaryColumnInternal(
@@ -275,6 +375,14 @@ private:
 		SQLPOINTER  *data,
 		SQLINTEGER  **nullMap);
 
+	// Internal get date column from days since 1970-01-01
+	//
+	bool GetEpochDateColumnInternal(
+		jint       colId,
+		SQLULEN    &numRows,
+		SQLPOINTER *data,
+		SQLINTEGER **nullMap);
+
 	// Internal get numeric column
 	//
 	void GetNumericColumnInternal(
@@ -286,6 +394,16 @@ private:
 		SQLPOINTER  *data,
 		SQLINTEGER  **nullMap);
 
+	// Internal get numeric column from unscaled 64 bit values
+	//
+	bool GetUnscaledNumericColumnInternal(
+		jint        colId,
+		SQLULEN     colPrecision,
+		SQLSMALLINT colScale,
+		SQLULEN     &numRows,
+		SQLPOINTER  *data,
+		SQLINTEGER  **nullMap);
+
 	// Internal get timestamp column
 	//
 	void GetTimestampColumnInternal(
@@ -297,9 +415,21 @@ private:
 		SQLPOINTER  *data,
 		SQLINTEGER  **nullMap);
 
+	// Internal get timestamp column from seconds since 1970-01-01 00:00:00 and nanoseconds
+	//
+	bool GetEpochTimestampColumnInternal(
+		jint       colId,
+		SQLULEN    &numRows,
+		SQLPOINTER *data,
+		SQLINTEGER **nullMap);
+
 	// Internal get column null map
 	//
-	void GetColumnNullMap(jint colId, SQLULEN &numRows, SQLINTEGER **nullMap);
+	void GetColumnNullMap(
+		jint       colId,
+		SQLULEN    numDataRows,
+		SQLULEN    &numRows,
+		SQLINTEGER **nullMap);
 
 	// Calculates max size of variable length output
 	//
@@ -309,6 +439,22 @@ private:
 		unsigned long long &totalSizeInBytes,
 		SQLULEN            &dataTypeSizeInBytes);
 
+	// Gets a fixed width column written into direct buffers
+	//
+	bool GetColumnBuffer(
+		jint        colId,
+		SQLSMALLINT &colType,
+		SQLULEN     &colSize,
+		SQLULEN     &numRows,
+		SQLPOINTER  *data,
+		SQLINTEGER  **nullMap,
+		jobject     &dataBuffer,
+		jobject     &nullMapBuffer);
+
+	// Determines if the Dataset class is a DirectBufferDataset
+	//
+	bool IsDirectBufferDatasetClass();
+
 	// Finds Add<type>Column method in Dataset class
 	//
 	jmethodID FindAddColumnMethod(SQLSMALLINT colType);
@@ -321,9 +467,35 @@ private:
 	//
 	jmethodID FindDatasetMethod(const std::string& funcName, const std::string& funcSignature);
 
+	// Finds Java method in Dataset class, returns nullptr if the class does not have it
+	//
+	jmethodID FindOptionalDatasetMethod(
+		const std::string& funcName,
+		const std::string& funcSignature);
+
 	// Create column null map in JNI
 	//
-	jbooleanArray CreateJniNullMap(jsize numRows, const SQLINTEGER *values);
+	jbooleanArray CreateJniNullMap(jint colId, jsize numRows, const SQLINTEGER *values);
+
+	// Sets the column null map as a bitmap, if the Dataset supports null bitmaps
+	//
+	void SetJniNullBitmap(jint colId, jsize numRows, const SQLINTEGER *values);
+
+	// Finds the Dataset methods exchanging null maps as bitmaps
+	//
+	void FindNullBitmapMethods();
+
+	// Gets the array of a column kept from the previous batch, or creates a new one
+	//
+	template<typename jArrayType>
+	jArrayType GetReusableArray(
+		std::unordered_map<jint, jobject> &arrays,
+		jint                              colId,
+		jsize                             numRows);
+
+	// Releases the global references of the kept arrays
+	//
+	void ReleaseArrays(std::unordered_map<jint, jobject> &arrays);
 
 	// Creates null map to send to SQL
 	//
@@ -332,7 +504,15 @@ private:
 	jobject m_object;                                                     // Dataset object global reference
 	JNIEnv *m_env;                                                        // JNI enviroment
 	jclass m_class;                                                       // Dataset class reference
+	bool m_isDirectBufferDataset;                                         // Dataset accepts direct buffer columns
+	bool m_hasColumnMetadata;                                             // Column metadata was added
+	jmethodID m_setColumnNullBitmapMethod;                                // Method setting a null bitmap, if supported
+	jmethodID m_getColumnNullBitmapMethod;                                // Method getting a null bitmap, if supported
+	std::unordered_map<jint, jobject> m_columnArrays;                     // Column data arrays reused across batches
+	std::unordered_map<jint, jobject> m_secondaryArrays;                  // Timestamp nanosecond and GUID least significant bits arrays reused across batches
+	std::unordered_map<jint, jobject> m_nullMapArrays;                    // Null map arrays reused across batches
 	static std::unordered_map<SQLSMALLINT, fnAddColumn> m_fnAddColumnMap; // Function map for adding column to Dataset
+	static std::unordered_map<SQLSMALLINT, fnAddColumn> m_fnAddColumnBufferMap; // Function map for adding direct buffer column to Dataset
 	static std::unordered_map<SQLSMALLINT, fnGetColumn> m_fnGetColumnMap; // Function map for getting column from Dataset
 
 	// Function map typedefs
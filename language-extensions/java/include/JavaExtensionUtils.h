@@ -39,6 +39,17 @@ public:
 	//
 	static bool IsValidFile(const std::string &file);
 
+	// Gets the size and last modification time of a file or directory
+	//
+	static bool GetFileInfo(
+		const std::string  &path,
+		unsigned long long &size,
+		long long          &lastWriteTime);
+
+	// Gets the id of the current process
+	//
+	static unsigned long GetCurrentProcessIdentifier();
+
 	// Split a string based on a delimiter
 	//
 	static std::vector<std::string> SplitString(const std::string &str, const char delimiter);
@@ -51,6 +62,15 @@ public:
 	//
 	static void CleanupJvm();
 
+	// Gets the JNI environment of the calling thread, attaching the thread to the JVM if it
+	// is not attached yet
+	//
+	static JNIEnv* AttachCurrentThread(bool &attached);
+
+	// Detaches the calling thread from the JVM
+	//
+	static void DetachCurrentThread();
+
 private:
 	// Function pointer definition for JNI_CreateJVM
 	//
@@ -61,6 +81,30 @@ private:
 	//
 	static std::string GetClassPath();
 
+	// Gets the JVM options to create or use the class data sharing archive for the classpath
+	//
+	static std::vector<std::string> GetClassDataSharingOptions(
+		const std::string &jvmPath,
+		const std::string &classPath);
+
+	// Computes a fingerprint of the JVM, the classpath and the files on the classpath
+	//
+	static std::string GetClassPathFingerprint(
+		const std::string &jvmPath,
+		const std::string &classPath);
+
+	// Gets the major version of the Java runtime in JRE_HOME, 0 if unknown
+	//
+	static int GetJavaMajorVersion();
+
+	// Determines if the JVM can write a class data sharing archive when it is destroyed
+	//
+	static bool CanArchiveClassesAtExit();
+
+	// Renames the class data sharing archive written by the destroyed JVM to its final name
+	//
+	static void PublishClassDataSharingArchive();
+
 	// Constructs the path to the JVM library to load
 	//
 	static std::string GetJvmPath();
@@ -86,3 +130,37 @@ private:
 	//
 	static void UnloadJvm();
 };
+
+//---------------------------------------------------------------------
+// Description:
+// A JNIEnv pointer is only valid on the thread it belongs to, while ExtHost can call the
+// extension on any thread. This class gets the JNIEnv of the calling thread, attaching the
+// thread to the JVM if needed. When this object is destroyed the thread is detached again,
+// if it was attached by this object. GetEnv() returns nullptr if there is no JVM.
+//
+class AutoJniThreadAttach
+{
+public:
+	AutoJniThreadAttach() :
+		m_attached(false)
+	{
+		m_env = JavaExtensionUtils::AttachCurrentThread(m_attached);
+	}
+
+	~AutoJniThreadAttach()
+	{
+		if (m_attached)
+		{
+			JavaExtensionUtils::DetachCurrentThread();
+		}
+	}
+
+	JNIEnv* GetEnv() const
+	{
+		return m_env;
+	}
+
+private:
+	JNIEnv *m_env;
+	bool m_attached;
+};
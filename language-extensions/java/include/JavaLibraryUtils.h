@@ -22,5 +22,26 @@ public:
 	static std::string GetLibrariesClassPath();
 
 private:
-	static void FindAppendFileNames(const std::string &basePath, std::string &output);
+	// Appends the files of a library directory to the classpath, using the cached list of files
+	// when the directory did not change since it was scanned
+	//
+	static void AppendLibraryFileNames(const std::string &libraryPath, std::string &classPath);
+
+	// Reads the cached list of files of a library directory last modified at lastWriteTime
+	//
+	static bool ReadClassPathCache(
+		const std::string        &cachePath,
+		long long                lastWriteTime,
+		std::vector<std::string> &fileNames);
+
+	// Writes the list of files of a library directory last modified at lastWriteTime
+	//
+	static void WriteClassPathCache(
+		const std::string              &cachePath,
+		long long                      lastWriteTime,
+		const std::vector<std::string> &fileNames);
+
+	// Finds the paths of all the files under the base directory
+	//
+	static void FindFileNames(const std::string &basePath, std::vector<std::string> &fileNames);
 };
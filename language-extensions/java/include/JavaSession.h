@@ -12,6 +12,24 @@
 
 #include "Common.h"
 #include "JavaArgContainer.h"
+#include "JavaDataset.h"
+#include <chrono>
+
+// Timings, sizes and garbage collections of the phases of one execution of a session
+//
+struct JavaExecutionStats
+{
+	std::chrono::microseconds cleanupTime;  // Time cleaning up the previous output buffers
+	std::chrono::microseconds inputTime;    // Time adding the input columns to the dataset
+	std::chrono::microseconds executeTime;  // Time in the user execute()
+	std::chrono::microseconds outputTime;   // Time getting the output columns from the dataset
+	SQLULEN inputRows;                      // Number of input rows
+	SQLULEN inputBytes;                     // Size of the input data
+	SQLULEN outputRows;                     // Number of output rows
+	SQLULEN outputBytes;                    // Size of the output data
+	jlong gcCount;                          // Number of garbage collections during the execution
+	jlong gcTimeMs;                         // Time spent in these garbage collections
+};
 
 // Data pertaining to a session
 //
@@ -30,7 +48,9 @@ public:
 		m_taskId(0),
 		m_numTasks(0),
 		m_inputSchemaColumnsNumber(0),
-		m_numberOfOutputRows(0)
+		m_numberOfOutputRows(0),
+		m_collectStats(false),
+		m_stats()
 	{}
 
 	// Destructor, releases global references
@@ -60,6 +80,18 @@ public:
 		m_env = nullptr;
 	}
 
+	// Sets the JNI environment of the thread calling into the session
+	//
+	void SetEnv(JNIEnv *env)
+	{
+		m_env = env;
+
+		if (m_inputDataset != nullptr)
+		{
+			m_inputDataset->SetEnv(env);
+		}
+	}
+
 	// Init the session
 	//
 	void Init(
@@ -174,6 +206,10 @@ private:
 	//
 	void CleanupOutputDataBuffers();
 
+	// Log the statistics of the last execution
+	//
+	void LogExecutionStats();
+
 	SQLGUID m_sessionId;                  // Session ID
 	SQLUSMALLINT m_taskId;                // Task ID for this session
 	SQLUSMALLINT m_numTasks;              // Number of tasks for this session
@@ -186,6 +222,8 @@ private:
 	JavaArgContainer m_args;              // User input and output arguments
 	jobject m_argMap;                     // Global reference of the hash map for the execution parameters
 
+	std::unique_ptr<JavaDataset> m_inputDataset; // Input dataset reused across the batches of a stream
+
 	std::string m_mainClassName;          // User executor class name
 	std::string m_inputDatasetClassName;  // Input dataset class name for the executor class
 	std::string m_outputDatasetClassName; // Output dataset class name for the executor class
@@ -209,6 +247,11 @@ private:
 	std::vector<SQLULEN> m_outputColumnSizes;
 	std::vector<SQLPOINTER> m_outputData;
 	std::vector<SQLINTEGER*> m_outputNullMap;
+	std::vector<jobject> m_outputDataBuffers;
+	std::vector<jobject> m_outputNullMapBuffers;
 	std::vector<SQLSMALLINT> m_outputNullColumns;
 	std::vector<SQLSMALLINT> m_outputDecimalDigits;
+
+	bool m_collectStats;                  // Whether the statistics of the executions are collected
+	JavaExecutionStats m_stats;           // Statistics of the current execution
 };
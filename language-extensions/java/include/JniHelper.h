@@ -39,6 +39,14 @@ public:
 		jclass            jClass,
 		const std::string &funcName,
 		const std::string &funcSignature);
+
+	// Gets the total number of collections and the total time in milliseconds spent in them of
+	// the garbage collectors of the JVM
+	//
+	static void GetGarbageCollectionStats(
+		JNIEnv *env,
+		jlong  &collectionCount,
+		jlong  &collectionTimeMs);
 };
 
 //---------------------------------------------------------------------
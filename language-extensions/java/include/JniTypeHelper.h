@@ -11,6 +11,9 @@
 #pragma once
 
 #include "Common.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 class JniTypeHelper
 {
@@ -66,6 +69,17 @@ public:
 		const SQLINTEGER *nullMap,
 		jobjectArray     jArray);
 
+	// Copies UTF-8 string data to JNI as one byte array and an array of lengths
+	//
+	static void CopyUtf8StringInputData(
+		JNIEnv           *env,
+		jsize            numRows,
+		const SQLPOINTER values,
+		const SQLINTEGER *nullMap,
+		jsize            totalSizeInBytes,
+		jbyteArray       jData,
+		jintArray        jLengths);
+
 	// Create a string object from value
 	//
 	template<bool isUTF8>
@@ -80,6 +94,17 @@ public:
 		const SQLINTEGER *nullMap,
 		jobjectArray     jArray);
 
+	// Copies binary data to JNI as one byte array and the offset of each row
+	//
+	static void CopyOffsetBinaryInputData(
+		JNIEnv           *env,
+		jsize            numRows,
+		const SQLPOINTER values,
+		const SQLINTEGER *nullMap,
+		jsize            totalSizeInBytes,
+		jbyteArray       jData,
+		jintArray        jOffsets);
+
 	// Copies GUID data to JNI
 	//
 	static void CopyGuidInputData(
@@ -89,6 +114,15 @@ public:
 		const SQLINTEGER *nullMap,
 		jobjectArray     jArray);
 
+	// Copies GUID data to JNI as the most and least significant 64 bits of each GUID
+	//
+	static void CopyGuidBitsInputData(
+		SQLULEN          numRows,
+		SQLPOINTER       values,
+		const SQLINTEGER *nullMap,
+		jlong            *jMostSigBits,
+		jlong            *jLeastSigBits);
+
 	// Copies date data to JNI
 	//
 	static void CopyDateInputData(
@@ -110,6 +144,53 @@ public:
 		SQLSMALLINT      decimalDigits,
 		jobjectArray     jArray);
 
+	// Copies numeric data to JNI as unscaled 64 bit values
+	//
+	static bool CopyUnscaledNumericInputData(
+		SQLULEN          numRows,
+		SQLPOINTER       values,
+		const SQLINTEGER *nullMap,
+		jlong            *jData);
+
+	// Copies date data to JNI as days since 1970-01-01
+	//
+	static void CopyEpochDateInputData(
+		SQLULEN          numRows,
+		SQLPOINTER       values,
+		const SQLINTEGER *nullMap,
+		jlong            *jEpochDays);
+
+	// Copies timestamp data to JNI as seconds since 1970-01-01 00:00:00 and nanoseconds
+	//
+	static void CopyEpochTimestampInputData(
+		SQLULEN          numRows,
+		SQLPOINTER       values,
+		const SQLINTEGER *nullMap,
+		jlong            *jEpochSeconds,
+		jint             *jNanos);
+
+	// Determines if a null map has a null row
+	//
+	static bool HasNullData(SQLULEN numRows, const SQLINTEGER *nullMap);
+
+	// Copies a null map to JNI as a bitmap with the bit of each null row set
+	//
+	static void CopyNullBitmapInputData(
+		SQLULEN          numRows,
+		const SQLINTEGER *nullMap,
+		jlong            *jNullBitmap);
+
+	// Copies a null bitmap from JNI into a null map
+	//
+	static void CopyNullBitmapOutputData(
+		const jlong *jNullBitmap,
+		SQLULEN     numRows,
+		SQLINTEGER  *nullMap);
+
+	// Determines if a null bitmap of numRows rows has bits set past the last row
+	//
+	static bool HasNullBitmapRowsPastEnd(const jlong *jNullBitmap, SQLULEN numRows);
+
 	// Copies timestamp data to JNI
 	//
 	static void CopyTimestampInputData(
@@ -122,13 +203,12 @@ public:
 
 	// Copies data from JNI
 	//
-	template<typename jType, typename jArrayType, typename cType>
-	static void* CopyOutputData(
-		JNIEnv     *env,
-		jType      *outputColData,
-		jArrayType jArray,
-		SQLULEN    &numRows,
-		SQLULEN    &dataSizeInBytes);
+	template<typename jType, typename cType>
+	static void CopyOutputData(
+		const jType *outputColData,
+		jsize       numRows,
+		cType       *returnData,
+		SQLULEN     &dataSizeInBytes);
 
 	// Copies string data from JNI
 	//
@@ -171,6 +251,41 @@ public:
 		SQL_NUMERIC_STRUCT *target,
 		SQLINTEGER         *nullMap);
 
+	// Copies numeric data from JNI unscaled 64 bit values
+	//
+	static void CopyUnscaledNumericOutputData(
+		const jlong        *source,
+		jsize              numRows,
+		SQLCHAR            colPrecision,
+		SQLSMALLINT        colScale,
+		SQL_NUMERIC_STRUCT *target,
+		const SQLINTEGER   *nullMap);
+
+	// Copies date data from JNI days since 1970-01-01
+	//
+	static void CopyEpochDateOutputData(
+		const jlong      *epochDays,
+		jsize            numRows,
+		SQL_DATE_STRUCT  *target,
+		const SQLINTEGER *nullMap);
+
+	// Copies timestamp data from JNI seconds since 1970-01-01 00:00:00 and nanoseconds
+	//
+	static void CopyEpochTimestampOutputData(
+		const jlong          *epochSeconds,
+		const jint           *nanos,
+		jsize                numRows,
+		SQL_TIMESTAMP_STRUCT *target,
+		const SQLINTEGER     *nullMap);
+
+	// Converts a proleptic Gregorian calendar date to days since 1970-01-01
+	//
+	static jlong DaysFromCivil(jlong year, jlong month, jlong day);
+
+	// Converts days since 1970-01-01 to a proleptic Gregorian calendar date
+	//
+	static void CivilFromDays(jlong epochDays, jlong &year, jlong &month, jlong &day);
+
 	// Copies timestamp data from JNI
 	//
 	static void CopyTimestampOutputData(
@@ -258,6 +373,53 @@ public:
 		jmethodID            tsGetNanosMethod,
 		jmethodID            tsValueOfMethod,
 		SQL_TIMESTAMP_STRUCT &odbcTimestamp);
+
+	// Copies values between a Java array and an ODBC buffer of the same representation
+	//
+	template<typename targetType, typename sourceType>
+	static void CopyValues(
+		SQLULEN          numRows,
+		const sourceType *source,
+		targetType       *target,
+		std::true_type   isBitwiseCopy);
+
+	// Copies values between a Java array and an ODBC buffer converting each value
+	//
+	template<typename targetType, typename sourceType>
+	static void CopyValues(
+		SQLULEN          numRows,
+		const sourceType *source,
+		targetType       *target,
+		std::false_type  isBitwiseCopy);
+
+	// Copies values into a Java array, selecting the default value for null rows
+	//
+	template<typename jType, typename cType>
+	static void CopyNullableValues(
+		jsize            numRows,
+		const cType      *source,
+		const SQLINTEGER *nullMap,
+		jType            *target,
+		std::false_type  isFloatingPoint);
+
+	// Copies floating point values into a Java array, selecting their bits so null rows do not branch
+	//
+	template<typename jType, typename cType>
+	static void CopyNullableValues(
+		jsize            numRows,
+		const cType      *source,
+		const SQLINTEGER *nullMap,
+		jType            *target,
+		std::true_type   isFloatingPoint);
+
+	// Determines if values of the types have the same representation, so they can be copied
+	// with memcpy
+	//
+	template<typename targetType, typename sourceType>
+	struct IsBitwiseCopy : std::integral_constant<bool,
+		sizeof(targetType) == sizeof(sourceType) &&
+		std::is_floating_point<targetType>::value == std::is_floating_point<sourceType>::value>
+	{};
 };
 
 #include "JniTypeHelper.inl"
@@ -10,6 +10,7 @@
 //*********************************************************************
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <cstring> // Needed for memcpy in Linux
@@ -304,8 +305,10 @@ inline jsize JniTypeHelper::GetSizeInBytes<jstring, true>(JNIEnv *env, jstring v
 // Name: JniTypeHelper::CopyInputData
 //
 // Description:
-//  Copies data value one by one into the Java array and make sure that the default value is set if
-//  the value from SQL is null
+//  Copies the data into the Java array in one pass. Without a null map the data is copied with
+//  memcpy when the types have the same representation. With a null map each value is converted
+//  and the default value is selected for null rows in the same pass.
+//  Does not call JNI, so that jData can be a critical array region.
 //
 template<typename jType, typename cType>
 inline void JniTypeHelper::CopyInputData(
@@ -315,24 +318,118 @@ inline void JniTypeHelper::CopyInputData(
 	const SQLINTEGER *nullMap,
 	jType            *jData)
 {
-	char defaultNullVal = 0;
 	const cType *odbcData = static_cast<const cType*>(values);
 
 	if (odbcData != nullptr)
 	{
 		// Convert data and populate java array
 		//
-		for (SQLULEN i = 0; i < numRows; ++i)
+		if (nullMap == nullptr)
 		{
-			jData[i] = odbcData[i];
-			if (nullMap != nullptr && nullMap[i] == SQL_NULL_DATA)
-			{
-				jData[i] = defaultNullVal;
-			}
+			CopyValues(numRows, odbcData, jData, IsBitwiseCopy<jType, cType>());
+		}
+		else
+		{
+			CopyNullableValues(numRows, odbcData, nullMap, jData, std::is_floating_point<jType>());
 		}
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyNullableValues
+//
+// Description:
+//  Converts each value and selects the default value for null rows. The select compiles to a
+//  conditional move for integer types, so the loop has no branch on the null map.
+//
+template<typename jType, typename cType>
+inline void JniTypeHelper::CopyNullableValues(
+	jsize            numRows,
+	const cType      *source,
+	const SQLINTEGER *nullMap,
+	jType            *target,
+	std::false_type  isFloatingPoint)
+{
+	const jType defaultNullVal = jType();
+
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		const jType value = static_cast<jType>(source[i]);
+		target[i] = (nullMap[i] == SQL_NULL_DATA) ? defaultNullVal : value;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyNullableValues
+//
+// Description:
+//  Copies floating point values of the same type as integers of their size, selecting 0, the
+//  representation of 0.0, for null rows. A select of floating point values compiles to a branch,
+//  which is mispredicted on columns with scattered null rows; a select of integers compiles to a
+//  conditional move.
+//
+template<typename jType, typename cType>
+inline void JniTypeHelper::CopyNullableValues(
+	jsize            numRows,
+	const cType      *source,
+	const SQLINTEGER *nullMap,
+	jType            *target,
+	std::true_type   isFloatingPoint)
+{
+	static_assert(std::is_same<jType, cType>::value,
+		"Floating point columns are copied into Java arrays of the same type");
+
+	using Bits = typename std::conditional<sizeof(jType) == sizeof(uint32_t), uint32_t, uint64_t>::type;
+
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		Bits bits;
+		memcpy(&bits, &source[i], sizeof(bits));
+
+		bits = (nullMap[i] == SQL_NULL_DATA) ? Bits() : bits;
+		memcpy(&target[i], &bits, sizeof(bits));
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyValues
+//
+// Description:
+//  Copies values of the same representation with a single memcpy
+//
+template<typename targetType, typename sourceType>
+inline void JniTypeHelper::CopyValues(
+	SQLULEN          numRows,
+	const sourceType *source,
+	targetType       *target,
+	std::true_type   isBitwiseCopy)
+{
+	if (numRows > 0)
+	{
+		memcpy(target, source, numRows * sizeof(targetType));
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyValues
+//
+// Description:
+//  Copies values converting each of them, such as widening unsigned TINYINT values to jshort. The
+//  loop has no branches, so that the compiler can vectorize it.
+//
+template<typename targetType, typename sourceType>
+inline void JniTypeHelper::CopyValues(
+	SQLULEN          numRows,
+	const sourceType *source,
+	targetType       *target,
+	std::false_type  isBitwiseCopy)
+{
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		target[i] = static_cast<targetType>(source[i]);
+	}
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JniTypeHelper::CopyUnicodeStringInputData
 //
@@ -384,6 +481,83 @@ inline void JniTypeHelper::CopyStringInputData(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyUtf8StringInputData
+//
+// Description:
+//  Copy the UTF-8 string values of a column into the Java arrays in bulk. The bytes of all the
+//  values are contiguous in the ODBC buffer, so they are committed with one region copy. The
+//  lengths array receives the length in bytes of each value, or SQL_NULL_DATA for null values.
+//
+inline void JniTypeHelper::CopyUtf8StringInputData(
+	JNIEnv           *env,
+	jsize            numRows,
+	const SQLPOINTER values,
+	const SQLINTEGER *nullMap,
+	jsize            totalSizeInBytes,
+	jbyteArray       jData,
+	jintArray        jLengths)
+{
+	static_assert(sizeof(SQLINTEGER) == sizeof(jint), "SQLINTEGER and jint must have the same size");
+
+	if (values != nullptr && nullMap != nullptr)
+	{
+		if (totalSizeInBytes > 0)
+		{
+			env->SetByteArrayRegion(jData, 0, totalSizeInBytes, static_cast<const jbyte*>(values));
+		}
+
+		env->SetIntArrayRegion(jLengths, 0, numRows, reinterpret_cast<const jint*>(nullMap));
+	}
+	else
+	{
+		// Without the data or the lengths, every value is null
+		//
+		std::vector<jint> nullLengths(numRows, SQL_NULL_DATA);
+		env->SetIntArrayRegion(jLengths, 0, numRows, nullLengths.data());
+	}
+
+	JniHelper::ThrowOnJavaException(env);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyOffsetBinaryInputData
+//
+// Description:
+//  Copy the binary values of a column into the Java arrays in bulk. The bytes of all the values
+//  are contiguous in the ODBC buffer, so they are committed with one region copy. The offsets
+//  array receives the offset of each value in the byte array followed by the total size, so that
+//  value i spans from offset i to offset i + 1. Null values span no bytes.
+//
+inline void JniTypeHelper::CopyOffsetBinaryInputData(
+	JNIEnv           *env,
+	jsize            numRows,
+	const SQLPOINTER values,
+	const SQLINTEGER *nullMap,
+	jsize            totalSizeInBytes,
+	jbyteArray       jData,
+	jintArray        jOffsets)
+{
+	std::vector<jint> offsets(numRows + 1, 0);
+
+	if (values != nullptr && nullMap != nullptr)
+	{
+		if (totalSizeInBytes > 0)
+		{
+			env->SetByteArrayRegion(jData, 0, totalSizeInBytes, static_cast<const jbyte*>(values));
+		}
+
+		for (jsize i = 0; i < numRows; ++i)
+		{
+			offsets[i + 1] = offsets[i] + (nullMap[i] != SQL_NULL_DATA ? nullMap[i] : 0);
+		}
+	}
+
+	env->SetIntArrayRegion(jOffsets, 0, numRows + 1, offsets.data());
+
+	JniHelper::ThrowOnJavaException(env);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JniTypeHelper::CreateString
 //
@@ -535,45 +709,22 @@ inline void JniTypeHelper::CopyBinaryInputData(
 // Name: JniTypeHelper::CopyOutputData
 //
 // Description:
-//   Copy the data one by one out of the Java array into the array to return back to
-//   ExtHost. Make sure to set the data size and set the number of output rows given
-//   the length of the java array.
-//
-// Returns:
-//	Pointer to the output data
+//   Copy the data out of the Java array into the array to return back to ExtHost in one pass,
+//   with memcpy when the types have the same representation. Make sure to set the data size.
+//   Does not call JNI or allocate, so that outputColData can be a critical array region.
 //
-template<typename jType, typename jArrayType, typename cType>
-inline void* JniTypeHelper::CopyOutputData(
-	JNIEnv     *env,
-	jType      *outputColData,
-	jArrayType jArray,
-	SQLULEN    &numRows,
-	SQLULEN    &dataSizeInBytes)
+template<typename jType, typename cType>
+inline void JniTypeHelper::CopyOutputData(
+	const jType *outputColData,
+	jsize       numRows,
+	cType       *returnData,
+	SQLULEN     &dataSizeInBytes)
 {
 	// Set the size of the column
 	//
 	dataSizeInBytes = sizeof(cType);
-	cType *returnData = nullptr;
-
-	// Get the array length and declare a new buffer to hold the return data
-	//
-	if (jArray != nullptr)
-	{
-		jint len = env->GetArrayLength(jArray);
-		numRows = static_cast<SQLULEN>(len);
-		returnData = new cType[len];
-
-		for (jint i = 0; i < len; ++i)
-		{
-			returnData[i] = static_cast<cType>(outputColData[i]);
-		}
-	}
-	else
-	{
-		numRows = 0;
-	}
 
-	return returnData;
+	CopyValues(numRows, outputColData, returnData, IsBitwiseCopy<cType, jType>());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -902,6 +1053,45 @@ inline void JniTypeHelper::CopyGuidInputData(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyGuidBitsInputData
+//
+// Description:
+//  Copy SQLGUID values as the most and least significant 64 bits of each GUID, in the layout of
+//  java.util.UUID. Data1, Data2 and Data3 make the most significant bits, and the bytes of Data4
+//  the least significant bits, so the UUID formats as the GUID does. Null rows are set to 0.
+//
+inline void JniTypeHelper::CopyGuidBitsInputData(
+	SQLULEN          numRows,
+	SQLPOINTER       values,
+	const SQLINTEGER *nullMap,
+	jlong            *jMostSigBits,
+	jlong            *jLeastSigBits)
+{
+	const SQLGUID *odbcData = static_cast<SQLGUID*>(values);
+
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		uint64_t mostSigBits = 0;
+		uint64_t leastSigBits = 0;
+
+		if (nullMap == nullptr || nullMap[i] != SQL_NULL_DATA)
+		{
+			mostSigBits = (static_cast<uint64_t>(odbcData[i].Data1) << 32) |
+				(static_cast<uint64_t>(odbcData[i].Data2) << 16) |
+				static_cast<uint64_t>(odbcData[i].Data3);
+
+			for (int j = 0; j < 8; ++j)
+			{
+				leastSigBits = (leastSigBits << 8) | odbcData[i].Data4[j];
+			}
+		}
+
+		jMostSigBits[i] = static_cast<jlong>(mostSigBits);
+		jLeastSigBits[i] = static_cast<jlong>(leastSigBits);
+	}
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JniTypeHelper::CopyDateInputData
 //
@@ -1249,6 +1439,114 @@ inline void JniTypeHelper::CopyNumericOutputData(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyUnscaledNumericInputData
+//
+// Description:
+//  Copy the unscaled values of SQL_NUMERIC_STRUCT values into a jlong array. Null rows are set
+//  to 0.
+//
+// Returns:
+//	false if a value does not fit in a jlong, in which case the column has to be copied as
+//	java.math.BigDecimal instances instead
+//
+inline bool JniTypeHelper::CopyUnscaledNumericInputData(
+	SQLULEN          numRows,
+	SQLPOINTER       values,
+	const SQLINTEGER *nullMap,
+	jlong            *jData)
+{
+	const SQL_NUMERIC_STRUCT *odbcData = static_cast<SQL_NUMERIC_STRUCT*>(values);
+
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		jData[i] = 0;
+
+		if (nullMap != nullptr && nullMap[i] == SQL_NULL_DATA)
+		{
+			continue;
+		}
+
+		// The val field is a scaled integer in little endian order, only the low 8 bytes
+		// may be set for the value to fit in a jlong
+		//
+		const SQLCHAR *val = odbcData[i].val;
+
+		for (int j = sizeof(jlong); j < SQL_MAX_NUMERIC_LEN; ++j)
+		{
+			if (val[j] != 0)
+			{
+				return false;
+			}
+		}
+
+		uint64_t magnitude = 0;
+		for (int j = sizeof(jlong) - 1; j >= 0; --j)
+		{
+			magnitude = (magnitude << 8) | val[j];
+		}
+
+		if (magnitude > static_cast<uint64_t>(INT64_MAX))
+		{
+			return false;
+		}
+
+		jData[i] = odbcData[i].sign == 0 ?
+			-static_cast<jlong>(magnitude) : static_cast<jlong>(magnitude);
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyUnscaledNumericOutputData
+//
+// Description:
+//	Copy unscaled 64 bit values out of the Java array into SQL_NUMERIC_STRUCT values to return
+//	back to ExtHost. Null rows are zeroed.
+//
+inline void JniTypeHelper::CopyUnscaledNumericOutputData(
+	const jlong        *source,
+	jsize              numRows,
+	SQLCHAR            colPrecision,
+	SQLSMALLINT        colScale,
+	SQL_NUMERIC_STRUCT *target,
+	const SQLINTEGER   *nullMap)
+{
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		SQL_NUMERIC_STRUCT &odbcNumeric = target[i];
+
+		odbcNumeric = {0};
+		odbcNumeric.precision = colPrecision;
+		odbcNumeric.scale = static_cast<SQLCHAR>(colScale);
+		odbcNumeric.sign = 1;
+
+		if (nullMap != nullptr && nullMap[i] == SQL_NULL_DATA)
+		{
+			continue;
+		}
+
+		// Negate in unsigned arithmetic so that the minimum jlong value is handled
+		//
+		uint64_t magnitude = static_cast<uint64_t>(source[i]);
+
+		if (source[i] < 0)
+		{
+			odbcNumeric.sign = 0;
+			magnitude = 0 - magnitude;
+		}
+
+		// Store the val field as a scaled integer in little endian order
+		//
+		for (size_t j = 0; j < sizeof(jlong); ++j)
+		{
+			odbcNumeric.val[j] = static_cast<SQLCHAR>(magnitude & 0xFF);
+			magnitude >>= 8;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------------------------
 // Name: JniTypeHelper::BigDecimalToNumericStruct
 //
@@ -1389,6 +1687,288 @@ inline void JniTypeHelper::CopyTimestampInputData(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::DaysFromCivil
+//
+// Description:
+//  Converts a proleptic Gregorian calendar date to the number of days since 1970-01-01, using
+//  400 year eras so that the computation has no branches per month or leap year.
+//
+inline jlong JniTypeHelper::DaysFromCivil(jlong year, jlong month, jlong day)
+{
+	year -= month <= 2 ? 1 : 0;
+
+	const jlong era = (year >= 0 ? year : year - 399) / 400;
+	const jlong yearOfEra = year - era * 400;
+	const jlong dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	const jlong dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+	return era * 146097 + dayOfEra - 719468;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CivilFromDays
+//
+// Description:
+//  Converts the number of days since 1970-01-01 to a proleptic Gregorian calendar date.
+//  Inverse of DaysFromCivil.
+//
+inline void JniTypeHelper::CivilFromDays(jlong epochDays, jlong &year, jlong &month, jlong &day)
+{
+	epochDays += 719468;
+
+	const jlong era = (epochDays >= 0 ? epochDays : epochDays - 146096) / 146097;
+	const jlong dayOfEra = epochDays - era * 146097;
+	const jlong yearOfEra =
+		(dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	const jlong dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	const jlong monthIndex = (5 * dayOfYear + 2) / 153;
+
+	day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+	month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+	year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyEpochDateInputData
+//
+// Description:
+//  Copy SQL_DATE_STRUCT values as days since 1970-01-01 into a jlong array. Null rows are
+//  set to 0.
+//
+inline void JniTypeHelper::CopyEpochDateInputData(
+	SQLULEN          numRows,
+	SQLPOINTER       values,
+	const SQLINTEGER *nullMap,
+	jlong            *jEpochDays)
+{
+	const SQL_DATE_STRUCT *odbcData = static_cast<SQL_DATE_STRUCT*>(values);
+
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		if (nullMap == nullptr || nullMap[i] != SQL_NULL_DATA)
+		{
+			jEpochDays[i] = DaysFromCivil(odbcData[i].year, odbcData[i].month, odbcData[i].day);
+		}
+		else
+		{
+			jEpochDays[i] = 0;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::HasNullData
+//
+// Description:
+//  Determines if any row of the null map is SQL_NULL_DATA. The loop has no early exit, so that
+//  the compiler can vectorize it.
+//
+inline bool JniTypeHelper::HasNullData(SQLULEN numRows, const SQLINTEGER *nullMap)
+{
+	bool hasNull = false;
+
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		hasNull |= (nullMap[i] == SQL_NULL_DATA);
+	}
+
+	return hasNull;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyNullBitmapInputData
+//
+// Description:
+//  Copy a null map into a jlong array of (numRows + 63) / 64 elements. Bit (i % 64) of element
+//  (i / 64) is set when row i is null, the layout of java.util.BitSet.toLongArray().
+//
+inline void JniTypeHelper::CopyNullBitmapInputData(
+	SQLULEN          numRows,
+	const SQLINTEGER *nullMap,
+	jlong            *jNullBitmap)
+{
+	const SQLULEN numWords = (numRows + 63) / 64;
+
+	for (SQLULEN word = 0; word < numWords; ++word)
+	{
+		const SQLULEN first = word * 64;
+		const SQLULEN last = std::min(first + 64, numRows);
+		unsigned long long bits = 0;
+
+		for (SQLULEN i = first; i < last; ++i)
+		{
+			bits |= static_cast<unsigned long long>(nullMap[i] == SQL_NULL_DATA) << (i - first);
+		}
+
+		jNullBitmap[word] = static_cast<jlong>(bits);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyNullBitmapOutputData
+//
+// Description:
+//  Copy a jlong null bitmap, in the layout of CopyNullBitmapInputData, into a null map
+//
+inline void JniTypeHelper::CopyNullBitmapOutputData(
+	const jlong *jNullBitmap,
+	SQLULEN     numRows,
+	SQLINTEGER  *nullMap)
+{
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		const unsigned long long bits = static_cast<unsigned long long>(jNullBitmap[i / 64]);
+
+		nullMap[i] = ((bits >> (i % 64)) & 1) ? SQL_NULL_DATA : 0;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::HasNullBitmapRowsPastEnd
+//
+// Description:
+//  Checks the unused high bits of the last element of a null bitmap of (numRows + 63) / 64
+//  elements, which are set for rows past numRows
+//
+// Returns:
+//  true if any of those bits is set, false otherwise
+//
+inline bool JniTypeHelper::HasNullBitmapRowsPastEnd(const jlong *jNullBitmap, SQLULEN numRows)
+{
+	const SQLULEN usedBits = numRows % 64;
+
+	if (usedBits == 0)
+	{
+		return false;
+	}
+
+	const unsigned long long bits = static_cast<unsigned long long>(jNullBitmap[numRows / 64]);
+
+	return (bits >> usedBits) != 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyEpochTimestampInputData
+//
+// Description:
+//  Copy SQL_TIMESTAMP_STRUCT values as seconds since 1970-01-01 00:00:00 and nanoseconds into
+//  jlong and jint arrays. Null rows are set to 0.
+//
+inline void JniTypeHelper::CopyEpochTimestampInputData(
+	SQLULEN          numRows,
+	SQLPOINTER       values,
+	const SQLINTEGER *nullMap,
+	jlong            *jEpochSeconds,
+	jint             *jNanos)
+{
+	const SQL_TIMESTAMP_STRUCT *odbcData = static_cast<SQL_TIMESTAMP_STRUCT*>(values);
+
+	for (SQLULEN i = 0; i < numRows; ++i)
+	{
+		if (nullMap == nullptr || nullMap[i] != SQL_NULL_DATA)
+		{
+			const SQL_TIMESTAMP_STRUCT &odbcTimestamp = odbcData[i];
+
+			jEpochSeconds[i] =
+				DaysFromCivil(odbcTimestamp.year, odbcTimestamp.month, odbcTimestamp.day) * 86400 +
+				odbcTimestamp.hour * 3600 + odbcTimestamp.minute * 60 + odbcTimestamp.second;
+			jNanos[i] = static_cast<jint>(odbcTimestamp.fraction);
+		}
+		else
+		{
+			jEpochSeconds[i] = 0;
+			jNanos[i] = 0;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyEpochDateOutputData
+//
+// Description:
+//	Copy days since 1970-01-01 out of the Java array into SQL_DATE_STRUCT values to return back
+//	to ExtHost. Null rows are zeroed.
+//
+inline void JniTypeHelper::CopyEpochDateOutputData(
+	const jlong      *epochDays,
+	jsize            numRows,
+	SQL_DATE_STRUCT  *target,
+	const SQLINTEGER *nullMap)
+{
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		if (nullMap == nullptr || nullMap[i] != SQL_NULL_DATA)
+		{
+			jlong year = 0;
+			jlong month = 0;
+			jlong day = 0;
+
+			CivilFromDays(epochDays[i], year, month, day);
+
+			target[i].year = static_cast<SQLSMALLINT>(year);
+			target[i].month = static_cast<SQLUSMALLINT>(month);
+			target[i].day = static_cast<SQLUSMALLINT>(day);
+		}
+		else
+		{
+			memset(&target[i], 0, sizeof(SQL_DATE_STRUCT));
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniTypeHelper::CopyEpochTimestampOutputData
+//
+// Description:
+//	Copy seconds since 1970-01-01 00:00:00 and nanoseconds out of the Java arrays into
+//	SQL_TIMESTAMP_STRUCT values to return back to ExtHost. Null rows are zeroed.
+//
+inline void JniTypeHelper::CopyEpochTimestampOutputData(
+	const jlong          *epochSeconds,
+	const jint           *nanos,
+	jsize                numRows,
+	SQL_TIMESTAMP_STRUCT *target,
+	const SQLINTEGER     *nullMap)
+{
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		if (nullMap == nullptr || nullMap[i] != SQL_NULL_DATA)
+		{
+			// Round the days towards negative infinity for times before 1970
+			//
+			jlong epochDays = epochSeconds[i] / 86400;
+			jlong secondOfDay = epochSeconds[i] % 86400;
+
+			if (secondOfDay < 0)
+			{
+				secondOfDay += 86400;
+				--epochDays;
+			}
+
+			jlong year = 0;
+			jlong month = 0;
+			jlong day = 0;
+
+			CivilFromDays(epochDays, year, month, day);
+
+			SQL_TIMESTAMP_STRUCT &odbcTimestamp = target[i];
+
+			odbcTimestamp.year = static_cast<SQLSMALLINT>(year);
+			odbcTimestamp.month = static_cast<SQLUSMALLINT>(month);
+			odbcTimestamp.day = static_cast<SQLUSMALLINT>(day);
+			odbcTimestamp.hour = static_cast<SQLUSMALLINT>(secondOfDay / 3600);
+			odbcTimestamp.minute = static_cast<SQLUSMALLINT>(secondOfDay % 3600 / 60);
+			odbcTimestamp.second = static_cast<SQLUSMALLINT>(secondOfDay % 60);
+			odbcTimestamp.fraction = static_cast<SQLUINTEGER>(nanos[i]);
+		}
+		else
+		{
+			memset(&target[i], 0, sizeof(SQL_TIMESTAMP_STRUCT));
+		}
+	}
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JniTypeHelper::TimestampStructToJavaTimestamp
 //
@@ -12,6 +12,8 @@
 #pragma once
 
 #include "Common.h"
+#include "sqlextensionhostcallbacks.h"
+#include <atomic>
 
 #ifdef DEBUG
 #define LOG(msg) Logger::Log(msg)
@@ -41,6 +43,23 @@ public:
 	//
 	static void Log(const std::string &errorMsg);
 
+	// Set the LogXEvent callback of the host, nullptr if the host does not provide one
+	//
+	static void SetLogXEventCallback(PFunc_ExtensionLogXEvent callback);
+
+	// Returns true if the host provided a LogXEvent callback
+	//
+	static bool HasLogXEventCallback();
+
+	// Log a message as an XEvent of the session through the host, no-op if the host did not
+	// provide a LogXEvent callback
+	//
+	static void LogXEvent(
+		const SQLGUID       &sessionId,
+		SQLUSMALLINT        taskId,
+		ExtensionTraceLevel traceLevel,
+		const std::string   &msg);
+
 private:
 	// Get a string of the current timestamp in the same format
 	// of SQL format
@@ -50,4 +69,8 @@ private:
 	// Buffer to hold the timestamp string.
 	//
 	static char timestampBuffer[];
+
+	// LogXEvent callback of the host. Sessions log from their own threads, so it is atomic.
+	//
+	static std::atomic<PFunc_ExtensionLogXEvent> logXEventCallback;
 };
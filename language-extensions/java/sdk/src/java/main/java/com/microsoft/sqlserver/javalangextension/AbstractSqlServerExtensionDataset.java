@@ -1,7 +1,22 @@
 package com.microsoft.sqlserver.javalangextension;
 
 import java.lang.UnsupportedOperationException;
+import java.math.BigDecimal;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.CharBuffer;
+import java.nio.charset.CharsetEncoder;
+import java.nio.charset.CoderResult;
+import java.nio.charset.CodingErrorAction;
+import java.nio.charset.StandardCharsets;
 import java.sql.Date;
+import java.sql.Timestamp;
+import java.time.LocalDate;
+import java.time.LocalDateTime;
+import java.time.ZoneOffset;
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.UUID;
 
 /**
  * Abstract class containing interface for handling input and output data used by the Java
@@ -70,14 +85,75 @@ public class AbstractSqlServerExtensionDataset {
 		throw new UnsupportedOperationException("addStringColumn is not implemented");
 	}
 
+	/**
+	 * Adds a UTF-8 string column sent as the concatenated bytes of all rows and the length in bytes
+	 * of each row, where a negative length marks a null row. By default the rows are decoded and
+	 * passed to addStringColumn(int, String[]), so datasets only implementing that method keep working.
+	 */
+	public void addStringColumn(int columnId, byte[] data, int[] lengths) {
+		addStringColumn(columnId, decodeUtf8Strings(data, lengths));
+	}
+
 	public void addBinaryColumn(int columnId, byte[][] rows) {
 		throw new UnsupportedOperationException("addBinaryColumn is not implemented");
 	}
 
+	/**
+	 * Adds a binary column sent as the concatenated bytes of all rows, where row i holds the bytes
+	 * from offsets[i] to offsets[i + 1], with null rows marked by the null map. By default the rows
+	 * are copied into one array per row and passed to addBinaryColumn(int, byte[][]).
+	 */
+	public void addBinaryColumn(int columnId, byte[] data, int[] offsets, boolean[] nullMap) {
+		addBinaryColumn(columnId, toBinaries(data, offsets, nullMap));
+	}
+
+	/**
+	 * Adds a uniqueidentifier column as the most and least significant 64 bits of each GUID, which
+	 * are the values java.util.UUID is made of. By default the rows are formatted as upper case
+	 * strings and passed to addStringColumn(int, String[]).
+	 */
+	public void addGuidColumn(int columnId, long[] mostSigBits, long[] leastSigBits, boolean[] nullMap) {
+		addStringColumn(columnId, toGuidStrings(mostSigBits, leastSigBits, nullMap));
+	}
+
 	public void addDateColumn(int columnId, Date[] rows) {
 		throw new UnsupportedOperationException("addDateColumn is not implemented");
 	}
 
+	/**
+	 * Adds a date column as the number of days since 1970-01-01 of each row. By default the rows are
+	 * converted to java.sql.Date and passed to addDateColumn(int, Date[]).
+	 */
+	public void addDateColumn(int columnId, long[] epochDays, boolean[] nullMap) {
+		addDateColumn(columnId, toDates(epochDays, nullMap));
+	}
+
+	public void addTimestampColumn(int columnId, Timestamp[] rows) {
+		throw new UnsupportedOperationException("addTimestampColumn is not implemented");
+	}
+
+	/**
+	 * Adds a timestamp column as the number of seconds since 1970-01-01 00:00:00 and the nanoseconds
+	 * of each row. By default the rows are converted to java.sql.Timestamp and passed to
+	 * addTimestampColumn(int, Timestamp[]).
+	 */
+	public void addTimestampColumn(int columnId, long[] epochSeconds, int[] nanos, boolean[] nullMap) {
+		addTimestampColumn(columnId, toTimestamps(epochSeconds, nanos, nullMap));
+	}
+
+	public void addNumericColumn(int columnId, BigDecimal[] rows) {
+		throw new UnsupportedOperationException("addNumericColumn is not implemented");
+	}
+
+	/**
+	 * Adds a numeric column of precision 18 or less as the unscaled value of each row, with the given
+	 * scale. By default the rows are converted with BigDecimal.valueOf(long, int) and passed to
+	 * addNumericColumn(int, BigDecimal[]), so datasets only implementing that method keep working.
+	 */
+	public void addNumericColumn(int columnId, long[] unscaledValues, int scale, boolean[] nullMap) {
+		addNumericColumn(columnId, toBigDecimals(unscaledValues, scale, nullMap));
+	}
+
 	/**
 	 * Retrieving column interfaces
 	 */
@@ -113,7 +189,280 @@ public class AbstractSqlServerExtensionDataset {
 		throw new UnsupportedOperationException("getBinaryColumn is not implemented");
 	}
 
+	/**
+	 * Return a string or binary column with the values of all rows concatenated into one byte array
+	 * and the length in bytes of each row, -1 for null rows. Strings are encoded in UTF-8, or in UTF-16
+	 * in the native byte order if isUtf8 is false. By default the rows of getStringColumn() or
+	 * getBinaryColumn() are encoded in a single pass, and null is returned for a null column.
+	 */
+	public EncodedColumn getEncodedStringColumn(int columnId, boolean isUtf8) {
+		String[] rows = getStringColumn(columnId);
+
+		if (rows == null) {
+			return null;
+		}
+
+		return isUtf8 ? encodeUtf8Strings(rows) : encodeUtf16Strings(rows);
+	}
+
+	public EncodedColumn getEncodedBinaryColumn(int columnId) {
+		byte[][] rows = getBinaryColumn(columnId);
+		return rows == null ? null : encodeBinaries(rows);
+	}
+
 	public Date[] getDateColumn(int columnId) {
 		throw new UnsupportedOperationException("getDateColumn is not implemented");
 	}
+
+	public Timestamp[] getTimestampColumn(int columnId) {
+		throw new UnsupportedOperationException("getTimestampColumn is not implemented");
+	}
+
+	/**
+	 * Return a date column as days since 1970-01-01, or a timestamp column as seconds since
+	 * 1970-01-01 00:00:00 and nanoseconds, with null rows marked by getColumnNullMap(). Return null
+	 * if the column is only available through getDateColumn() or getTimestampColumn(), which is the
+	 * default.
+	 */
+	public long[] getEpochDayColumn(int columnId) {
+		return null;
+	}
+
+	public long[] getEpochSecondColumn(int columnId) {
+		return null;
+	}
+
+	public int[] getNanosColumn(int columnId) {
+		return null;
+	}
+
+	public BigDecimal[] getNumericColumn(int columnId) {
+		throw new UnsupportedOperationException("getNumericColumn is not implemented");
+	}
+
+	/**
+	 * Returns a numeric column as the unscaled value of each row, in the scale of the column, with
+	 * null rows marked by getColumnNullMap(). Returns null if the column is only available through
+	 * getNumericColumn(), which is the default.
+	 */
+	public long[] getUnscaledNumericColumn(int columnId) {
+		return null;
+	}
+
+	/**
+	 * Converts unscaled values into BigDecimal instances, with null for the rows marked in the null map
+	 */
+	protected static BigDecimal[] toBigDecimals(long[] unscaledValues, int scale, boolean[] nullMap) {
+		BigDecimal[] rows = new BigDecimal[unscaledValues.length];
+
+		for (int i = 0; i < unscaledValues.length; i++) {
+			if (nullMap == null || !nullMap[i]) {
+				rows[i] = BigDecimal.valueOf(unscaledValues[i], scale);
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Converts days since 1970-01-01 into java.sql.Date instances, with null for the rows marked in the
+	 * null map
+	 */
+	protected static Date[] toDates(long[] epochDays, boolean[] nullMap) {
+		Date[] rows = new Date[epochDays.length];
+
+		for (int i = 0; i < epochDays.length; i++) {
+			if (nullMap == null || !nullMap[i]) {
+				rows[i] = Date.valueOf(LocalDate.ofEpochDay(epochDays[i]));
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Converts seconds since 1970-01-01 00:00:00 and nanoseconds into java.sql.Timestamp instances,
+	 * with null for the rows marked in the null map
+	 */
+	protected static Timestamp[] toTimestamps(long[] epochSeconds, int[] nanos, boolean[] nullMap) {
+		Timestamp[] rows = new Timestamp[epochSeconds.length];
+
+		for (int i = 0; i < epochSeconds.length; i++) {
+			if (nullMap == null || !nullMap[i]) {
+				rows[i] = Timestamp.valueOf(LocalDateTime.ofEpochSecond(epochSeconds[i], nanos[i], ZoneOffset.UTC));
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Copies the concatenated bytes of a binary column into one array per row, with null for the
+	 * rows marked in the null map
+	 */
+	protected static byte[][] toBinaries(byte[] data, int[] offsets, boolean[] nullMap) {
+		byte[][] rows = new byte[offsets.length - 1][];
+
+		for (int i = 0; i < rows.length; i++) {
+			if (nullMap == null || !nullMap[i]) {
+				rows[i] = Arrays.copyOfRange(data, offsets[i], offsets[i + 1]);
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Formats the most and least significant bits of GUIDs as upper case strings, with null for the
+	 * rows marked in the null map
+	 */
+	protected static String[] toGuidStrings(long[] mostSigBits, long[] leastSigBits, boolean[] nullMap) {
+		String[] rows = new String[mostSigBits.length];
+
+		for (int i = 0; i < rows.length; i++) {
+			if (nullMap == null || !nullMap[i]) {
+				rows[i] = new UUID(mostSigBits[i], leastSigBits[i]).toString().toUpperCase(Locale.ROOT);
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Decodes the concatenated UTF-8 bytes of a string column into one string per row
+	 */
+	protected static String[] decodeUtf8Strings(byte[] data, int[] lengths) {
+		String[] rows = new String[lengths.length];
+		int offset = 0;
+
+		for (int i = 0; i < lengths.length; i++) {
+			if (lengths[i] >= 0) {
+				rows[i] = new String(data, offset, lengths[i], StandardCharsets.UTF_8);
+				offset += lengths[i];
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Encodes the strings of a column into UTF-8 with one reusable encoder, writing straight into the
+	 * byte array of the column. Unmappable characters are replaced as String.getBytes() does.
+	 */
+	protected static EncodedColumn encodeUtf8Strings(String[] rows) {
+		CharsetEncoder encoder = StandardCharsets.UTF_8.newEncoder()
+			.onMalformedInput(CodingErrorAction.REPLACE)
+			.onUnmappableCharacter(CodingErrorAction.REPLACE);
+
+		int[] lengths = new int[rows.length];
+		ByteBuffer buffer = ByteBuffer.allocate(Math.max(64, rows.length * 16));
+
+		for (int i = 0; i < rows.length; i++) {
+			if (rows[i] == null) {
+				lengths[i] = -1;
+				continue;
+			}
+
+			int start = buffer.position();
+			CharBuffer chars = CharBuffer.wrap(rows[i]);
+
+			encoder.reset();
+			CoderResult result = encoder.encode(chars, buffer, true);
+			while (result.isOverflow()) {
+				buffer = grow(buffer, chars.remaining() * 3);
+				result = encoder.encode(chars, buffer, true);
+			}
+
+			result = encoder.flush(buffer);
+			while (result.isOverflow()) {
+				buffer = grow(buffer, 16);
+				result = encoder.flush(buffer);
+			}
+
+			lengths[i] = buffer.position() - start;
+		}
+
+		return new EncodedColumn(buffer.array(), lengths);
+	}
+
+	/**
+	 * Copies the characters of the strings of a column as UTF-16 in the native byte order
+	 */
+	protected static EncodedColumn encodeUtf16Strings(String[] rows) {
+		int[] lengths = new int[rows.length];
+		int totalChars = 0;
+
+		for (int i = 0; i < rows.length; i++) {
+			if (rows[i] != null) {
+				totalChars += rows[i].length();
+			}
+		}
+
+		ByteBuffer buffer = ByteBuffer.allocate(totalChars * Character.BYTES).order(ByteOrder.nativeOrder());
+		CharBuffer chars = buffer.asCharBuffer();
+
+		for (int i = 0; i < rows.length; i++) {
+			if (rows[i] == null) {
+				lengths[i] = -1;
+			} else {
+				chars.put(rows[i]);
+				lengths[i] = rows[i].length() * Character.BYTES;
+			}
+		}
+
+		return new EncodedColumn(buffer.array(), lengths);
+	}
+
+	/**
+	 * Concatenates the values of a binary column
+	 */
+	protected static EncodedColumn encodeBinaries(byte[][] rows) {
+		int[] lengths = new int[rows.length];
+		int totalBytes = 0;
+
+		for (int i = 0; i < rows.length; i++) {
+			if (rows[i] != null) {
+				totalBytes += rows[i].length;
+			}
+		}
+
+		byte[] data = new byte[totalBytes];
+		int offset = 0;
+
+		for (int i = 0; i < rows.length; i++) {
+			if (rows[i] == null) {
+				lengths[i] = -1;
+			} else {
+				System.arraycopy(rows[i], 0, data, offset, rows[i].length);
+				lengths[i] = rows[i].length;
+				offset += rows[i].length;
+			}
+		}
+
+		return new EncodedColumn(data, lengths);
+	}
+
+	private static ByteBuffer grow(ByteBuffer buffer, int minAdditionalBytes) {
+		int capacity = Math.max(buffer.capacity() * 2, buffer.position() + minAdditionalBytes);
+		ByteBuffer grown = ByteBuffer.allocate(capacity);
+
+		buffer.flip();
+		grown.put(buffer);
+
+		return grown;
+	}
+
+	/**
+	 * Values of a string or binary column concatenated into one byte array, with the length in bytes
+	 * of each row, -1 for null rows. The array may be longer than the sum of the lengths.
+	 */
+	public static final class EncodedColumn {
+		public final byte[] data;
+		public final int[]  lengths;
+
+		public EncodedColumn(byte[] data, int[] lengths) {
+			this.data = data;
+			this.lengths = lengths;
+		}
+	}
 }
@@ -22,6 +22,23 @@ public abstract class AbstractSqlServerExtensionExecutor {
 		/* Default implementation of init() is no-op */
 	}
 
+	/**
+	 * Executes the user code for a batch of input rows.
+	 *
+	 * When the input is streamed, execute() is called once per batch and the objects passed in are
+	 * reused across the batches of the stream:
+	 * <ul>
+	 * <li>input is the same dataset object for every batch. The column arrays it returns, including
+	 * the null maps, are refilled in place by the next batch when it has the same number of rows,
+	 * so arrays or values needed beyond a call must be copied.</li>
+	 * <li>params is the same map object for every batch. Values put into it, such as output
+	 * parameters, are still present when the next batch is executed.</li>
+	 * </ul>
+	 *
+	 * @param input  dataset holding the input rows of the batch
+	 * @param params input and output parameters, keyed by parameter name
+	 * @return dataset holding the output rows of the batch
+	 */
 	public AbstractSqlServerExtensionDataset execute(AbstractSqlServerExtensionDataset input, LinkedHashMap<String, Object> params) {
 		throw new UnsupportedOperationException("AbstractSqlServerExtensionExecutor execute() is not implemented");
 	}
@@ -0,0 +1,432 @@
+package com.microsoft.sqlserver.javalangextension;
+
+import com.microsoft.sqlserver.javalangextension.PrimitiveDataset;
+import java.lang.IllegalArgumentException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.sql.Types;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * Implementation of PrimitiveDataset that exposes fixed width input columns (bit, tinyint, smallint,
+ * int, bigint, real and float) as direct ByteBuffers over the native column buffers, instead of copying
+ * them into Java arrays. All other column types are added as in PrimitiveDataset.
+ *
+ * The buffers point to memory owned by the extension and are only valid for the duration of the
+ * execute() call the dataset is passed to. Values of null rows are undefined, use isNull() to check.
+ *
+ * When used as the output dataset, fixed width columns can be created with createColumnBuffer() and
+ * written in place with the set methods. The extension returns those buffers to SQL Server without
+ * copying them.
+ */
+public class DirectBufferDataset extends PrimitiveDataset {
+	/* Size in bytes of the length/null indicator of each row */
+	private static final int NULL_INDICATOR_SIZE = 4;
+
+	/* Length/null indicator value of a null row */
+	private static final int SQL_NULL_DATA = -1;
+
+	Map<Integer, ByteBuffer> columnBuffers;
+	Map<Integer, ByteBuffer> columnNullBuffers;
+	Map<Integer, Integer>    columnRowCounts;
+	Set<Integer>             outputColumns;
+
+	public DirectBufferDataset() {
+		super();
+		columnBuffers = new HashMap<>();
+		columnNullBuffers = new HashMap<>();
+		columnRowCounts = new HashMap<>();
+		outputColumns = new HashSet<>();
+	}
+
+	/**
+	 * Adds a fixed width column backed by native memory. The data buffer holds rowCount values of the
+	 * column type, the null indicator buffer holds rowCount 4 byte indicators where -1 marks a null row.
+	 * Either buffer can be null: no data buffer for an empty column, no null indicator buffer when the
+	 * column has no null values.
+	 */
+	public void addColumnBuffer(int columnId, int rowCount, ByteBuffer data, ByteBuffer nullIndicators) {
+		checkColumnMetadata(columnId);
+		columnRowCounts.put(columnId, rowCount);
+
+		if (data != null) {
+			columnBuffers.put(columnId, data.asReadOnlyBuffer().order(ByteOrder.nativeOrder()));
+		}
+
+		if (nullIndicators != null) {
+			columnNullBuffers.put(columnId, nullIndicators.asReadOnlyBuffer().order(ByteOrder.nativeOrder()));
+		}
+	}
+
+	/**
+	 * Creates a writable fixed width column of rowCount rows for output. The column metadata must be
+	 * added first. All rows are initialized to zero and not null. Returns the data buffer, in native
+	 * byte order, with the value of each row at offset (row * size of the column type).
+	 */
+	public ByteBuffer createColumnBuffer(int columnId, int rowCount) {
+		checkColumnMetadata(columnId);
+
+		if (columnRowCounts.containsKey(columnId) || columns.containsKey(columnId)) {
+			throw new IllegalArgumentException("Data for column ID #: " + columnId + " already exists");
+		}
+
+		ByteBuffer data = ByteBuffer.allocateDirect(rowCount * getTypeSize(getColumnType(columnId)));
+		data.order(ByteOrder.nativeOrder());
+
+		columnRowCounts.put(columnId, rowCount);
+		columnBuffers.put(columnId, data);
+		outputColumns.add(columnId);
+
+		return data;
+	}
+
+	/**
+	 * Per row setters for columns created with createColumnBuffer()
+	 */
+	public void setNull(int columnId, int row) {
+		checkOutputColumn(columnId);
+
+		ByteBuffer nullBuffer = columnNullBuffers.get(columnId);
+		if (nullBuffer == null) {
+			nullBuffer = ByteBuffer.allocateDirect(getRowCount(columnId) * NULL_INDICATOR_SIZE);
+			nullBuffer.order(ByteOrder.nativeOrder());
+			columnNullBuffers.put(columnId, nullBuffer);
+		}
+
+		nullBuffer.putInt(row * NULL_INDICATOR_SIZE, SQL_NULL_DATA);
+	}
+
+	public void setBoolean(int columnId, int row, boolean value) {
+		checkOutputColumn(columnId);
+		getDataBuffer(columnId, Types.BIT).put(row, (byte)(value ? 1 : 0));
+	}
+
+	public void setShort(int columnId, int row, short value) {
+		checkOutputColumn(columnId);
+
+		if (getColumnType(columnId) == Types.TINYINT) {
+			getDataBuffer(columnId, Types.TINYINT).put(row, (byte)value);
+		} else {
+			getDataBuffer(columnId, Types.SMALLINT).putShort(row * Short.BYTES, value);
+		}
+	}
+
+	public void setInt(int columnId, int row, int value) {
+		checkOutputColumn(columnId);
+		getDataBuffer(columnId, Types.INTEGER).putInt(row * Integer.BYTES, value);
+	}
+
+	public void setLong(int columnId, int row, long value) {
+		checkOutputColumn(columnId);
+		getDataBuffer(columnId, Types.BIGINT).putLong(row * Long.BYTES, value);
+	}
+
+	public void setFloat(int columnId, int row, float value) {
+		checkOutputColumn(columnId);
+		getDataBuffer(columnId, Types.REAL).putFloat(row * Float.BYTES, value);
+	}
+
+	public void setDouble(int columnId, int row, double value) {
+		checkOutputColumn(columnId);
+		getDataBuffer(columnId, Types.DOUBLE).putDouble(row * Double.BYTES, value);
+	}
+
+	/**
+	 * Used by the extension to return output columns without copying. Returns null for columns that
+	 * were not created with createColumnBuffer().
+	 */
+	public ByteBuffer getOutputColumnBuffer(int columnId) {
+		checkColumnMetadata(columnId);
+		return outputColumns.contains(columnId) ? columnBuffers.get(columnId) : null;
+	}
+
+	public ByteBuffer getOutputColumnNullBuffer(int columnId) {
+		checkColumnMetadata(columnId);
+		return outputColumns.contains(columnId) ? columnNullBuffers.get(columnId) : null;
+	}
+
+	/**
+	 * Returns true if the column was added as a direct buffer
+	 */
+	public boolean isColumnBuffer(int columnId) {
+		checkColumnMetadata(columnId);
+		return columnRowCounts.containsKey(columnId);
+	}
+
+	public int getRowCount(int columnId) {
+		checkColumnBuffer(columnId);
+		return columnRowCounts.get(columnId).intValue();
+	}
+
+	/**
+	 * Number of rows of the columns added to the dataset, including direct buffer columns
+	 */
+	public int getRowCount() {
+		int rowCount = super.getRowCount();
+
+		if (rowCount == 0 && !columnRowCounts.isEmpty()) {
+			rowCount = columnRowCounts.values().iterator().next().intValue();
+		}
+
+		return rowCount;
+	}
+
+	/**
+	 * Per row accessors. Values are read directly from native memory without materializing the column.
+	 */
+	public boolean isNull(int columnId, int row) {
+		if (isColumnBuffer(columnId)) {
+			ByteBuffer nullBuffer = columnNullBuffers.get(columnId);
+			return nullBuffer != null && nullBuffer.getInt(row * NULL_INDICATOR_SIZE) == SQL_NULL_DATA;
+		}
+
+		return super.isNull(columnId, row);
+	}
+
+	public boolean getBoolean(int columnId, int row) {
+		return getDataBuffer(columnId, Types.BIT).get(row) != 0;
+	}
+
+	public short getShort(int columnId, int row) {
+		if (getColumnType(columnId) == Types.TINYINT) {
+			// tinyint is unsigned in SQL Server
+			//
+			return (short)(getDataBuffer(columnId, Types.TINYINT).get(row) & 0xFF);
+		}
+
+		return getDataBuffer(columnId, Types.SMALLINT).getShort(row * Short.BYTES);
+	}
+
+	public int getInt(int columnId, int row) {
+		return getDataBuffer(columnId, Types.INTEGER).getInt(row * Integer.BYTES);
+	}
+
+	public long getLong(int columnId, int row) {
+		return getDataBuffer(columnId, Types.BIGINT).getLong(row * Long.BYTES);
+	}
+
+	public float getFloat(int columnId, int row) {
+		return getDataBuffer(columnId, Types.REAL).getFloat(row * Float.BYTES);
+	}
+
+	public double getDouble(int columnId, int row) {
+		return getDataBuffer(columnId, Types.DOUBLE).getDouble(row * Double.BYTES);
+	}
+
+	/**
+	 * Whole column accessors. Direct buffer columns are copied into a new array on each call, with null
+	 * rows set to the default value of the type, so that the dataset can also be returned as output.
+	 */
+	public boolean[] getColumnNullMap(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getColumnNullMap(columnId);
+		}
+
+		ByteBuffer nullBuffer = columnNullBuffers.get(columnId);
+		if (nullBuffer == null) {
+			return null;
+		}
+
+		int rowCount = getRowCount(columnId);
+		boolean[] nullMap = new boolean[rowCount];
+		for (int row = 0; row < rowCount; ++row) {
+			nullMap[row] = nullBuffer.getInt(row * NULL_INDICATOR_SIZE) == SQL_NULL_DATA;
+		}
+
+		return nullMap;
+	}
+
+	public boolean[] getBooleanColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getBooleanColumn(columnId);
+		}
+
+		boolean[] rows = new boolean[getRowCount(columnId)];
+		for (int row = 0; row < rows.length; ++row) {
+			rows[row] = !isNull(columnId, row) && getBoolean(columnId, row);
+		}
+
+		return rows;
+	}
+
+	public short[] getShortColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getShortColumn(columnId);
+		}
+
+		short[] rows = new short[getRowCount(columnId)];
+		for (int row = 0; row < rows.length; ++row) {
+			rows[row] = isNull(columnId, row) ? 0 : getShort(columnId, row);
+		}
+
+		return rows;
+	}
+
+	public int[] getIntColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getIntColumn(columnId);
+		}
+
+		int[] rows = new int[getRowCount(columnId)];
+		if (rows.length > 0) {
+			getDataBuffer(columnId, Types.INTEGER).asIntBuffer().get(rows);
+			clearNullRows(columnId, rows);
+		}
+
+		return rows;
+	}
+
+	public long[] getLongColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getLongColumn(columnId);
+		}
+
+		long[] rows = new long[getRowCount(columnId)];
+		if (rows.length > 0) {
+			getDataBuffer(columnId, Types.BIGINT).asLongBuffer().get(rows);
+			clearNullRows(columnId, rows);
+		}
+
+		return rows;
+	}
+
+	public float[] getFloatColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getFloatColumn(columnId);
+		}
+
+		float[] rows = new float[getRowCount(columnId)];
+		if (rows.length > 0) {
+			getDataBuffer(columnId, Types.REAL).asFloatBuffer().get(rows);
+			clearNullRows(columnId, rows);
+		}
+
+		return rows;
+	}
+
+	public double[] getDoubleColumn(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			return super.getDoubleColumn(columnId);
+		}
+
+		double[] rows = new double[getRowCount(columnId)];
+		if (rows.length > 0) {
+			getDataBuffer(columnId, Types.DOUBLE).asDoubleBuffer().get(rows);
+			clearNullRows(columnId, rows);
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Direct buffer columns are copied into arrays, so that split() and concat() handle them like the
+	 * other columns and the copies stay valid after the execute() call
+	 */
+	Object getColumnData(int columnId) {
+		if (!columnRowCounts.containsKey(columnId)) {
+			return super.getColumnData(columnId);
+		}
+
+		switch (getColumnType(columnId)) {
+			case Types.BIT:
+				return getBooleanColumn(columnId);
+			case Types.TINYINT:
+			case Types.SMALLINT:
+				return getShortColumn(columnId);
+			case Types.INTEGER:
+				return getIntColumn(columnId);
+			case Types.BIGINT:
+				return getLongColumn(columnId);
+			case Types.REAL:
+				return getFloatColumn(columnId);
+			case Types.DOUBLE:
+				return getDoubleColumn(columnId);
+			default:
+				throw new IllegalArgumentException("java.sql.Types " + getColumnType(columnId) + " is not a fixed width type");
+		}
+	}
+
+	private void checkColumnBuffer(int columnId) {
+		if (!isColumnBuffer(columnId)) {
+			throw new IllegalArgumentException("Column ID #: " + columnId + " is not a direct buffer column");
+		}
+	}
+
+	private void checkOutputColumn(int columnId) {
+		checkColumnMetadata(columnId);
+
+		if (!outputColumns.contains(columnId)) {
+			throw new IllegalArgumentException("Column ID #: " + columnId + " was not created with createColumnBuffer()");
+		}
+	}
+
+	private static int getTypeSize(int sqlType) {
+		switch (sqlType) {
+			case Types.BIT:
+			case Types.TINYINT:
+				return Byte.BYTES;
+			case Types.SMALLINT:
+				return Short.BYTES;
+			case Types.INTEGER:
+				return Integer.BYTES;
+			case Types.REAL:
+				return Float.BYTES;
+			case Types.BIGINT:
+				return Long.BYTES;
+			case Types.DOUBLE:
+				return Double.BYTES;
+			default:
+				throw new IllegalArgumentException("java.sql.Types " + sqlType + " is not a fixed width type");
+		}
+	}
+
+	private ByteBuffer getDataBuffer(int columnId, int sqlType) {
+		checkColumnBuffer(columnId);
+
+		if (getColumnType(columnId) != sqlType) {
+			throw new IllegalArgumentException("Column ID #: " + columnId + " is not of java.sql.Types " + sqlType);
+		}
+
+		ByteBuffer data = columnBuffers.get(columnId);
+		if (data == null) {
+			throw new IndexOutOfBoundsException("Column ID #: " + columnId + " has no rows");
+		}
+
+		return data;
+	}
+
+	private void clearNullRows(int columnId, int[] rows) {
+		for (int row = 0; row < rows.length; ++row) {
+			if (isNull(columnId, row)) {
+				rows[row] = 0;
+			}
+		}
+	}
+
+	private void clearNullRows(int columnId, long[] rows) {
+		for (int row = 0; row < rows.length; ++row) {
+			if (isNull(columnId, row)) {
+				rows[row] = 0;
+			}
+		}
+	}
+
+	private void clearNullRows(int columnId, float[] rows) {
+		for (int row = 0; row < rows.length; ++row) {
+			if (isNull(columnId, row)) {
+				rows[row] = 0;
+			}
+		}
+	}
+
+	private void clearNullRows(int columnId, double[] rows) {
+		for (int row = 0; row < rows.length; ++row) {
+			if (isNull(columnId, row)) {
+				rows[row] = 0;
+			}
+		}
+	}
+}
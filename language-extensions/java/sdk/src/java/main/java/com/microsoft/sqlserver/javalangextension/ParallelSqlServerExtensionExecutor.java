@@ -0,0 +1,112 @@
+package com.microsoft.sqlserver.javalangextension;
+
+import com.microsoft.sqlserver.javalangextension.AbstractSqlServerExtensionDataset;
+import com.microsoft.sqlserver.javalangextension.PrimitiveDataset;
+import java.lang.IllegalArgumentException;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+
+/**
+ * Executor splitting the rows of a PrimitiveDataset input into ranges, running executePartition()
+ * for each range on a ForkJoinPool and concatenating the output datasets of the ranges in row order.
+ * The output datasets of all ranges must have the same columns.
+ *
+ * The number of ranges run in parallel is the value of the reserved "parallelism" parameter, or the
+ * number of available processors if the parameter is not set. Inputs with fewer rows than
+ * minPartitionRowCount per range are split into fewer ranges, and are not split at all when only one
+ * range remains. The pool is created for each execute() call and shut down before it returns, so no
+ * threads are left behind between streamed batches or after the session.
+ */
+public abstract class ParallelSqlServerExtensionExecutor extends AbstractSqlServerExtensionExecutor {
+	/* Reserved parameter setting the number of ranges run in parallel */
+	public static final String PARALLELISM_PARAM_NAME = "parallelism";
+
+	/* Minimum number of rows of each range */
+	protected int minPartitionRowCount = 1024;
+
+	public ParallelSqlServerExtensionExecutor() {
+		executorExtensionVersion = SQLSERVER_JAVA_LANG_EXTENSION_V1;
+		executorInputDatasetClassName = PrimitiveDataset.class.getName();
+		executorOutputDatasetClassName = PrimitiveDataset.class.getName();
+	}
+
+	/*
+	 * Executes one range of rows of the input. It is called concurrently for different ranges, so
+	 * it must not modify state shared between ranges, including the params map. The partition
+	 * dataset holds a copy of its rows, including the direct buffer columns of a DirectBufferDataset
+	 * input, unless the input is not split, in which case it is the input dataset itself.
+	 */
+	protected abstract PrimitiveDataset executePartition(PrimitiveDataset partition, LinkedHashMap<String, Object> params);
+
+	public AbstractSqlServerExtensionDataset execute(AbstractSqlServerExtensionDataset input, LinkedHashMap<String, Object> params) {
+		if (!(input instanceof PrimitiveDataset)) {
+			throw new IllegalArgumentException("ParallelSqlServerExtensionExecutor requires a PrimitiveDataset input");
+		}
+
+		PrimitiveDataset dataset = (PrimitiveDataset)input;
+		int parallelism = getParallelism(params);
+		int numPartitions = Math.min(parallelism, dataset.getRowCount() / Math.max(1, minPartitionRowCount));
+
+		if (numPartitions <= 1) {
+			return executePartition(dataset, params);
+		}
+
+		List<Callable<PrimitiveDataset>> tasks = new ArrayList<>(numPartitions);
+		for (PrimitiveDataset partition : dataset.split(numPartitions)) {
+			tasks.add(() -> executePartition(partition, params));
+		}
+
+		ForkJoinPool pool = new ForkJoinPool(parallelism);
+
+		try {
+			List<PrimitiveDataset> outputs = new ArrayList<>(numPartitions);
+			for (Future<PrimitiveDataset> future : pool.invokeAll(tasks)) {
+				outputs.add(getPartitionOutput(future));
+			}
+
+			return PrimitiveDataset.concat(outputs);
+		} finally {
+			pool.shutdown();
+		}
+	}
+
+	protected int getParallelism(LinkedHashMap<String, Object> params) {
+		Object value = params == null ? null : params.get(PARALLELISM_PARAM_NAME);
+
+		if (value == null) {
+			return Runtime.getRuntime().availableProcessors();
+		}
+
+		int parallelism = value instanceof Number ? ((Number)value).intValue() : Integer.parseInt(value.toString().trim());
+
+		if (parallelism < 1) {
+			throw new IllegalArgumentException("Invalid value for parameter " + PARALLELISM_PARAM_NAME + ": " + parallelism);
+		}
+
+		return parallelism;
+	}
+
+	private static PrimitiveDataset getPartitionOutput(Future<PrimitiveDataset> future) {
+		try {
+			return future.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new IllegalStateException("Interrupted while executing partitions", e);
+		} catch (ExecutionException e) {
+			Throwable cause = e.getCause();
+
+			if (cause instanceof RuntimeException) {
+				throw (RuntimeException)cause;
+			} else if (cause instanceof Error) {
+				throw (Error)cause;
+			}
+
+			throw new IllegalStateException(cause);
+		}
+	}
+}
@@ -2,12 +2,19 @@ package com.microsoft.sqlserver.javalangextension;
 
 import com.microsoft.sqlserver.javalangextension.AbstractSqlServerExtensionDataset;
 import java.lang.IllegalArgumentException;
+import java.lang.reflect.Array;
 import java.math.BigDecimal;
 import java.sql.Date;
 import java.sql.Timestamp;
+import java.time.LocalDate;
+import java.time.LocalDateTime;
+import java.time.ZoneOffset;
+import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
-import java.util.Map.Entry;
+import java.util.UUID;
 
 /**
  * Implementation of AbstractSqlServerExtensionDataset that stores
@@ -20,6 +27,7 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 	Map<Integer, Integer>   columnScales;
 	Map<Integer, Object>    columns;
 	Map<Integer, boolean[]> columnNullMaps;
+	Map<Integer, NullBitmap> columnNullBitmaps;
 
 	public PrimitiveDataset() {
 		columnTypes = new HashMap<>();
@@ -28,6 +36,7 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 		columnScales = new HashMap<>();
 		columns = new HashMap<>();
 		columnNullMaps = new HashMap<>();
+		columnNullBitmaps = new HashMap<>();
 	}
 
 	/**
@@ -71,9 +80,59 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 
 	public boolean[] getColumnNullMap(int columnId) {
 		checkColumnMetadata(columnId);
+		NullBitmap nullBitmap = columnNullBitmaps.remove(columnId);
+
+		if (nullBitmap != null) {
+			columnNullMaps.put(columnId, nullBitmap.toNullMap());
+		}
+
 		return columnNullMaps.get(columnId);
 	}
 
+	/**
+	 * Null bitmap interfaces. Bit (row % 64) of element (row / 64) is set for null rows, which is the
+	 * layout of java.util.BitSet.toLongArray(). The extension sets the null rows of input columns this
+	 * way, and getColumnNullMap() expands the bitmap into a boolean array the first time it is called
+	 * for the column. A null bitmap indicates that there are no null values in that column.
+	 */
+	public void setColumnNullBitmap(int columnId, int rowCount, long[] nullBitmap) {
+		checkColumnMetadata(columnId);
+		columnNullMaps.remove(columnId);
+
+		if (nullBitmap != null) {
+			if (nullBitmap.length != (rowCount + 63) / 64) {
+				throw new IllegalArgumentException("Null bitmap of column ID #: " + columnId + " does not have " + rowCount + " rows");
+			}
+
+			columnNullBitmaps.put(columnId, new NullBitmap(rowCount, nullBitmap));
+		} else {
+			columnNullBitmaps.remove(columnId);
+		}
+	}
+
+	public long[] getColumnNullBitmap(int columnId) {
+		checkColumnMetadata(columnId);
+		NullBitmap nullBitmap = columnNullBitmaps.get(columnId);
+
+		if (nullBitmap != null) {
+			return nullBitmap.bits;
+		}
+
+		return toNullBitmap(getColumnNullMap(columnId));
+	}
+
+	public boolean isNull(int columnId, int row) {
+		checkColumnMetadata(columnId);
+		NullBitmap nullBitmap = columnNullBitmaps.get(columnId);
+
+		if (nullBitmap != null) {
+			return nullBitmap.isNull(row);
+		}
+
+		boolean[] nullMap = columnNullMaps.get(columnId);
+		return nullMap != null && nullMap[row];
+	}
+
 	/**
 	 * Adding column data interfaces. Column data is stored in a hash map, using the column ID as the key and
 	 * an array of the corresponding type representing each row. Primitives cannot be null, thus null values
@@ -83,37 +142,37 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 	public void addIntColumn(int columnId, int[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	}
 
 	public void addBooleanColumn(int columnId, boolean[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	};
 
 	public void addLongColumn(int columnId, long[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	}
 
 	public void addFloatColumn(int columnId, float[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	}
 
 	public void addDoubleColumn(int columnId, double[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	}
 
 	public void addShortColumn(int columnId, short[] rows, boolean[] nullMap) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
-		columnNullMaps.put(columnId, nullMap);
+		putColumnNullMap(columnId, nullMap);
 	}
 
 	public void addStringColumn(int columnId, String[] rows) {
@@ -121,11 +180,82 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 		columns.put(columnId, rows);
 	}
 
+	/**
+	 * UTF-8 string columns are kept as received and only decoded the first time
+	 * getStringColumn() is called for the column.
+	 */
+	public void addStringColumn(int columnId, byte[] data, int[] lengths) {
+		checkColumnMetadata(columnId);
+		columns.put(columnId, new Utf8StringColumn(data, lengths));
+	}
+
+	/**
+	 * Numeric columns added as unscaled values are kept as received. getUnscaledNumericColumn() returns
+	 * them as is, for executors doing their own fixed point arithmetic, and getNumericColumn() creates
+	 * the BigDecimal instances the first time it is called for the column. The scale must be the scale
+	 * of the column metadata.
+	 */
+	public void addNumericColumn(int columnId, long[] unscaledValues, int scale, boolean[] nullMap) {
+		checkColumnMetadata(columnId);
+
+		if (scale != columnScales.get(columnId).intValue()) {
+			throw new IllegalArgumentException("Scale " + scale + " does not match the scale of column ID #: " + columnId);
+		}
+
+		columns.put(columnId, new UnscaledNumericColumn(unscaledValues, scale));
+		putColumnNullMap(columnId, nullMap);
+	}
+
+	/**
+	 * Date and timestamp columns added as epoch values are kept as received. getEpochDayColumn(),
+	 * getEpochSecondColumn() and getNanosColumn() return them as is, and getDateColumn() or
+	 * getTimestampColumn() create the java.sql instances the first time they are called for the column.
+	 */
+	public void addDateColumn(int columnId, long[] epochDays, boolean[] nullMap) {
+		checkColumnMetadata(columnId);
+		columns.put(columnId, new EpochDateColumn(epochDays));
+		putColumnNullMap(columnId, nullMap);
+	}
+
+	public void addTimestampColumn(int columnId, long[] epochSeconds, int[] nanos, boolean[] nullMap) {
+		checkColumnMetadata(columnId);
+
+		if (epochSeconds.length != nanos.length) {
+			throw new IllegalArgumentException("Number of seconds and nanoseconds of column ID #: " + columnId + " differ");
+		}
+
+		columns.put(columnId, new EpochTimestampColumn(epochSeconds, nanos));
+		putColumnNullMap(columnId, nullMap);
+	}
+
 	public void addBinaryColumn(int columnId, byte[][] rows) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
 	}
 
+	/**
+	 * Binary columns added as one byte array with the offset of each row, and uniqueidentifier
+	 * columns added as the bits of each GUID, are kept as received. getBinaryColumn() and
+	 * getStringColumn() create the arrays or strings of the rows the first time they are called
+	 * for the column.
+	 */
+	public void addBinaryColumn(int columnId, byte[] data, int[] offsets, boolean[] nullMap) {
+		checkColumnMetadata(columnId);
+		columns.put(columnId, new OffsetBinaryColumn(data, offsets));
+		putColumnNullMap(columnId, nullMap);
+	}
+
+	public void addGuidColumn(int columnId, long[] mostSigBits, long[] leastSigBits, boolean[] nullMap) {
+		checkColumnMetadata(columnId);
+
+		if (mostSigBits.length != leastSigBits.length) {
+			throw new IllegalArgumentException("Number of most and least significant bits of column ID #: " + columnId + " differ");
+		}
+
+		columns.put(columnId, new GuidColumn(mostSigBits, leastSigBits));
+		putColumnNullMap(columnId, nullMap);
+	}
+
 	public void addDateColumn(int columnId, Date[] rows) {
 		checkColumnMetadata(columnId);
 		columns.put(columnId, rows);
@@ -177,33 +307,808 @@ public class PrimitiveDataset extends AbstractSqlServerExtensionDataset {
 
 	public String[] getStringColumn(int columnId) {
 		checkColumnMetadata(columnId);
-		return (String[])columns.get(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof Utf8StringColumn) {
+			Utf8StringColumn utf8Column = (Utf8StringColumn)column;
+			column = decodeUtf8Strings(utf8Column.data, utf8Column.lengths);
+			columns.put(columnId, column);
+		} else if (column instanceof GuidColumn) {
+			GuidColumn guidColumn = (GuidColumn)column;
+			column = toGuidStrings(guidColumn.mostSigBits, guidColumn.leastSigBits, getColumnNullMap(columnId));
+			columns.put(columnId, column);
+		}
+
+		return (String[])column;
 	}
 
 	public byte[][] getBinaryColumn(int columnId) {
 		checkColumnMetadata(columnId);
-		return (byte[][])columns.get(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof OffsetBinaryColumn) {
+			OffsetBinaryColumn binaryColumn = (OffsetBinaryColumn)column;
+			column = toBinaries(binaryColumn.data, binaryColumn.offsets, getColumnNullMap(columnId));
+			columns.put(columnId, column);
+		}
+
+		return (byte[][])column;
+	}
+
+	/**
+	 * Returns a uniqueidentifier column as java.util.UUID instances, with null for null rows
+	 */
+	public UUID[] getUuidColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof GuidColumn) {
+			GuidColumn guidColumn = (GuidColumn)column;
+			boolean[] nullMap = getColumnNullMap(columnId);
+			UUID[] rows = new UUID[guidColumn.mostSigBits.length];
+
+			for (int i = 0; i < rows.length; i++) {
+				if (nullMap == null || !nullMap[i]) {
+					rows[i] = new UUID(guidColumn.mostSigBits[i], guidColumn.leastSigBits[i]);
+				}
+			}
+
+			return rows;
+		}
+
+		String[] strings = getStringColumn(columnId);
+		if (strings == null) {
+			return null;
+		}
+
+		UUID[] rows = new UUID[strings.length];
+		for (int i = 0; i < strings.length; i++) {
+			if (strings[i] != null) {
+				rows[i] = UUID.fromString(strings[i]);
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * GUID bits and binary offset accessors return the columns as received, or null once the column
+	 * has been retrieved with getStringColumn() or getBinaryColumn(), so that changes made to the
+	 * returned array are not ignored when the dataset is returned as output.
+	 */
+	public long[] getGuidMostSigBitsColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof GuidColumn ? ((GuidColumn)column).mostSigBits : null;
+	}
+
+	public long[] getGuidLeastSigBitsColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof GuidColumn ? ((GuidColumn)column).leastSigBits : null;
+	}
+
+	public byte[] getBinaryDataColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof OffsetBinaryColumn ? ((OffsetBinaryColumn)column).data : null;
+	}
+
+	public int[] getBinaryOffsetsColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof OffsetBinaryColumn ? ((OffsetBinaryColumn)column).offsets : null;
+	}
+
+	/**
+	 * Binary columns that have not been split into rows are returned as received when the rows are
+	 * contiguous, without copying them into one array per row and back.
+	 */
+	public EncodedColumn getEncodedBinaryColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof OffsetBinaryColumn) {
+			OffsetBinaryColumn binaryColumn = (OffsetBinaryColumn)column;
+			boolean[] nullMap = getColumnNullMap(columnId);
+			int[] lengths = new int[binaryColumn.offsets.length - 1];
+			boolean isContiguous = binaryColumn.offsets[0] == 0;
+
+			for (int i = 0; i < lengths.length; i++) {
+				int length = binaryColumn.offsets[i + 1] - binaryColumn.offsets[i];
+				boolean isNullRow = nullMap != null && nullMap[i];
+
+				lengths[i] = isNullRow ? -1 : length;
+				isContiguous &= !isNullRow || length == 0;
+			}
+
+			if (isContiguous) {
+				return new EncodedColumn(binaryColumn.data, lengths);
+			}
+		}
+
+		return super.getEncodedBinaryColumn(columnId);
+	}
+
+	/**
+	 * UTF-8 string columns that have not been decoded are returned as received, without encoding them
+	 * again.
+	 */
+	public EncodedColumn getEncodedStringColumn(int columnId, boolean isUtf8) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (isUtf8 && column instanceof Utf8StringColumn) {
+			Utf8StringColumn utf8Column = (Utf8StringColumn)column;
+			return new EncodedColumn(utf8Column.data, utf8Column.lengths);
+		}
+
+		return super.getEncodedStringColumn(columnId, isUtf8);
 	}
 
 	public Date[] getDateColumn(int columnId) {
 		checkColumnMetadata(columnId);
-		return (Date[])columns.get(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof EpochDateColumn) {
+			column = toDates(((EpochDateColumn)column).days, getColumnNullMap(columnId));
+			columns.put(columnId, column);
+		}
+
+		return (Date[])column;
 	}
 
 	public BigDecimal[] getNumericColumn(int columnId) {
 		checkColumnMetadata(columnId);
-		return (BigDecimal[])columns.get(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof UnscaledNumericColumn) {
+			UnscaledNumericColumn unscaledColumn = (UnscaledNumericColumn)column;
+			column = toBigDecimals(unscaledColumn.values, unscaledColumn.scale, getColumnNullMap(columnId));
+			columns.put(columnId, column);
+		}
+
+		return (BigDecimal[])column;
+	}
+
+	/**
+	 * Returns null once the column has been retrieved with getNumericColumn(), so that changes made to
+	 * the returned BigDecimal array are not ignored when the dataset is returned as output.
+	 */
+	public long[] getUnscaledNumericColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof UnscaledNumericColumn) {
+			return ((UnscaledNumericColumn)column).values;
+		}
+
+		return null;
 	}
 
 	public Timestamp[] getTimestampColumn(int columnId) {
 		checkColumnMetadata(columnId);
-		return (Timestamp[])columns.get(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof EpochTimestampColumn) {
+			EpochTimestampColumn epochColumn = (EpochTimestampColumn)column;
+			column = toTimestamps(epochColumn.seconds, epochColumn.nanos, getColumnNullMap(columnId));
+			columns.put(columnId, column);
+		}
+
+		return (Timestamp[])column;
+	}
+
+	/**
+	 * Epoch accessors return null once the column has been retrieved with getDateColumn() or
+	 * getTimestampColumn(), so that changes made to the returned array are not ignored when the
+	 * dataset is returned as output.
+	 */
+	public long[] getEpochDayColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof EpochDateColumn ? ((EpochDateColumn)column).days : null;
+	}
+
+	public long[] getEpochSecondColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof EpochTimestampColumn ? ((EpochTimestampColumn)column).seconds : null;
+	}
+
+	public int[] getNanosColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+		return column instanceof EpochTimestampColumn ? ((EpochTimestampColumn)column).nanos : null;
+	}
+
+	/**
+	 * java.time accessors for date and timestamp columns, with null for null rows
+	 */
+	public LocalDate[] getLocalDateColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof EpochDateColumn) {
+			long[] days = ((EpochDateColumn)column).days;
+			boolean[] nullMap = getColumnNullMap(columnId);
+			LocalDate[] rows = new LocalDate[days.length];
+
+			for (int i = 0; i < days.length; i++) {
+				if (nullMap == null || !nullMap[i]) {
+					rows[i] = LocalDate.ofEpochDay(days[i]);
+				}
+			}
+
+			return rows;
+		}
+
+		Date[] dates = (Date[])column;
+		if (dates == null) {
+			return null;
+		}
+
+		LocalDate[] rows = new LocalDate[dates.length];
+		for (int i = 0; i < dates.length; i++) {
+			if (dates[i] != null) {
+				rows[i] = dates[i].toLocalDate();
+			}
+		}
+
+		return rows;
+	}
+
+	public LocalDateTime[] getLocalDateTimeColumn(int columnId) {
+		checkColumnMetadata(columnId);
+		Object column = columns.get(columnId);
+
+		if (column instanceof EpochTimestampColumn) {
+			EpochTimestampColumn epochColumn = (EpochTimestampColumn)column;
+			boolean[] nullMap = getColumnNullMap(columnId);
+			LocalDateTime[] rows = new LocalDateTime[epochColumn.seconds.length];
+
+			for (int i = 0; i < rows.length; i++) {
+				if (nullMap == null || !nullMap[i]) {
+					rows[i] = LocalDateTime.ofEpochSecond(epochColumn.seconds[i], epochColumn.nanos[i], ZoneOffset.UTC);
+				}
+			}
+
+			return rows;
+		}
+
+		Timestamp[] timestamps = (Timestamp[])column;
+		if (timestamps == null) {
+			return null;
+		}
+
+		LocalDateTime[] rows = new LocalDateTime[timestamps.length];
+		for (int i = 0; i < timestamps.length; i++) {
+			if (timestamps[i] != null) {
+				rows[i] = timestamps[i].toLocalDateTime();
+			}
+		}
+
+		return rows;
+	}
+
+	/**
+	 * Number of rows of the columns added to the dataset, 0 if no column has been added
+	 */
+	public int getRowCount() {
+		for (Object column : columns.values()) {
+			if (column != null) {
+				return getColumnLength(column);
+			}
+		}
+
+		return 0;
+	}
+
+	/**
+	 * Splits the rows into numPartitions consecutive ranges of almost equal size, each copied into a
+	 * dataset with the same column metadata. Columns keep their representation, so primitive,
+	 * UTF-8, epoch and unscaled columns are copied without creating an object per row. Columns a
+	 * subclass stores outside of the column arrays are copied as returned by getColumnData().
+	 */
+	public List<PrimitiveDataset> split(int numPartitions) {
+		int rowCount = getRowCount();
+		int[] firstRows = new int[numPartitions + 1];
+		List<PrimitiveDataset> partitions = new ArrayList<>(numPartitions);
+
+		for (int i = 0; i < numPartitions; i++) {
+			firstRows[i + 1] = (int)((long)rowCount * (i + 1) / numPartitions);
+			partitions.add(copyMetadata());
+		}
+
+		for (Integer columnId : columnTypes.keySet()) {
+			Object column = getColumnData(columnId);
+
+			if (column == null) {
+				continue;
+			}
+
+			boolean[] nullMap = getColumnNullMap(columnId);
+			int dataOffset = 0;
+
+			for (int i = 0; i < numPartitions; i++) {
+				int from = firstRows[i];
+				int to = firstRows[i + 1];
+				Object rows = null;
+
+				if (column instanceof Utf8StringColumn) {
+					Utf8StringColumn utf8Column = (Utf8StringColumn)column;
+					int[] lengths = Arrays.copyOfRange(utf8Column.lengths, from, to);
+					int dataLength = getDataLength(lengths);
+
+					rows = new Utf8StringColumn(Arrays.copyOfRange(utf8Column.data, dataOffset, dataOffset + dataLength), lengths);
+					dataOffset += dataLength;
+				} else if (column instanceof EpochDateColumn) {
+					rows = new EpochDateColumn(Arrays.copyOfRange(((EpochDateColumn)column).days, from, to));
+				} else if (column instanceof EpochTimestampColumn) {
+					EpochTimestampColumn epochColumn = (EpochTimestampColumn)column;
+					rows = new EpochTimestampColumn(Arrays.copyOfRange(epochColumn.seconds, from, to),
+						Arrays.copyOfRange(epochColumn.nanos, from, to));
+				} else if (column instanceof UnscaledNumericColumn) {
+					UnscaledNumericColumn unscaledColumn = (UnscaledNumericColumn)column;
+					rows = new UnscaledNumericColumn(Arrays.copyOfRange(unscaledColumn.values, from, to), unscaledColumn.scale);
+				} else if (column instanceof GuidColumn) {
+					GuidColumn guidColumn = (GuidColumn)column;
+					rows = new GuidColumn(Arrays.copyOfRange(guidColumn.mostSigBits, from, to),
+						Arrays.copyOfRange(guidColumn.leastSigBits, from, to));
+				} else if (column instanceof OffsetBinaryColumn) {
+					OffsetBinaryColumn binaryColumn = (OffsetBinaryColumn)column;
+					int[] offsets = Arrays.copyOfRange(binaryColumn.offsets, from, to + 1);
+
+					for (int row = offsets.length - 1; row >= 0; row--) {
+						offsets[row] -= offsets[0];
+					}
+
+					rows = new OffsetBinaryColumn(Arrays.copyOfRange(binaryColumn.data, binaryColumn.offsets[from],
+						binaryColumn.offsets[to]), offsets);
+				} else {
+					rows = Array.newInstance(column.getClass().getComponentType(), to - from);
+					System.arraycopy(column, from, rows, 0, to - from);
+				}
+
+				PrimitiveDataset partition = partitions.get(i);
+				partition.columns.put(columnId, rows);
+				partition.columnNullMaps.put(columnId, nullMap == null ? null : Arrays.copyOfRange(nullMap, from, to));
+			}
+		}
+
+		return partitions;
+	}
+
+	/**
+	 * Concatenates the rows of datasets with the same column metadata, in order. Columns that have the
+	 * same representation in all datasets keep it, so primitive, UTF-8, epoch and unscaled columns are
+	 * concatenated without creating an object per row. Columns that do not are converted to the
+	 * object array returned by their getter first. The result is always a new dataset, also for a
+	 * single dataset, so it does not share column arrays with the datasets.
+	 */
+	public static PrimitiveDataset concat(List<PrimitiveDataset> datasets) {
+		if (datasets == null || datasets.isEmpty()) {
+			throw new IllegalArgumentException("No datasets to concatenate");
+		}
+
+		PrimitiveDataset first = datasets.get(0);
+		PrimitiveDataset result = first.copyMetadata();
+
+		for (PrimitiveDataset dataset : datasets) {
+			if (!dataset.columnTypes.equals(first.columnTypes)) {
+				throw new IllegalArgumentException("Datasets to concatenate do not have the same columns");
+			}
+		}
+
+		for (Integer columnId : first.columnTypes.keySet()) {
+			Object[] columnParts = new Object[datasets.size()];
+			Class<?> representation = null;
+			boolean sameRepresentation = true;
+
+			for (int i = 0; i < columnParts.length; i++) {
+				columnParts[i] = datasets.get(i).getColumnData(columnId);
+
+				if (columnParts[i] != null) {
+					if (representation == null) {
+						representation = columnParts[i].getClass();
+					} else if (representation != columnParts[i].getClass()) {
+						sameRepresentation = false;
+					}
+				}
+			}
+
+			if (representation == null) {
+				continue;
+			}
+
+			if (!sameRepresentation) {
+				for (int i = 0; i < columnParts.length; i++) {
+					columnParts[i] = datasets.get(i).getColumnRows(columnId);
+				}
+			}
+
+			result.columns.put(columnId, concatColumns(columnParts));
+			result.columnNullMaps.put(columnId, concatNullMaps(datasets, columnId, columnParts));
+		}
+
+		return result;
+	}
+
+	private PrimitiveDataset copyMetadata() {
+		PrimitiveDataset dataset = new PrimitiveDataset();
+
+		dataset.columnTypes.putAll(columnTypes);
+		dataset.columnNames.putAll(columnNames);
+		dataset.columnPrecisions.putAll(columnPrecisions);
+		dataset.columnScales.putAll(columnScales);
+
+		return dataset;
 	}
 
-	private void checkColumnMetadata(int columnId)
+	/**
+	 * Returns the stored rows of a column, null if the column has no data. Subclasses that store
+	 * columns outside of the column arrays return them in one of the representations of this class.
+	 */
+	Object getColumnData(int columnId) {
+		return columns.get(columnId);
+	}
+
+	/**
+	 * Returns the rows of a column as the object array of its getter when the column is stored in
+	 * another representation
+	 */
+	private Object getColumnRows(int columnId) {
+		Object column = getColumnData(columnId);
+
+		if (column instanceof Utf8StringColumn) {
+			return getStringColumn(columnId);
+		} else if (column instanceof EpochDateColumn) {
+			return getDateColumn(columnId);
+		} else if (column instanceof EpochTimestampColumn) {
+			return getTimestampColumn(columnId);
+		} else if (column instanceof UnscaledNumericColumn) {
+			return getNumericColumn(columnId);
+		} else if (column instanceof GuidColumn) {
+			return getStringColumn(columnId);
+		} else if (column instanceof OffsetBinaryColumn) {
+			return getBinaryColumn(columnId);
+		}
+
+		return column;
+	}
+
+	private static Object concatColumns(Object[] columnParts) {
+		int rowCount = 0;
+		Object first = null;
+
+		for (Object part : columnParts) {
+			if (part != null) {
+				rowCount += getColumnLength(part);
+				first = first == null ? part : first;
+			}
+		}
+
+		if (first instanceof Utf8StringColumn) {
+			int[] lengths = new int[rowCount];
+			int dataLength = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					dataLength += getDataLength(((Utf8StringColumn)part).lengths);
+				}
+			}
+
+			byte[] data = new byte[dataLength];
+			int row = 0;
+			int dataOffset = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					Utf8StringColumn utf8Column = (Utf8StringColumn)part;
+					int partDataLength = getDataLength(utf8Column.lengths);
+
+					System.arraycopy(utf8Column.lengths, 0, lengths, row, utf8Column.lengths.length);
+					System.arraycopy(utf8Column.data, 0, data, dataOffset, partDataLength);
+					row += utf8Column.lengths.length;
+					dataOffset += partDataLength;
+				}
+			}
+
+			return new Utf8StringColumn(data, lengths);
+		} else if (first instanceof EpochDateColumn) {
+			long[] days = new long[rowCount];
+			int row = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					long[] partDays = ((EpochDateColumn)part).days;
+					System.arraycopy(partDays, 0, days, row, partDays.length);
+					row += partDays.length;
+				}
+			}
+
+			return new EpochDateColumn(days);
+		} else if (first instanceof EpochTimestampColumn) {
+			long[] seconds = new long[rowCount];
+			int[] nanos = new int[rowCount];
+			int row = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					EpochTimestampColumn epochColumn = (EpochTimestampColumn)part;
+					System.arraycopy(epochColumn.seconds, 0, seconds, row, epochColumn.seconds.length);
+					System.arraycopy(epochColumn.nanos, 0, nanos, row, epochColumn.nanos.length);
+					row += epochColumn.seconds.length;
+				}
+			}
+
+			return new EpochTimestampColumn(seconds, nanos);
+		} else if (first instanceof UnscaledNumericColumn) {
+			long[] values = new long[rowCount];
+			int row = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					long[] partValues = ((UnscaledNumericColumn)part).values;
+					System.arraycopy(partValues, 0, values, row, partValues.length);
+					row += partValues.length;
+				}
+			}
+
+			return new UnscaledNumericColumn(values, ((UnscaledNumericColumn)first).scale);
+		} else if (first instanceof GuidColumn) {
+			long[] mostSigBits = new long[rowCount];
+			long[] leastSigBits = new long[rowCount];
+			int row = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					GuidColumn guidColumn = (GuidColumn)part;
+					System.arraycopy(guidColumn.mostSigBits, 0, mostSigBits, row, guidColumn.mostSigBits.length);
+					System.arraycopy(guidColumn.leastSigBits, 0, leastSigBits, row, guidColumn.leastSigBits.length);
+					row += guidColumn.mostSigBits.length;
+				}
+			}
+
+			return new GuidColumn(mostSigBits, leastSigBits);
+		} else if (first instanceof OffsetBinaryColumn) {
+			int[] offsets = new int[rowCount + 1];
+			int dataLength = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					int[] partOffsets = ((OffsetBinaryColumn)part).offsets;
+					dataLength += partOffsets[partOffsets.length - 1] - partOffsets[0];
+				}
+			}
+
+			byte[] data = new byte[dataLength];
+			int row = 0;
+
+			for (Object part : columnParts) {
+				if (part != null) {
+					OffsetBinaryColumn binaryColumn = (OffsetBinaryColumn)part;
+					int[] partOffsets = binaryColumn.offsets;
+					int partRows = partOffsets.length - 1;
+					int partStart = partOffsets[0];
+					int dataOffset = offsets[row];
+
+					System.arraycopy(binaryColumn.data, partStart, data, dataOffset, partOffsets[partRows] - partStart);
+
+					for (int i = 1; i <= partRows; i++) {
+						offsets[row + i] = dataOffset + partOffsets[i] - partStart;
+					}
+
+					row += partRows;
+				}
+			}
+
+			return new OffsetBinaryColumn(data, offsets);
+		}
+
+		Object rows = Array.newInstance(first.getClass().getComponentType(), rowCount);
+		int row = 0;
+
+		for (Object part : columnParts) {
+			if (part != null) {
+				int partLength = Array.getLength(part);
+				System.arraycopy(part, 0, rows, row, partLength);
+				row += partLength;
+			}
+		}
+
+		return rows;
+	}
+
+	private static boolean[] concatNullMaps(List<PrimitiveDataset> datasets, int columnId, Object[] columnParts) {
+		boolean[][] nullMaps = new boolean[datasets.size()][];
+		boolean hasNullMap = false;
+		int rowCount = 0;
+
+		for (int i = 0; i < nullMaps.length; i++) {
+			nullMaps[i] = datasets.get(i).getColumnNullMap(columnId);
+			hasNullMap |= nullMaps[i] != null;
+			rowCount += columnParts[i] == null ? 0 : getColumnLength(columnParts[i]);
+		}
+
+		if (!hasNullMap) {
+			return null;
+		}
+
+		boolean[] nullMap = new boolean[rowCount];
+		int row = 0;
+
+		for (int i = 0; i < nullMaps.length; i++) {
+			int partLength = columnParts[i] == null ? 0 : getColumnLength(columnParts[i]);
+
+			if (nullMaps[i] != null) {
+				System.arraycopy(nullMaps[i], 0, nullMap, row, partLength);
+			}
+
+			row += partLength;
+		}
+
+		return nullMap;
+	}
+
+	private static int getColumnLength(Object column) {
+		if (column instanceof Utf8StringColumn) {
+			return ((Utf8StringColumn)column).lengths.length;
+		} else if (column instanceof EpochDateColumn) {
+			return ((EpochDateColumn)column).days.length;
+		} else if (column instanceof EpochTimestampColumn) {
+			return ((EpochTimestampColumn)column).seconds.length;
+		} else if (column instanceof UnscaledNumericColumn) {
+			return ((UnscaledNumericColumn)column).values.length;
+		} else if (column instanceof GuidColumn) {
+			return ((GuidColumn)column).mostSigBits.length;
+		} else if (column instanceof OffsetBinaryColumn) {
+			return ((OffsetBinaryColumn)column).offsets.length - 1;
+		}
+
+		return Array.getLength(column);
+	}
+
+	private static int getDataLength(int[] lengths) {
+		int dataLength = 0;
+
+		for (int length : lengths) {
+			dataLength += Math.max(length, 0);
+		}
+
+		return dataLength;
+	}
+
+	private void putColumnNullMap(int columnId, boolean[] nullMap) {
+		columnNullMaps.put(columnId, nullMap);
+		columnNullBitmaps.remove(columnId);
+	}
+
+	private static long[] toNullBitmap(boolean[] nullMap) {
+		if (nullMap == null) {
+			return null;
+		}
+
+		long[] bits = new long[(nullMap.length + 63) / 64];
+		boolean hasNull = false;
+
+		for (int i = 0; i < nullMap.length; i++) {
+			if (nullMap[i]) {
+				bits[i >>> 6] |= 1L << i;
+				hasNull = true;
+			}
+		}
+
+		return hasNull ? bits : null;
+	}
+
+	void checkColumnMetadata(int columnId)
 	{
 		if (!columnTypes.containsKey(columnId)) {
 			throw new IllegalArgumentException("Metadata for column ID #: " + columnId + " does not exist");
 		}
 	}
+
+	/**
+	 * Null rows of a column stored as a bitmap
+	 */
+	private static class NullBitmap {
+		final int    rowCount;
+		final long[] bits;
+
+		NullBitmap(int rowCount, long[] bits) {
+			this.rowCount = rowCount;
+			this.bits = bits;
+		}
+
+		boolean isNull(int row) {
+			return (bits[row >>> 6] & (1L << row)) != 0;
+		}
+
+		boolean[] toNullMap() {
+			boolean[] nullMap = new boolean[rowCount];
+
+			for (int row = 0; row < rowCount; row++) {
+				nullMap[row] = isNull(row);
+			}
+
+			return nullMap;
+		}
+	}
+
+	/**
+	 * Date column stored as days since 1970-01-01
+	 */
+	private static class EpochDateColumn {
+		final long[] days;
+
+		EpochDateColumn(long[] days) {
+			this.days = days;
+		}
+	}
+
+	/**
+	 * Timestamp column stored as seconds since 1970-01-01 00:00:00 and nanoseconds
+	 */
+	private static class EpochTimestampColumn {
+		final long[] seconds;
+		final int[]  nanos;
+
+		EpochTimestampColumn(long[] seconds, int[] nanos) {
+			this.seconds = seconds;
+			this.nanos = nanos;
+		}
+	}
+
+	/**
+	 * Numeric column stored as unscaled values
+	 */
+	private static class UnscaledNumericColumn {
+		final long[] values;
+		final int    scale;
+
+		UnscaledNumericColumn(long[] values, int scale) {
+			this.values = values;
+			this.scale = scale;
+		}
+	}
+
+	/**
+	 * Uniqueidentifier column stored as the most and least significant 64 bits of each GUID
+	 */
+	private static class GuidColumn {
+		final long[] mostSigBits;
+		final long[] leastSigBits;
+
+		GuidColumn(long[] mostSigBits, long[] leastSigBits) {
+			this.mostSigBits = mostSigBits;
+			this.leastSigBits = leastSigBits;
+		}
+	}
+
+	/**
+	 * Binary column stored as one byte array and the offset of each row
+	 */
+	private static class OffsetBinaryColumn {
+		final byte[] data;
+		final int[]  offsets;
+
+		OffsetBinaryColumn(byte[] data, int[] offsets) {
+			this.data = data;
+			this.offsets = offsets;
+		}
+	}
+
+	/**
+	 * UTF-8 string column that has not been decoded yet
+	 */
+	private static class Utf8StringColumn {
+		final byte[] data;
+		final int[]  lengths;
+
+		Utf8StringColumn(byte[] data, int[] lengths) {
+			this.data = data;
+			this.lengths = lengths;
+		}
+	}
 }
@@ -0,0 +1,220 @@
+package com.microsoft.sqlserver.javalangextension;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import com.microsoft.sqlserver.javalangextension.DirectBufferDataset;
+import com.microsoft.sqlserver.javalangextension.ParallelSqlServerExtensionExecutor;
+import com.microsoft.sqlserver.javalangextension.PrimitiveDataset;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.sql.Types;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinWorkerThread;
+import java.util.concurrent.TimeUnit;
+import org.junit.Test;
+
+/**
+ * Tests that ParallelSqlServerExtensionExecutor runs the ranges of the input and concatenates their
+ * outputs in row order, and that the pool running them is shut down when execute() returns.
+ */
+public class ParallelSqlServerExtensionExecutorTests {
+	private static final int ROW_COUNT = 100;
+
+	/**
+	 * Executor returning the int column of the input doubled, which records the partitions it is
+	 * called with and the pools running them
+	 */
+	private static class DoublingExecutor extends ParallelSqlServerExtensionExecutor {
+		final List<PrimitiveDataset> partitions = Collections.synchronizedList(new ArrayList<PrimitiveDataset>());
+		final List<ForkJoinPool> pools = Collections.synchronizedList(new ArrayList<ForkJoinPool>());
+		boolean throwException;
+
+		DoublingExecutor(int minPartitionRowCount) {
+			this.minPartitionRowCount = minPartitionRowCount;
+		}
+
+		protected PrimitiveDataset executePartition(PrimitiveDataset partition, LinkedHashMap<String, Object> params) {
+			partitions.add(partition);
+
+			Thread thread = Thread.currentThread();
+			if (thread instanceof ForkJoinWorkerThread) {
+				pools.add(((ForkJoinWorkerThread)thread).getPool());
+			}
+
+			if (throwException) {
+				throw new IllegalStateException("Partition failed");
+			}
+
+			int[] rows = partition.getIntColumn(1);
+			int[] doubled = new int[rows.length];
+			for (int row = 0; row < rows.length; row++) {
+				doubled[row] = rows[row] * 2;
+			}
+
+			PrimitiveDataset output = new PrimitiveDataset();
+			output.addColumnMetadata(1, "doubled", Types.INTEGER, 10, 0);
+			output.addIntColumn(1, doubled, partition.getColumnNullMap(1));
+
+			return output;
+		}
+	}
+
+	@Test
+	public void executeConcatenatesPartitionsInOrderTest() throws InterruptedException {
+		DoublingExecutor executor = new DoublingExecutor(1);
+		PrimitiveDataset input = createInput();
+
+		PrimitiveDataset output = (PrimitiveDataset)executor.execute(input, createParams(4));
+
+		assertEquals(4, executor.partitions.size());
+		assertEquals(ROW_COUNT, output.getRowCount());
+		assertArrayEquals(getExpectedValues(), output.getIntColumn(1));
+		assertArrayEquals(getNullMap(), output.getColumnNullMap(1));
+
+		checkPoolsShutdown(executor);
+	}
+
+	@Test
+	public void executeParallelismParameterTest() throws InterruptedException {
+		DoublingExecutor executor = new DoublingExecutor(1);
+		LinkedHashMap<String, Object> params = new LinkedHashMap<>();
+		params.put(ParallelSqlServerExtensionExecutor.PARALLELISM_PARAM_NAME, " 2 ");
+
+		PrimitiveDataset output = (PrimitiveDataset)executor.execute(createInput(), params);
+
+		assertEquals(2, executor.partitions.size());
+		assertArrayEquals(getExpectedValues(), output.getIntColumn(1));
+
+		checkPoolsShutdown(executor);
+	}
+
+	@Test
+	public void executeDirectBufferInputTest() throws InterruptedException {
+		DoublingExecutor executor = new DoublingExecutor(1);
+		boolean[] nullMap = getNullMap();
+
+		DirectBufferDataset input = new DirectBufferDataset();
+		input.addColumnMetadata(1, "value", Types.INTEGER, 10, 0);
+
+		ByteBuffer data = ByteBuffer.allocateDirect(ROW_COUNT * Integer.BYTES).order(ByteOrder.nativeOrder());
+		ByteBuffer nullIndicators = ByteBuffer.allocateDirect(ROW_COUNT * Integer.BYTES).order(ByteOrder.nativeOrder());
+
+		for (int row = 0; row < ROW_COUNT; row++) {
+			// Null rows hold a value that is not 0, as the native buffers can
+			//
+			data.putInt(row * Integer.BYTES, nullMap[row] ? -1 : row);
+			nullIndicators.putInt(row * Integer.BYTES, nullMap[row] ? -1 : Integer.BYTES);
+		}
+
+		input.addColumnBuffer(1, ROW_COUNT, data, nullIndicators);
+
+		PrimitiveDataset output = (PrimitiveDataset)executor.execute(input, createParams(4));
+
+		assertEquals(4, executor.partitions.size());
+		for (PrimitiveDataset partition : executor.partitions) {
+			assertFalse(partition instanceof DirectBufferDataset);
+		}
+
+		assertEquals(ROW_COUNT, output.getRowCount());
+		assertArrayEquals(getExpectedValues(), output.getIntColumn(1));
+		assertArrayEquals(nullMap, output.getColumnNullMap(1));
+
+		checkPoolsShutdown(executor);
+	}
+
+	@Test
+	public void executeFailedPartitionTest() throws InterruptedException {
+		DoublingExecutor executor = new DoublingExecutor(1);
+		executor.throwException = true;
+
+		try {
+			executor.execute(createInput(), createParams(4));
+			fail("execute() did not throw the exception of the partitions");
+		} catch (IllegalStateException e) {
+			assertEquals("Partition failed", e.getMessage());
+		}
+
+		checkPoolsShutdown(executor);
+	}
+
+	@Test
+	public void executeSmallInputTest() {
+		DoublingExecutor executor = new DoublingExecutor(1024);
+		PrimitiveDataset input = createInput();
+
+		PrimitiveDataset output = (PrimitiveDataset)executor.execute(input, createParams(4));
+
+		// The input is not split and runs on the calling thread
+		//
+		assertEquals(1, executor.partitions.size());
+		assertSame(input, executor.partitions.get(0));
+		assertTrue(executor.pools.isEmpty());
+		assertArrayEquals(getExpectedValues(), output.getIntColumn(1));
+	}
+
+	/**
+	 * Checks that ranges ran on a pool, and that every pool was shut down and its threads terminated
+	 */
+	private static void checkPoolsShutdown(DoublingExecutor executor) throws InterruptedException {
+		assertFalse(executor.pools.isEmpty());
+
+		for (ForkJoinPool pool : executor.pools) {
+			assertTrue(pool.isShutdown());
+			assertTrue(pool.awaitTermination(10, TimeUnit.SECONDS));
+		}
+	}
+
+	private static PrimitiveDataset createInput() {
+		PrimitiveDataset input = new PrimitiveDataset();
+		input.addColumnMetadata(1, "value", Types.INTEGER, 10, 0);
+
+		boolean[] nullMap = getNullMap();
+		int[] rows = new int[ROW_COUNT];
+		for (int row = 0; row < ROW_COUNT; row++) {
+			rows[row] = nullMap[row] ? 0 : row;
+		}
+
+		input.addIntColumn(1, rows, nullMap);
+
+		return input;
+	}
+
+	private static LinkedHashMap<String, Object> createParams(int parallelism) {
+		LinkedHashMap<String, Object> params = new LinkedHashMap<>();
+		params.put(ParallelSqlServerExtensionExecutor.PARALLELISM_PARAM_NAME, parallelism);
+
+		return params;
+	}
+
+	/**
+	 * Every seventh row is null
+	 */
+	private static boolean[] getNullMap() {
+		boolean[] nullMap = new boolean[ROW_COUNT];
+		for (int row = 0; row < ROW_COUNT; row += 7) {
+			nullMap[row] = true;
+		}
+
+		return nullMap;
+	}
+
+	private static int[] getExpectedValues() {
+		boolean[] nullMap = getNullMap();
+		int[] expected = new int[ROW_COUNT];
+
+		for (int row = 0; row < ROW_COUNT; row++) {
+			expected[row] = nullMap[row] ? 0 : row * 2;
+		}
+
+		return expected;
+	}
+}
@@ -0,0 +1,280 @@
+package com.microsoft.sqlserver.javalangextension;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import com.microsoft.sqlserver.javalangextension.DirectBufferDataset;
+import com.microsoft.sqlserver.javalangextension.PrimitiveDataset;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.sql.Types;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import org.junit.Test;
+
+/**
+ * Tests that PrimitiveDataset.split() and concat() keep the values and null rows of each column,
+ * for columns stored in arrays, in a null bitmap, as UTF-8 bytes and in direct buffers.
+ */
+public class PrimitiveDatasetSplitTests {
+	private static final int ROW_COUNT = 10;
+
+	private static final int[] INT_VALUES = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+	private static final boolean[] INT_NULL_MAP = { false, true, false, false, false, true, false, false, false, false };
+	private static final double[] DOUBLE_VALUES = { 0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5 };
+	private static final long[] LONG_VALUES = { 0L, 1000L, 2000L, 3000L, 4000L, 5000L, 6000L, 7000L, 8000L, 9000L };
+	private static final boolean[] LONG_NULL_MAP = { true, false, false, false, false, false, false, false, false, true };
+	private static final String[] STRING_VALUES = { "a", "\u00e9t\u00e9", "", null, "xyz", null, "\u4e2d", "b", "cd", null };
+
+	/* Rows of the int buffer columns, with values that are not 0 in the null rows */
+	private static final int[] BUFFER_INT_VALUES = { 1, 2, -999, 4, 5, 6, 7, -999, 9, 10 };
+	private static final boolean[] BUFFER_INT_NULL_MAP = { false, false, true, false, false, false, false, true, false, false };
+	private static final short[] BUFFER_TINYINT_VALUES = { 0, 1, 127, 128, 200, 255, 3, 4, 5, 6 };
+
+	@Test
+	public void splitArrayColumnsTest() {
+		PrimitiveDataset dataset = createArrayDataset();
+		List<PrimitiveDataset> partitions = dataset.split(3);
+		int[] firstRows = { 0, 3, 6, ROW_COUNT };
+
+		assertEquals(3, partitions.size());
+
+		for (int i = 0; i < partitions.size(); i++) {
+			PrimitiveDataset partition = partitions.get(i);
+			int from = firstRows[i];
+			int to = firstRows[i + 1];
+
+			assertEquals(to - from, partition.getRowCount());
+			assertEquals(dataset.getColumnCount(), partition.getColumnCount());
+			assertEquals("intColumn", partition.getColumnName(1));
+
+			assertArrayEquals(Arrays.copyOfRange(INT_VALUES, from, to), partition.getIntColumn(1));
+			assertArrayEquals(Arrays.copyOfRange(INT_NULL_MAP, from, to), partition.getColumnNullMap(1));
+			assertArrayEquals(Arrays.copyOfRange(DOUBLE_VALUES, from, to), partition.getDoubleColumn(2), 0);
+			assertNull(partition.getColumnNullMap(2));
+			assertArrayEquals(Arrays.copyOfRange(LONG_VALUES, from, to), partition.getLongColumn(3));
+			assertArrayEquals(Arrays.copyOfRange(LONG_NULL_MAP, from, to), partition.getColumnNullMap(3));
+			assertArrayEquals(Arrays.copyOfRange(STRING_VALUES, from, to), partition.getStringColumn(4));
+		}
+	}
+
+	@Test
+	public void concatSplitArrayColumnsTest() {
+		PrimitiveDataset result = PrimitiveDataset.concat(createArrayDataset().split(4));
+
+		assertEquals(ROW_COUNT, result.getRowCount());
+		assertArrayEquals(INT_VALUES, result.getIntColumn(1));
+		assertArrayEquals(INT_NULL_MAP, result.getColumnNullMap(1));
+		assertArrayEquals(DOUBLE_VALUES, result.getDoubleColumn(2), 0);
+		assertNull(result.getColumnNullMap(2));
+		assertArrayEquals(LONG_VALUES, result.getLongColumn(3));
+		assertArrayEquals(LONG_NULL_MAP, result.getColumnNullMap(3));
+		assertArrayEquals(STRING_VALUES, result.getStringColumn(4));
+	}
+
+	@Test
+	public void concatSingleDatasetTest() {
+		PrimitiveDataset dataset = createArrayDataset();
+		PrimitiveDataset result = PrimitiveDataset.concat(Collections.singletonList(dataset));
+
+		assertNotSame(dataset, result);
+		assertEquals(ROW_COUNT, result.getRowCount());
+		assertArrayEquals(INT_VALUES, result.getIntColumn(1));
+		assertArrayEquals(LONG_NULL_MAP, result.getColumnNullMap(3));
+		assertArrayEquals(STRING_VALUES, result.getStringColumn(4));
+
+		// The result does not share its columns with the dataset
+		//
+		result.getIntColumn(1)[0] = -1;
+		result.getColumnNullMap(1)[0] = true;
+
+		assertArrayEquals(INT_VALUES, dataset.getIntColumn(1));
+		assertArrayEquals(INT_NULL_MAP, dataset.getColumnNullMap(1));
+	}
+
+	@Test
+	public void concatEmptyListTest() {
+		try {
+			PrimitiveDataset.concat(Collections.<PrimitiveDataset>emptyList());
+			fail("concat() did not reject an empty list");
+		} catch (IllegalArgumentException e) {
+			assertEquals("No datasets to concatenate", e.getMessage());
+		}
+	}
+
+	@Test
+	public void splitDirectBufferColumnsTest() {
+		DirectBufferDataset dataset = createBufferDataset();
+		List<PrimitiveDataset> partitions = dataset.split(4);
+		int[] firstRows = { 0, 2, 5, 7, ROW_COUNT };
+
+		// The row count comes from the buffer columns, the dataset has no array column
+		//
+		assertEquals(ROW_COUNT, dataset.getRowCount());
+		assertEquals(4, partitions.size());
+
+		int[] expectedInts = getExpectedBufferInts();
+
+		for (int i = 0; i < partitions.size(); i++) {
+			PrimitiveDataset partition = partitions.get(i);
+			int from = firstRows[i];
+			int to = firstRows[i + 1];
+
+			assertFalse(partition instanceof DirectBufferDataset);
+			assertEquals(to - from, partition.getRowCount());
+
+			assertArrayEquals(Arrays.copyOfRange(expectedInts, from, to), partition.getIntColumn(1));
+			assertArrayEquals(Arrays.copyOfRange(BUFFER_INT_NULL_MAP, from, to), partition.getColumnNullMap(1));
+			assertArrayEquals(Arrays.copyOfRange(DOUBLE_VALUES, from, to), partition.getDoubleColumn(2), 0);
+			assertNull(partition.getColumnNullMap(2));
+			assertArrayEquals(Arrays.copyOfRange(BUFFER_TINYINT_VALUES, from, to), partition.getShortColumn(3));
+
+			for (int row = from; row < to; row++) {
+				assertEquals(BUFFER_INT_NULL_MAP[row], partition.isNull(1, row - from));
+			}
+		}
+	}
+
+	@Test
+	public void concatSplitDirectBufferColumnsTest() {
+		DirectBufferDataset dataset = createBufferDataset();
+
+		// Mix a column stored in an array with the buffer columns
+		//
+		dataset.addColumnMetadata(4, "intArrayColumn", Types.INTEGER, 10, 0);
+		dataset.addIntColumn(4, INT_VALUES, INT_NULL_MAP);
+
+		PrimitiveDataset result = PrimitiveDataset.concat(dataset.split(3));
+
+		assertFalse(result instanceof DirectBufferDataset);
+		assertEquals(ROW_COUNT, result.getRowCount());
+		assertArrayEquals(getExpectedBufferInts(), result.getIntColumn(1));
+		assertArrayEquals(BUFFER_INT_NULL_MAP, result.getColumnNullMap(1));
+		assertArrayEquals(DOUBLE_VALUES, result.getDoubleColumn(2), 0);
+		assertArrayEquals(BUFFER_TINYINT_VALUES, result.getShortColumn(3));
+		assertArrayEquals(INT_VALUES, result.getIntColumn(4));
+		assertArrayEquals(INT_NULL_MAP, result.getColumnNullMap(4));
+	}
+
+	@Test
+	public void concatDirectBufferOutputsTest() {
+		DirectBufferDataset first = new DirectBufferDataset();
+		first.addColumnMetadata(1, "intColumn", Types.INTEGER, 10, 0);
+		first.createColumnBuffer(1, 3);
+		first.setInt(1, 0, 1);
+		first.setInt(1, 1, 2);
+		first.setNull(1, 2);
+
+		DirectBufferDataset second = new DirectBufferDataset();
+		second.addColumnMetadata(1, "intColumn", Types.INTEGER, 10, 0);
+		second.createColumnBuffer(1, 2);
+		second.setInt(1, 0, 4);
+		second.setInt(1, 1, 5);
+
+		PrimitiveDataset result = PrimitiveDataset.concat(Arrays.<PrimitiveDataset>asList(first, second));
+
+		assertEquals(5, result.getRowCount());
+		assertArrayEquals(new int[] { 1, 2, 0, 4, 5 }, result.getIntColumn(1));
+		assertArrayEquals(new boolean[] { false, false, true, false, false }, result.getColumnNullMap(1));
+		assertTrue(result.isNull(1, 2));
+	}
+
+	/**
+	 * Dataset of int, double, bigint and UTF-8 string columns, with the bigint null rows set as a null
+	 * bitmap
+	 */
+	private static PrimitiveDataset createArrayDataset() {
+		PrimitiveDataset dataset = new PrimitiveDataset();
+
+		dataset.addColumnMetadata(1, "intColumn", Types.INTEGER, 10, 0);
+		dataset.addColumnMetadata(2, "doubleColumn", Types.DOUBLE, 53, 0);
+		dataset.addColumnMetadata(3, "longColumn", Types.BIGINT, 19, 0);
+		dataset.addColumnMetadata(4, "stringColumn", Types.NVARCHAR, 10, 0);
+
+		dataset.addIntColumn(1, INT_VALUES.clone(), INT_NULL_MAP.clone());
+		dataset.addDoubleColumn(2, DOUBLE_VALUES.clone(), null);
+		dataset.addLongColumn(3, LONG_VALUES.clone(), null);
+		dataset.setColumnNullBitmap(3, ROW_COUNT, new long[] { (1L << 0) | (1L << 9) });
+
+		int[] lengths = new int[STRING_VALUES.length];
+		byte[][] encoded = new byte[STRING_VALUES.length][];
+		int dataLength = 0;
+
+		for (int row = 0; row < STRING_VALUES.length; row++) {
+			if (STRING_VALUES[row] == null) {
+				lengths[row] = -1;
+			} else {
+				encoded[row] = STRING_VALUES[row].getBytes(StandardCharsets.UTF_8);
+				lengths[row] = encoded[row].length;
+				dataLength += lengths[row];
+			}
+		}
+
+		ByteBuffer data = ByteBuffer.allocate(dataLength);
+		for (byte[] bytes : encoded) {
+			if (bytes != null) {
+				data.put(bytes);
+			}
+		}
+
+		dataset.addStringColumn(4, data.array(), lengths);
+
+		return dataset;
+	}
+
+	/**
+	 * Dataset of an int buffer column with null rows, and double and tinyint buffer columns without
+	 * null indicators, laid out as the extension passes them
+	 */
+	private static DirectBufferDataset createBufferDataset() {
+		DirectBufferDataset dataset = new DirectBufferDataset();
+
+		dataset.addColumnMetadata(1, "intColumn", Types.INTEGER, 10, 0);
+		dataset.addColumnMetadata(2, "doubleColumn", Types.DOUBLE, 53, 0);
+		dataset.addColumnMetadata(3, "tinyintColumn", Types.TINYINT, 3, 0);
+
+		ByteBuffer intData = allocate(ROW_COUNT * Integer.BYTES);
+		ByteBuffer intNullIndicators = allocate(ROW_COUNT * Integer.BYTES);
+		ByteBuffer doubleData = allocate(ROW_COUNT * Double.BYTES);
+		ByteBuffer tinyintData = allocate(ROW_COUNT);
+
+		for (int row = 0; row < ROW_COUNT; row++) {
+			intData.putInt(row * Integer.BYTES, BUFFER_INT_VALUES[row]);
+			intNullIndicators.putInt(row * Integer.BYTES, BUFFER_INT_NULL_MAP[row] ? -1 : Integer.BYTES);
+			doubleData.putDouble(row * Double.BYTES, DOUBLE_VALUES[row]);
+			tinyintData.put(row, (byte)BUFFER_TINYINT_VALUES[row]);
+		}
+
+		dataset.addColumnBuffer(1, ROW_COUNT, intData, intNullIndicators);
+		dataset.addColumnBuffer(2, ROW_COUNT, doubleData, null);
+		dataset.addColumnBuffer(3, ROW_COUNT, tinyintData, null);
+
+		return dataset;
+	}
+
+	/**
+	 * Values of the int buffer column once copied, where null rows are 0
+	 */
+	private static int[] getExpectedBufferInts() {
+		int[] expected = BUFFER_INT_VALUES.clone();
+
+		for (int row = 0; row < ROW_COUNT; row++) {
+			if (BUFFER_INT_NULL_MAP[row]) {
+				expected[row] = 0;
+			}
+		}
+
+		return expected;
+	}
+
+	private static ByteBuffer allocate(int size) {
+		return ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder());
+	}
+}
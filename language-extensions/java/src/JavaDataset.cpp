@@ -18,6 +18,85 @@
 
 using namespace std;
 
+// SDK dataset class exposing fixed width columns as direct buffers over the ODBC data
+//
+const string x_javaSdkDirectBufferDatasetClass =
+	"com/microsoft/sqlserver/javalangextension/DirectBufferDataset";
+
+// Name and signature of the DirectBufferDataset function for adding a direct buffer column
+//
+const string x_addColumnBufferFuncName = "addColumnBuffer";
+const string x_addColumnBufferFuncSignature = "(IILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V";
+
+// Size in bytes of a row of each fixed width type that can be exchanged as a direct buffer
+//
+const unordered_map<SQLSMALLINT, SQLULEN> x_columnBufferTypeSizeMap =
+{
+	{static_cast<SQLSMALLINT>(SQL_C_BIT), sizeof(SQLCHAR)},
+	{static_cast<SQLSMALLINT>(SQL_C_SLONG), sizeof(SQLINTEGER)},
+	{static_cast<SQLSMALLINT>(SQL_C_DOUBLE), sizeof(SQLDOUBLE)},
+	{static_cast<SQLSMALLINT>(SQL_C_FLOAT), sizeof(SQLREAL)},
+	{static_cast<SQLSMALLINT>(SQL_C_SSHORT), sizeof(SQLSMALLINT)},
+	{static_cast<SQLSMALLINT>(SQL_C_UTINYINT), sizeof(SQLCHAR)},
+	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT), sizeof(SQLBIGINT)},
+};
+
+// Numeric columns up to this precision are exchanged as unscaled 64 bit values
+//
+const SQLULEN x_maxUnscaledNumericPrecision = 18;
+
+// Names and signatures of the Dataset functions for unscaled numeric columns
+//
+const string x_addUnscaledNumericColumnFuncName = "addNumericColumn";
+const string x_addUnscaledNumericColumnFuncSignature = "(I[JI[Z)V";
+const string x_getUnscaledNumericColumnFuncName = "getUnscaledNumericColumn";
+const string x_getUnscaledNumericColumnFuncSignature = "(I)[J";
+
+// Names and signatures of the Dataset functions for epoch based date and timestamp columns
+//
+const string x_addEpochDateColumnFuncName = "addDateColumn";
+const string x_addEpochDateColumnFuncSignature = "(I[J[Z)V";
+const string x_addEpochTimestampColumnFuncName = "addTimestampColumn";
+const string x_addEpochTimestampColumnFuncSignature = "(I[J[I[Z)V";
+const string x_getEpochDayColumnFuncName = "getEpochDayColumn";
+const string x_getEpochSecondColumnFuncName = "getEpochSecondColumn";
+const string x_getNanosColumnFuncName = "getNanosColumn";
+const string x_getEpochLongColumnFuncSignature = "(I)[J";
+const string x_getNanosColumnFuncSignature = "(I)[I";
+
+// Names and signatures of the Dataset functions adding binary columns as one byte array with
+// offsets, and GUID columns as their most and least significant bits
+//
+const string x_addOffsetBinaryColumnFuncName = "addBinaryColumn";
+const string x_addOffsetBinaryColumnFuncSignature = "(I[B[I[Z)V";
+const string x_addGuidBitsColumnFuncName = "addGuidColumn";
+const string x_addGuidBitsColumnFuncSignature = "(I[J[J[Z)V";
+
+// Name and signature of the Dataset function adding a UTF-8 string column as one byte array
+// with the length of each row
+//
+const string x_addUtf8StringColumnFuncName = "addStringColumn";
+const string x_addUtf8StringColumnFuncSignature = "(I[B[I)V";
+
+// Names and signatures of the Dataset functions exchanging null maps as bitmaps
+//
+const string x_setColumnNullBitmapFuncName = "setColumnNullBitmap";
+const string x_setColumnNullBitmapFuncSignature = "(II[J)V";
+const string x_getColumnNullBitmapFuncName = "getColumnNullBitmap";
+const string x_getColumnNullBitmapFuncSignature = "(I)[J";
+
+// Names and signatures of the Dataset functions getting string and binary columns encoded into
+// one byte array, and the fields of the returned EncodedColumn
+//
+const string x_getEncodedStringColumnFuncName = "getEncodedStringColumn";
+const string x_getEncodedStringColumnFuncSignature =
+	"(IZ)Lcom/microsoft/sqlserver/javalangextension/AbstractSqlServerExtensionDataset$EncodedColumn;";
+const string x_getEncodedBinaryColumnFuncName = "getEncodedBinaryColumn";
+const string x_getEncodedBinaryColumnFuncSignature =
+	"(I)Lcom/microsoft/sqlserver/javalangextension/AbstractSqlServerExtensionDataset$EncodedColumn;";
+const string x_encodedColumnDataFieldName = "data";
+const string x_encodedColumnLengthsFieldName = "lengths";
+
 // Map of Dataset function names and signatures for adding a column to the dataset
 //
 const unordered_map<SQLSMALLINT, tuple<string, string>> x_addColumnFuncInfo =
@@ -30,7 +109,7 @@ const unordered_map<SQLSMALLINT, tuple<string, string>> x_addColumnFuncInfo =
 	{static_cast<SQLSMALLINT>(SQL_C_UTINYINT), make_tuple("addShortColumn", "(I[S[Z)V")},
 	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT), make_tuple("addLongColumn", "(I[J[Z)V")},
 	{static_cast<SQLSMALLINT>(SQL_C_CHAR),
-	 make_tuple("addStringColumn", "(I[Ljava/lang/String;)V")},
+	 make_tuple("addStringColumn",  "(I[Ljava/lang/String;)V")},
 	{static_cast<SQLSMALLINT>(SQL_C_WCHAR),
 	 make_tuple("addStringColumn",  "(I[Ljava/lang/String;)V")},
 	{static_cast<SQLSMALLINT>(SQL_C_BINARY), make_tuple("addBinaryColumn", "(I[[B)V")},
@@ -89,9 +168,9 @@ unordered_map<SQLSMALLINT, JavaDataset::fnAddColumn> JavaDataset::m_fnAddColumnM
 	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT),
 	 static_cast<fnAddColumn>(&JavaDataset::AddColumnInternal<jlongArray, jlong, SQLBIGINT>)},
 	{static_cast<SQLSMALLINT>(SQL_C_CHAR),
-	 static_cast<fnAddColumn>(&JavaDataset::AddStringColumnInternal<true>)},
+	 static_cast<fnAddColumn>(&JavaDataset::AddUtf8StringColumnInternal)},
 	{static_cast<SQLSMALLINT>(SQL_C_WCHAR),
-	 static_cast<fnAddColumn>(&JavaDataset::AddStringColumnInternal<false>)},
+	 static_cast<fnAddColumn>(&JavaDataset::AddStringColumnInternal)},
 	{static_cast<SQLSMALLINT>(SQL_C_BINARY),
 	 static_cast<fnAddColumn>(&JavaDataset::AddBinaryColumnInternal)},
 	{static_cast<SQLSMALLINT>(SQL_C_GUID),
@@ -104,6 +183,26 @@ unordered_map<SQLSMALLINT, JavaDataset::fnAddColumn> JavaDataset::m_fnAddColumnM
 	 static_cast<fnAddColumn>(&JavaDataset::AddTimestampColumnInternal)},
 };
 
+// Map of function pointers for adding a fixed width column as a direct buffer
+//
+unordered_map<SQLSMALLINT, JavaDataset::fnAddColumn> JavaDataset::m_fnAddColumnBufferMap =
+{
+	{static_cast<SQLSMALLINT>(SQL_C_BIT),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLCHAR>)},
+	{static_cast<SQLSMALLINT>(SQL_C_SLONG),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLINTEGER>)},
+	{static_cast<SQLSMALLINT>(SQL_C_DOUBLE),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLDOUBLE>)},
+	{static_cast<SQLSMALLINT>(SQL_C_FLOAT),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLREAL>)},
+	{static_cast<SQLSMALLINT>(SQL_C_SSHORT),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLSMALLINT>)},
+	{static_cast<SQLSMALLINT>(SQL_C_UTINYINT),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLCHAR>)},
+	{static_cast<SQLSMALLINT>(SQL_C_SBIGINT),
+	 static_cast<fnAddColumn>(&JavaDataset::AddColumnBufferInternal<SQLBIGINT>)},
+};
+
 // Map of function pointers for getting a column
 //
 unordered_map<SQLSMALLINT, JavaDataset::fnGetColumn> JavaDataset::m_fnGetColumnMap =
@@ -140,16 +239,25 @@ unordered_map<SQLSMALLINT, JavaDataset::fnGetColumn> JavaDataset::m_fnGetColumnM
 // Name: JavaDataset::CreateJniNullMap
 //
 // Description:
-//	Creates a boolean array in JNI representing a column null map and returns a global reference.
+//	Fills a boolean array in JNI representing a column null map and returns a global reference.
+//	The array is kept by the dataset and reused by the next batch of a stream.
+//	Returns nullptr if the Dataset supports null bitmaps, which are set by SetJniNullBitmap.
 //
-jbooleanArray JavaDataset::CreateJniNullMap(jsize numRows, const SQLINTEGER *values)
+jbooleanArray JavaDataset::CreateJniNullMap(jint colId, jsize numRows, const SQLINTEGER *values)
 {
 	LOG("JavaDataset::CreateJniNullMap");
 	jbooleanArray jNullMapArray = nullptr;
 
-	// Create the JNI boolean array
+	// The null rows are set with SetJniNullBitmap instead
+	//
+	if (m_setColumnNullBitmapMethod != nullptr)
+	{
+		return nullptr;
+	}
+
+	// Get the JNI boolean array
 	//
-	jNullMapArray = JniTypeHelper::CreateJniArray<jbooleanArray>(m_env, numRows);
+	jNullMapArray = GetReusableArray<jbooleanArray>(m_nullMapArrays, colId, numRows);
 	jboolean *jData = JniTypeHelper::GetJniArrayElems<jbooleanArray, jboolean>(m_env,
 																			   jNullMapArray);
 
@@ -169,6 +277,129 @@ jbooleanArray JavaDataset::CreateJniNullMap(jsize numRows, const SQLINTEGER *val
 	return jNullMapArray;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::SetJniNullBitmap
+//
+// Description:
+//	Sets the null rows of a column added to the Dataset as a bitmap, which is 64 times smaller
+//	than a boolean array. Nothing is sent for a column without null rows, since adding the column
+//	with no null map already marks all rows as not null.
+//	Must be called after the column is added, since adding a column replaces its null map.
+//
+void JavaDataset::SetJniNullBitmap(jint colId, jsize numRows, const SQLINTEGER *values)
+{
+	LOG("JavaDataset::SetJniNullBitmap");
+
+	if (m_setColumnNullBitmapMethod == nullptr ||
+		values == nullptr ||
+		!JniTypeHelper::HasNullData(numRows, values))
+	{
+		return;
+	}
+
+	jsize numWords = (numRows + 63) / 64;
+
+	jlongArray jNullBitmap = GetReusableArray<jlongArray>(m_nullMapArrays, colId, numWords);
+
+	jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jNullBitmap);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	if (jData == nullptr)
+	{
+		throw runtime_error("Could not get elements for the null map of column ID " +
+							to_string(colId));
+	}
+
+	JniTypeHelper::CopyNullBitmapInputData(numRows, values, jData);
+
+	JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jNullBitmap, jData);
+
+	m_env->CallVoidMethod(m_object, m_setColumnNullBitmapMethod, colId, numRows, jNullBitmap);
+	JniHelper::ThrowOnJavaException(m_env);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::FindNullBitmapMethods
+//
+// Description:
+//	Finds the Dataset methods exchanging null maps as bitmaps. Datasets without them exchange null
+//	maps as boolean arrays.
+//
+void JavaDataset::FindNullBitmapMethods()
+{
+	m_setColumnNullBitmapMethod = FindOptionalDatasetMethod(x_setColumnNullBitmapFuncName,
+															x_setColumnNullBitmapFuncSignature);
+
+	m_getColumnNullBitmapMethod = FindOptionalDatasetMethod(x_getColumnNullBitmapFuncName,
+															x_getColumnNullBitmapFuncSignature);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetReusableArray
+//
+// Description:
+//	Gets the array kept for the column from the previous batch of a stream when it has the same
+//	number of rows, so that it is refilled in place instead of allocating a new array per batch.
+//	Otherwise creates a new array and keeps a global reference to it for the next batch.
+//
+// Returns:
+//	Global reference to the array, owned by the dataset
+//
+template<typename jArrayType>
+jArrayType JavaDataset::GetReusableArray(
+	unordered_map<jint, jobject> &arrays,
+	jint                         colId,
+	jsize                        numRows)
+{
+	unordered_map<jint, jobject>::iterator it = arrays.find(colId);
+
+	if (it != arrays.end())
+	{
+		if (m_env->GetArrayLength(static_cast<jarray>(it->second)) == numRows)
+		{
+			return static_cast<jArrayType>(it->second);
+		}
+
+		m_env->DeleteGlobalRef(it->second);
+		arrays.erase(it);
+	}
+
+	jArrayType jLocalArray = JniTypeHelper::CreateJniArray<jArrayType>(m_env, numRows);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jobject jArray = m_env->NewGlobalRef(jLocalArray);
+	m_env->DeleteLocalRef(jLocalArray);
+
+	if (jArray == nullptr)
+	{
+		throw runtime_error("Could not create a global reference to the array of column ID " +
+							to_string(colId));
+	}
+
+	arrays[colId] = jArray;
+
+	return static_cast<jArrayType>(jArray);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::ReleaseArrays
+//
+// Description:
+//	Releases the global references of the arrays kept for reuse.
+//
+void JavaDataset::ReleaseArrays(unordered_map<jint, jobject> &arrays)
+{
+	if (m_env != nullptr)
+	{
+		for (pair<const jint, jobject> &array : arrays)
+		{
+			m_env->DeleteGlobalRef(array.second);
+		}
+	}
+
+	arrays.clear();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::CreateSqlNullMap
 //
@@ -310,6 +541,61 @@ jmethodID JavaDataset::FindDatasetMethod(const string &funcName, const string &f
 	return JniHelper::FindMethod(m_env, m_class, funcName, funcSignature);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::FindOptionalDatasetMethod
+//
+// Description:
+//	Finds the Java Dataset method from the function name and signature. Datasets that do not
+//	have the method are not an error, the caller falls back to the method all datasets have.
+//
+jmethodID JavaDataset::FindOptionalDatasetMethod(const string &funcName, const string &funcSignature)
+{
+	LOG("JavaDataset::FindOptionalDatasetMethod");
+
+	jmethodID method = m_env->GetMethodID(m_class, funcName.c_str(), funcSignature.c_str());
+
+	if (method == nullptr)
+	{
+		// Clear the NoSuchMethodError
+		//
+		m_env->ExceptionClear();
+	}
+
+	return method;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::IsDirectBufferDatasetClass
+//
+// Description:
+//	Determines if the Java Dataset class is, or derives from, the SDK DirectBufferDataset class.
+//	An SDK that does not contain DirectBufferDataset is not an error, the dataset is then
+//	populated through the Add<type>Column functions.
+//
+bool JavaDataset::IsDirectBufferDatasetClass()
+{
+	LOG("JavaDataset::IsDirectBufferDatasetClass");
+
+	bool result = false;
+
+	jclass directBufferClass = m_env->FindClass(x_javaSdkDirectBufferDatasetClass.c_str());
+
+	if (directBufferClass != nullptr)
+	{
+		result = (m_env->IsAssignableFrom(m_class, directBufferClass) == JNI_TRUE);
+
+		m_env->DeleteLocalRef(directBufferClass);
+	}
+	else
+	{
+		// Clear the class not found exception
+		//
+		m_env->ExceptionClear();
+	}
+
+	return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::Init
 //
@@ -324,11 +610,12 @@ void JavaDataset::Init(JNIEnv *env, const string &className)
 	{
 		m_env = env;
 
-		// Max number of local references for this function are 2:
+		// Max number of local references for this function are 3:
 		// 1 for the dataset class
 		// 1 for the object created
+		// 1 for the DirectBufferDataset class
 		//
-		AutoJniLocalFrame jFrame(m_env, 2);
+		AutoJniLocalFrame jFrame(m_env, 3);
 
 		jclass classLocalRef = m_env->FindClass(className.c_str());
 
@@ -357,6 +644,9 @@ void JavaDataset::Init(JNIEnv *env, const string &className)
 							throw runtime_error(
 									"Could not create global reference for dataset object");
 						}
+
+						m_isDirectBufferDataset = IsDirectBufferDatasetClass();
+						FindNullBitmapMethods();
 					}
 					else
 					{
@@ -401,11 +691,12 @@ void JavaDataset::Init(JNIEnv *env, jobject obj)
 	{
 		m_env = env;
 
-		// Max number of local references for this function are 2:
+		// Max number of local references for this function are 3:
 		// 1 for the dataset class
 		// 1 for the object created
+		// 1 for the DirectBufferDataset class
 		//
-		AutoJniLocalFrame jFrame(m_env, 2);
+		AutoJniLocalFrame jFrame(m_env, 3);
 
 		jclass classLocalRef = m_env->GetObjectClass(obj);
 
@@ -423,6 +714,9 @@ void JavaDataset::Init(JNIEnv *env, jobject obj)
 				{
 					throw runtime_error("Could not create global reference for dataset object");
 				}
+
+				m_isDirectBufferDataset = IsDirectBufferDatasetClass();
+				FindNullBitmapMethods();
 			}
 			else
 			{
@@ -588,23 +882,26 @@ void JavaDataset::GetColumnInternal(
 	{
 		jArrayType jArray = static_cast<jArrayType>(arr);
 
-		jType *outputColData = JniTypeHelper::GetJniArrayElems<jArrayType, jType>(m_env,
-																				  jArray);
+		jsize len = m_env->GetArrayLength(jArray);
+		numRows = static_cast<SQLULEN>(len);
+
+		unique_ptr<cType[]> returnData(new cType[len]);
+
+		jType *outputColData = static_cast<jType*>(m_env->GetPrimitiveArrayCritical(jArray, nullptr));
 
 		if (outputColData != nullptr)
 		{
-			// Copy the data from Java to the output data set
+			// Copy the data from Java to the output data set. The Java array is only read, so
+			// it is released without copying back.
 			//
-			*data = JniTypeHelper::CopyOutputData<jType, jArrayType, cType>(
-				m_env,
-				outputColData,
-				jArray,
-				numRows,
-				dataSizeInBytes);
-
-			JniTypeHelper::ReleaseJniArrayElems<jArrayType, jType>(m_env,
-																   jArray,
-																   outputColData);
+			JniTypeHelper::CopyOutputData<jType, cType>(outputColData,
+														len,
+														returnData.get(),
+														dataSizeInBytes);
+
+			m_env->ReleasePrimitiveArrayCritical(jArray, outputColData, JNI_ABORT);
+
+			*data = returnData.release();
 		}
 		else
 		{
@@ -618,7 +915,7 @@ void JavaDataset::GetColumnInternal(
 	{
 		SQLULEN numNullMapRows = 0;
 
-		GetColumnNullMap(colId, numNullMapRows, nullMap);
+		GetColumnNullMap(colId, numRows, numNullMapRows, nullMap);
 
 		if (numNullMapRows != 0 && numNullMapRows != numRows)
 		{
@@ -652,47 +949,163 @@ void JavaDataset::GetStringColumnInternal(
 	*data = nullptr;
 	*nullMap = nullptr;
 
-	// Get the column function for this column type
+	// Datasets encoding the column into one byte array are copied in bulk, others one row at a time
 	//
-	jmethodID method = FindGetColumnMethod(colType);
+	jmethodID encodedMethod = FindOptionalDatasetMethod(x_getEncodedStringColumnFuncName,
+														x_getEncodedStringColumnFuncSignature);
 
-	jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
+	if (encodedMethod != nullptr)
+	{
+		jobject jEncodedColumn = m_env->CallObjectMethod(m_object,
+														 encodedMethod,
+														 colId,
+														 isUTF8 ? JNI_TRUE : JNI_FALSE);
 
-	JniHelper::ThrowOnJavaException(m_env);
+		JniHelper::ThrowOnJavaException(m_env);
 
-	if (jArray != nullptr)
+		CopyEncodedColumn(colId, jEncodedColumn, numRows, dataSizeInBytes, data, nullMap);
+	}
+	else
 	{
-		jobjectArray stringArray = static_cast<jobjectArray>(jArray);
-
-		// Get the array length
+		// Get the column function for this column type
 		//
-		jsize jNumRows = m_env->GetArrayLength(stringArray);
-		numRows = static_cast<SQLULEN>(jNumRows);
+		jmethodID method = FindGetColumnMethod(colType);
 
-		// The required size of the buffer to return back to exthost.
-		//
-		unsigned long long totalSizeInBytes = 0;
+		jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
+
+		JniHelper::ThrowOnJavaException(m_env);
 
-		CalculateMaxForVarLengthOutputData<jstring, isUTF8>(stringArray,
-															totalSizeInBytes,
-															dataSizeInBytes);
+		if (jArray != nullptr)
+		{
+			jobjectArray stringArray = static_cast<jobjectArray>(jArray);
 
-		// Declare a new buffer to hold the return data
-		//
-		*data = new char[totalSizeInBytes];
-		*nullMap = new SQLINTEGER[numRows];
+			// Get the array length
+			//
+			jsize jNumRows = m_env->GetArrayLength(stringArray);
+			numRows = static_cast<SQLULEN>(jNumRows);
 
-		JniTypeHelper::CopyStringOutputData<isUTF8>(m_env,
-													stringArray,
-													jNumRows,
-													totalSizeInBytes,
-													static_cast<char*>(*data),
-													*nullMap);
+			// The required size of the buffer to return back to exthost.
+			//
+			unsigned long long totalSizeInBytes = 0;
+
+			CalculateMaxForVarLengthOutputData<jstring, isUTF8>(stringArray,
+																totalSizeInBytes,
+																dataSizeInBytes);
+
+			// Declare a new buffer to hold the return data
+			//
+			*data = new char[totalSizeInBytes];
+			*nullMap = new SQLINTEGER[numRows];
+
+			JniTypeHelper::CopyStringOutputData<isUTF8>(m_env,
+														stringArray,
+														jNumRows,
+														totalSizeInBytes,
+														static_cast<char*>(*data),
+														*nullMap);
+		}
 	}
 
 	dataSizeInBytes = max(dataSizeInBytes, 2ul);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::CopyEncodedColumn
+//
+// Description:
+//	Copies a string or binary column the Dataset encoded into one byte array with the length in
+//	bytes of each row, -1 for null rows. The values are copied with one bulk copy, and the lengths
+//	become the null map, instead of encoding and copying each row through JNI calls.
+//	A null jEncodedColumn is a null column, with no rows.
+//
+void JavaDataset::CopyEncodedColumn(
+	jint       colId,
+	jobject    jEncodedColumn,
+	SQLULEN    &numRows,
+	SQLULEN    &dataSizeInBytes,
+	SQLPOINTER *data,
+	SQLINTEGER **nullMap)
+{
+	LOG("JavaDataset::CopyEncodedColumn");
+
+	if (jEncodedColumn == nullptr)
+	{
+		return;
+	}
+
+	// Max number of local references for this function are 3:
+	// 1 for the EncodedColumn class
+	// 1 for the data array
+	// 1 for the lengths array
+	//
+	AutoJniLocalFrame jFrame(m_env, 3);
+
+	jclass encodedColumnClass = m_env->GetObjectClass(jEncodedColumn);
+
+	jfieldID dataField =
+		m_env->GetFieldID(encodedColumnClass, x_encodedColumnDataFieldName.c_str(), "[B");
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jfieldID lengthsField =
+		m_env->GetFieldID(encodedColumnClass, x_encodedColumnLengthsFieldName.c_str(), "[I");
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jbyteArray jData = static_cast<jbyteArray>(m_env->GetObjectField(jEncodedColumn, dataField));
+	jintArray jLengths = static_cast<jintArray>(m_env->GetObjectField(jEncodedColumn, lengthsField));
+
+	if (jData == nullptr || jLengths == nullptr)
+	{
+		throw runtime_error("Encoded output column ID " + to_string(colId) + " has no data");
+	}
+
+	jsize jNumRows = m_env->GetArrayLength(jLengths);
+	jsize jDataSize = m_env->GetArrayLength(jData);
+
+	unique_ptr<SQLINTEGER[]> sqlNullMap(new SQLINTEGER[jNumRows]);
+
+	// Convert the lengths into the null map, finding the total and the longest length
+	//
+	unsigned long long totalSizeInBytes = 0;
+	jint maxSizeInBytes = 0;
+
+	jint *lengths = static_cast<jint*>(m_env->GetPrimitiveArrayCritical(jLengths, nullptr));
+
+	if (lengths == nullptr)
+	{
+		throw runtime_error("Could not get elements for output column ID " + to_string(colId));
+	}
+
+	for (jsize i = 0; i < jNumRows; ++i)
+	{
+		jint length = lengths[i];
+
+		sqlNullMap[i] = length < 0 ? SQL_NULL_DATA : static_cast<SQLINTEGER>(length);
+		totalSizeInBytes += length < 0 ? 0 : length;
+		maxSizeInBytes = max(maxSizeInBytes, length);
+	}
+
+	m_env->ReleasePrimitiveArrayCritical(jLengths, lengths, JNI_ABORT);
+
+	if (totalSizeInBytes > static_cast<unsigned long long>(jDataSize))
+	{
+		throw runtime_error("Lengths of encoded output column ID " + to_string(colId) +
+							" exceed its data");
+	}
+
+	unique_ptr<char[]> outputData(new char[totalSizeInBytes]);
+
+	m_env->GetByteArrayRegion(jData,
+							  0,
+							  static_cast<jsize>(totalSizeInBytes),
+							  reinterpret_cast<jbyte*>(outputData.get()));
+	JniHelper::ThrowOnJavaException(m_env);
+
+	numRows = static_cast<SQLULEN>(jNumRows);
+	dataSizeInBytes = static_cast<SQLULEN>(maxSizeInBytes);
+	*data = outputData.release();
+	*nullMap = sqlNullMap.release();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::GetBinaryColumnInternal
 //
@@ -716,42 +1129,58 @@ void JavaDataset::GetBinaryColumnInternal(
 	*data = nullptr;
 	*nullMap = nullptr;
 
-	// Get the column function for this column type
+	// Datasets encoding the column into one byte array are copied in bulk, others one row at a time
 	//
-	jmethodID method = FindGetColumnMethod(colType);
+	jmethodID encodedMethod = FindOptionalDatasetMethod(x_getEncodedBinaryColumnFuncName,
+														x_getEncodedBinaryColumnFuncSignature);
 
-	jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
+	if (encodedMethod != nullptr)
+	{
+		jobject jEncodedColumn = m_env->CallObjectMethod(m_object, encodedMethod, colId);
 
-	JniHelper::ThrowOnJavaException(m_env);
+		JniHelper::ThrowOnJavaException(m_env);
 
-	if (jArray != nullptr)
+		CopyEncodedColumn(colId, jEncodedColumn, numRows, dataSizeInBytes, data, nullMap);
+	}
+	else
 	{
-		jobjectArray byteArray = static_cast<jobjectArray>(jArray);
-
-		// Get the array length
+		// Get the column function for this column type
 		//
-		jsize jNumRows = m_env->GetArrayLength(byteArray);
-		numRows = static_cast<SQLULEN>(jNumRows);
+		jmethodID method = FindGetColumnMethod(colType);
 
-		// The required size of the buffer to return back to exthost.
-		//
-		unsigned long long totalSizeInBytes = 0;
+		jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
 
-		CalculateMaxForVarLengthOutputData<jbyteArray>(byteArray,
-													   totalSizeInBytes,
-													   dataSizeInBytes);
+		JniHelper::ThrowOnJavaException(m_env);
 
-		// Declare a new buffer to hold the return data
-		//
-		*data = new jbyte[totalSizeInBytes];
-		*nullMap = new SQLINTEGER[numRows];
+		if (jArray != nullptr)
+		{
+			jobjectArray byteArray = static_cast<jobjectArray>(jArray);
+
+			// Get the array length
+			//
+			jsize jNumRows = m_env->GetArrayLength(byteArray);
+			numRows = static_cast<SQLULEN>(jNumRows);
+
+			// The required size of the buffer to return back to exthost.
+			//
+			unsigned long long totalSizeInBytes = 0;
+
+			CalculateMaxForVarLengthOutputData<jbyteArray>(byteArray,
+														   totalSizeInBytes,
+														   dataSizeInBytes);
 
-		JniTypeHelper::CopyBinaryOutputData(m_env,
-											byteArray,
-											jNumRows,
-											totalSizeInBytes,
-											static_cast<jbyte*>(*data),
-											*nullMap);
+			// Declare a new buffer to hold the return data
+			//
+			*data = new jbyte[totalSizeInBytes];
+			*nullMap = new SQLINTEGER[numRows];
+
+			JniTypeHelper::CopyBinaryOutputData(m_env,
+												byteArray,
+												jNumRows,
+												totalSizeInBytes,
+												static_cast<jbyte*>(*data),
+												*nullMap);
+		}
 	}
 
 	dataSizeInBytes = max(dataSizeInBytes, 2ul);
@@ -780,6 +1209,11 @@ void JavaDataset::GetDateColumnInternal(
 	*data = nullptr;
 	*nullMap = nullptr;
 
+	if (GetEpochDateColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
 	// Get the column function for this column type
 	//
 	jmethodID method = FindGetColumnMethod(colType);
@@ -810,39 +1244,210 @@ void JavaDataset::GetDateColumnInternal(
 }
 
 //--------------------------------------------------------------------------------------------------
-// Name: JavaDataset::GetNumericColumnInternal
+// Name: JavaDataset::GetEpochDateColumnInternal
 //
 // Description:
-//	Internal function to get the numeric column data.
+//	Internal function to get the date column data from a long array of days since 1970-01-01,
+//	if the Dataset provides the column in that representation.
 //
-void JavaDataset::GetNumericColumnInternal(
-	jint        colId,
-	SQLSMALLINT colType,
-	SQLULEN     &numRows,
-	SQLULEN     &dataSizeInBytes,
-	SQLSMALLINT &decimalDigits,
-	SQLPOINTER  *data,
-	SQLINTEGER  **nullMap)
+// Returns:
+//	false if the Dataset only provides the column as java.sql.Date instances
+//
+bool JavaDataset::GetEpochDateColumnInternal(
+	jint       colId,
+	SQLULEN    &numRows,
+	SQLPOINTER *data,
+	SQLINTEGER **nullMap)
 {
-	LOG("JavaDataset::GetNumericColumnInternal");
+	LOG("JavaDataset::GetEpochDateColumnInternal");
 
 	numRows = 0;
 	*data = nullptr;
 	*nullMap = nullptr;
 
-	// Set the precision and scale
-	//
-	GetColumnPrecision(colId, dataSizeInBytes);
-	GetColumnScale(colId, decimalDigits);
+	jmethodID method = FindOptionalDatasetMethod(x_getEpochDayColumnFuncName,
+												 x_getEpochLongColumnFuncSignature);
 
-	// Get the column function for this column type
-	//
-	jmethodID method = FindGetColumnMethod(colType);
+	if (method == nullptr)
+	{
+		return false;
+	}
 
-	jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
+	jlongArray jArray = static_cast<jlongArray>(m_env->CallObjectMethod(m_object, method, colId));
 	JniHelper::ThrowOnJavaException(m_env);
 
-	if (jArray != nullptr)
+	if (jArray == nullptr)
+	{
+		return false;
+	}
+
+	jsize jNumRows = m_env->GetArrayLength(jArray);
+	numRows = static_cast<SQLULEN>(jNumRows);
+
+	SQLULEN numNullMapRows = 0;
+	GetColumnNullMap(colId, numRows, numNullMapRows, nullMap);
+
+	if (numNullMapRows != 0 && numNullMapRows != numRows)
+	{
+		throw runtime_error(
+				"Number of rows in null map does not equal number of rows in column data");
+	}
+
+	*data = new SQL_DATE_STRUCT[numRows];
+
+	if (numRows > 0)
+	{
+		jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jArray);
+
+		if (jData == nullptr)
+		{
+			throw runtime_error("Could not get elements for output column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyEpochDateOutputData(jData,
+											   jNumRows,
+											   static_cast<SQL_DATE_STRUCT*>(*data),
+											   *nullMap);
+
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jArray, jData);
+	}
+
+	m_env->DeleteLocalRef(jArray);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetEpochTimestampColumnInternal
+//
+// Description:
+//	Internal function to get the timestamp column data from a long array of seconds since
+//	1970-01-01 00:00:00 and an int array of nanoseconds, if the Dataset provides the column in
+//	that representation.
+//
+// Returns:
+//	false if the Dataset only provides the column as java.sql.Timestamp instances
+//
+bool JavaDataset::GetEpochTimestampColumnInternal(
+	jint       colId,
+	SQLULEN    &numRows,
+	SQLPOINTER *data,
+	SQLINTEGER **nullMap)
+{
+	LOG("JavaDataset::GetEpochTimestampColumnInternal");
+
+	numRows = 0;
+	*data = nullptr;
+	*nullMap = nullptr;
+
+	jmethodID secondsMethod = FindOptionalDatasetMethod(x_getEpochSecondColumnFuncName,
+														x_getEpochLongColumnFuncSignature);
+	jmethodID nanosMethod = FindOptionalDatasetMethod(x_getNanosColumnFuncName,
+													  x_getNanosColumnFuncSignature);
+
+	if (secondsMethod == nullptr || nanosMethod == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jSecondsArray =
+		static_cast<jlongArray>(m_env->CallObjectMethod(m_object, secondsMethod, colId));
+	JniHelper::ThrowOnJavaException(m_env);
+
+	if (jSecondsArray == nullptr)
+	{
+		return false;
+	}
+
+	jintArray jNanosArray =
+		static_cast<jintArray>(m_env->CallObjectMethod(m_object, nanosMethod, colId));
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jsize jNumRows = m_env->GetArrayLength(jSecondsArray);
+	numRows = static_cast<SQLULEN>(jNumRows);
+
+	if (jNanosArray == nullptr || m_env->GetArrayLength(jNanosArray) != jNumRows)
+	{
+		throw runtime_error("Number of rows in nanoseconds does not equal number of rows in "
+							"output column ID " + to_string(colId));
+	}
+
+	SQLULEN numNullMapRows = 0;
+	GetColumnNullMap(colId, numRows, numNullMapRows, nullMap);
+
+	if (numNullMapRows != 0 && numNullMapRows != numRows)
+	{
+		throw runtime_error(
+				"Number of rows in null map does not equal number of rows in column data");
+	}
+
+	*data = new SQL_TIMESTAMP_STRUCT[numRows];
+
+	if (numRows > 0)
+	{
+		jlong *jSeconds = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jSecondsArray);
+		jint *jNanos = JniTypeHelper::GetJniArrayElems<jintArray, jint>(m_env, jNanosArray);
+
+		if (jSeconds == nullptr || jNanos == nullptr)
+		{
+			throw runtime_error("Could not get elements for output column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyEpochTimestampOutputData(jSeconds,
+													jNanos,
+													jNumRows,
+													static_cast<SQL_TIMESTAMP_STRUCT*>(*data),
+													*nullMap);
+
+		JniTypeHelper::ReleaseJniArrayElems<jintArray, jint>(m_env, jNanosArray, jNanos);
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jSecondsArray, jSeconds);
+	}
+
+	m_env->DeleteLocalRef(jNanosArray);
+	m_env->DeleteLocalRef(jSecondsArray);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetNumericColumnInternal
+//
+// Description:
+//	Internal function to get the numeric column data.
+//
+void JavaDataset::GetNumericColumnInternal(
+	jint        colId,
+	SQLSMALLINT colType,
+	SQLULEN     &numRows,
+	SQLULEN     &dataSizeInBytes,
+	SQLSMALLINT &decimalDigits,
+	SQLPOINTER  *data,
+	SQLINTEGER  **nullMap)
+{
+	LOG("JavaDataset::GetNumericColumnInternal");
+
+	numRows = 0;
+	*data = nullptr;
+	*nullMap = nullptr;
+
+	// Set the precision and scale
+	//
+	GetColumnPrecision(colId, dataSizeInBytes);
+	GetColumnScale(colId, decimalDigits);
+
+	if (GetUnscaledNumericColumnInternal(colId, dataSizeInBytes, decimalDigits, numRows, data, nullMap))
+	{
+		return;
+	}
+
+	// Get the column function for this column type
+	//
+	jmethodID method = FindGetColumnMethod(colType);
+
+	jobject jArray = m_env->CallObjectMethod(m_object, method, colId);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	if (jArray != nullptr)
 	{
 		jobjectArray bigDecimalArray = static_cast<jobjectArray>(jArray);
 
@@ -867,6 +1472,86 @@ void JavaDataset::GetNumericColumnInternal(
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetUnscaledNumericColumnInternal
+//
+// Description:
+//	Internal function to get the numeric column data from a long array of unscaled values, if the
+//	Dataset provides the column in that representation.
+//
+// Returns:
+//	false if the Dataset only provides the column as BigDecimal instances
+//
+bool JavaDataset::GetUnscaledNumericColumnInternal(
+	jint        colId,
+	SQLULEN     colPrecision,
+	SQLSMALLINT colScale,
+	SQLULEN     &numRows,
+	SQLPOINTER  *data,
+	SQLINTEGER  **nullMap)
+{
+	LOG("JavaDataset::GetUnscaledNumericColumnInternal");
+
+	numRows = 0;
+	*data = nullptr;
+	*nullMap = nullptr;
+
+	jmethodID method = FindOptionalDatasetMethod(x_getUnscaledNumericColumnFuncName,
+												 x_getUnscaledNumericColumnFuncSignature);
+
+	// Datasets without the function only support the BigDecimal representation
+	//
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jArray = static_cast<jlongArray>(m_env->CallObjectMethod(m_object, method, colId));
+	JniHelper::ThrowOnJavaException(m_env);
+
+	if (jArray == nullptr)
+	{
+		return false;
+	}
+
+	jsize jNumRows = m_env->GetArrayLength(jArray);
+	numRows = static_cast<SQLULEN>(jNumRows);
+
+	SQLULEN numNullMapRows = 0;
+	GetColumnNullMap(colId, numRows, numNullMapRows, nullMap);
+
+	if (numNullMapRows != 0 && numNullMapRows != numRows)
+	{
+		throw runtime_error(
+				"Number of rows in null map does not equal number of rows in column data");
+	}
+
+	*data = new SQL_NUMERIC_STRUCT[numRows];
+
+	if (numRows > 0)
+	{
+		jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jArray);
+
+		if (jData == nullptr)
+		{
+			throw runtime_error("Could not get elements for output column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyUnscaledNumericOutputData(jData,
+													 jNumRows,
+													 static_cast<SQLCHAR>(colPrecision),
+													 colScale,
+													 static_cast<SQL_NUMERIC_STRUCT*>(*data),
+													 *nullMap);
+
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jArray, jData);
+	}
+
+	m_env->DeleteLocalRef(jArray);
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::GetTimestampColumnInternal
 //
@@ -893,6 +1578,11 @@ void JavaDataset::GetTimestampColumnInternal(
 	//
 	GetColumnScale(colId, decimalDigits);
 
+	if (GetEpochTimestampColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
 	// Get the column function for this column type
 	//
 	jmethodID method = FindGetColumnMethod(colType);
@@ -926,15 +1616,73 @@ void JavaDataset::GetTimestampColumnInternal(
 // Name: JavaDataset::GetColumnNullMap
 //
 // Description:
-//	Calls getColumnNullMap on the Dataset and creates a SQL null map
-//
-void JavaDataset::GetColumnNullMap(jint colId, SQLULEN &numRows, SQLINTEGER **nullMap)
+//	Calls getColumnNullMap on the Dataset and creates a SQL null map. Datasets supporting null
+//	bitmaps are asked for the bitmap of the numDataRows rows of the column instead, which is null
+//	when no row is null, so that no null map is created. A bitmap that does not have the number of
+//	elements of numDataRows rows, or that sets rows past numDataRows, is rejected.
+//
+void JavaDataset::GetColumnNullMap(
+	jint       colId,
+	SQLULEN    numDataRows,
+	SQLULEN    &numRows,
+	SQLINTEGER **nullMap)
 {
 	LOG("JavaDataset::GetColumnNullMap");
 
 	numRows = 0;
 	*nullMap = nullptr;
 
+	if (m_getColumnNullBitmapMethod != nullptr)
+	{
+		jlongArray jNullBitmap = static_cast<jlongArray>(
+			m_env->CallObjectMethod(m_object, m_getColumnNullBitmapMethod, colId));
+
+		JniHelper::ThrowOnJavaException(m_env);
+
+		if (jNullBitmap != nullptr)
+		{
+			SQLULEN numWords = static_cast<SQLULEN>(m_env->GetArrayLength(jNullBitmap));
+
+			if (numWords != (numDataRows + 63) / 64)
+			{
+				throw runtime_error(
+						"Number of rows in null map does not equal number of rows in column data");
+			}
+
+			unique_ptr<SQLINTEGER[]> sqlNullMap(new SQLINTEGER[numDataRows]);
+
+			jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jNullBitmap);
+			JniHelper::ThrowOnJavaException(m_env);
+
+			if (jData == nullptr)
+			{
+				throw runtime_error("Failed to create null map for column ID " + to_string(colId));
+			}
+
+			bool hasRowsPastEnd = JniTypeHelper::HasNullBitmapRowsPastEnd(jData, numDataRows);
+
+			if (!hasRowsPastEnd)
+			{
+				JniTypeHelper::CopyNullBitmapOutputData(jData, numDataRows, sqlNullMap.get());
+			}
+
+			JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jNullBitmap, jData);
+
+			m_env->DeleteLocalRef(jNullBitmap);
+
+			if (hasRowsPastEnd)
+			{
+				throw runtime_error(
+						"Null bitmap sets rows past the number of rows in column data");
+			}
+
+			numRows = numDataRows;
+			*nullMap = sqlNullMap.release();
+		}
+
+		return;
+	}
+
 	jmethodID method = FindDatasetMethod("getColumnNullMap", "(I)[Z");
 
 	jbooleanArray jArray =
@@ -1008,7 +1756,13 @@ void JavaDataset::AddColumns(
 			colData = data[i];
 		}
 
-		AddColumnMetadata(i, colNames[i], colTypes[i], colSizes[i], decimalDigits[i]);
+		// The metadata is only added for the first batch of a stream, the following batches
+		// replace the column data of the same dataset
+		//
+		if (!m_hasColumnMetadata)
+		{
+			AddColumnMetadata(i, colNames[i], colTypes[i], colSizes[i], decimalDigits[i]);
+		}
 
 		AddColumn(i,
 				  colTypes[i],
@@ -1018,6 +1772,64 @@ void JavaDataset::AddColumns(
 				  colData,
 				  colNullMap);
 	}
+
+	m_hasColumnMetadata = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetColumnsSizeInBytes
+//
+// Description:
+//	Gets the size in bytes of the data of the columns exchanged with ExtHost. Fixed width columns
+//	take the size of their type for every row, and variable length columns the sum of the lengths
+//	of their rows.
+//
+SQLULEN JavaDataset::GetColumnsSizeInBytes(
+	SQLUSMALLINT              numCols,
+	SQLULEN                   numRows,
+	const vector<SQLSMALLINT> &colTypes,
+	SQLINTEGER *const         *nullMaps)
+{
+	SQLULEN sizeInBytes = 0;
+
+	for (SQLUSMALLINT i = 0; i < numCols; ++i)
+	{
+		SQLULEN rowSize = 0;
+
+		switch (colTypes[i])
+		{
+		case SQL_C_CHAR:
+		case SQL_C_WCHAR:
+		case SQL_C_BINARY:
+			for (SQLULEN row = 0; nullMaps[i] != nullptr && row < numRows; ++row)
+			{
+				sizeInBytes += nullMaps[i][row] > 0 ? nullMaps[i][row] : 0;
+			}
+			break;
+		case SQL_C_TYPE_DATE:
+			rowSize = sizeof(SQL_DATE_STRUCT);
+			break;
+		case SQL_C_TYPE_TIMESTAMP:
+			rowSize = sizeof(SQL_TIMESTAMP_STRUCT);
+			break;
+		case SQL_C_NUMERIC:
+			rowSize = sizeof(SQL_NUMERIC_STRUCT);
+			break;
+		case SQL_C_GUID:
+			rowSize = sizeof(SQLGUID);
+			break;
+		default:
+			unordered_map<SQLSMALLINT, SQLULEN>::const_iterator it =
+				x_columnBufferTypeSizeMap.find(colTypes[i]);
+
+			rowSize = it != x_columnBufferTypeSizeMap.end() ? it->second : 0;
+			break;
+		}
+
+		sizeInBytes += rowSize * numRows;
+	}
+
+	return sizeInBytes;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1034,7 +1846,9 @@ void JavaDataset::GetColumns(
 	vector<SQLSMALLINT> &colDecimalDigits,
 	vector<SQLSMALLINT> &nullableCols,
 	vector<SQLPOINTER>  &data,
-	vector<SQLINTEGER*> &nullMaps)
+	vector<SQLINTEGER*> &nullMaps,
+	vector<jobject>     &dataBuffers,
+	vector<jobject>     &nullMapBuffers)
 {
 	LOG("JavaDataset::GetColumns");
 
@@ -1046,6 +1860,8 @@ void JavaDataset::GetColumns(
 	nullableCols.clear();
 	data.clear();
 	nullMaps.clear();
+	dataBuffers.clear();
+	nullMapBuffers.clear();
 
 	jmethodID method = FindDatasetMethod("getColumnCount", "()I");
 
@@ -1074,8 +1890,18 @@ void JavaDataset::GetColumns(
 		SQLULEN colSize = 0;
 		SQLSMALLINT colType = 0;
 		SQLSMALLINT colScale = 0;
+		jobject colDataBuffer = nullptr;
+		jobject colNullMapBuffer = nullptr;
 
-		GetColumn(i, colType, colSize, colScale, numRows, &colData, &colNullMap);
+		// Columns written by the executor into direct buffers are returned without copying,
+		// all other columns are copied out of their Java arrays.
+		//
+		if (!m_isDirectBufferDataset ||
+			!GetColumnBuffer(i, colType, colSize, numRows, &colData, &colNullMap,
+				colDataBuffer, colNullMapBuffer))
+		{
+			GetColumn(i, colType, colSize, colScale, numRows, &colData, &colNullMap);
+		}
 
 		// Add the column to the results
 		//
@@ -1085,6 +1911,8 @@ void JavaDataset::GetColumns(
 
 		data.push_back(colData);
 		nullMaps.push_back(colNullMap);
+		dataBuffers.push_back(colDataBuffer);
+		nullMapBuffers.push_back(colNullMapBuffer);
 		nullableCols.push_back(colNullMap != nullptr ? SQL_NULLABLE : SQL_NO_NULLS);
 	}
 }
@@ -1093,7 +1921,8 @@ void JavaDataset::GetColumns(
 // Name: JavaDataset::AddColumnInternal
 //
 // Description:
-//	Internal template function to add the column data.
+//	Internal template function to add the column data. The data is copied straight into the Java
+//	array through a critical region, avoiding the extra copy Get<Type>ArrayElements may make.
 //
 template<typename jArrayType, typename jType, typename cType>
 void JavaDataset::AddColumnInternal(
@@ -1111,13 +1940,13 @@ void JavaDataset::AddColumnInternal(
 	jType *jData = nullptr;
 	jbooleanArray jNullMapArray = nullptr;
 
-	jArray = JniTypeHelper::CreateJniArray<jArrayType>(m_env, numRows);
-	JniHelper::ThrowOnJavaException(m_env);
+	jArray = GetReusableArray<jArrayType>(m_columnArrays, colId, numRows);
 
-	jData = JniTypeHelper::GetJniArrayElems<jArrayType, jType>(m_env, jArray);
+	jData = static_cast<jType*>(m_env->GetPrimitiveArrayCritical(jArray, nullptr));
 	if (jData != nullptr)
 	{
-		// Copy the data into the java array and release
+		// Copy the data into the java array and release. No JNI function may be called before
+		// the critical region is released.
 		//
 		JniTypeHelper::CopyInputData<jType, cType>(m_env,
 												   numRows,
@@ -1125,31 +1954,34 @@ void JavaDataset::AddColumnInternal(
 												   nullMap,
 												   jData);
 
-		JniTypeHelper::ReleaseJniArrayElems<jArrayType, jType>(m_env, jArray, jData);
+		m_env->ReleasePrimitiveArrayCritical(jArray, jData, 0);
 
 		// Create a corresponding null map for the current column
 		//
 		if (nullMap != nullptr)
 		{
-			jNullMapArray = CreateJniNullMap(numRows, nullMap);
-			assert(jNullMapArray != nullptr);
+			jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+			assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
 		}
 
 		jmethodID method = FindAddColumnMethod(colType);
 
 		m_env->CallVoidMethod(m_object, method, colId, jArray, jNullMapArray);
 		JniHelper::ThrowOnJavaException(m_env);
+
+		SetJniNullBitmap(colId, numRows, nullMap);
 	}
 }
 
 //--------------------------------------------------------------------------------------------------
-// Name: JavaDataset::AddStringColumnInternal
+// Name: JavaDataset::AddColumnBufferInternal
 //
 // Description:
-//	Internal template function to add the string column data.
+//	Internal template function to add a fixed width column without copying it. The ODBC data and
+//	null map are wrapped in direct buffers that are only valid for the duration of Execute.
 //
-template<bool isUTF8>
-void JavaDataset::AddStringColumnInternal(
+template<typename cType>
+void JavaDataset::AddColumnBufferInternal(
 	jint             colId,
 	SQLSMALLINT      colType,
 	SQLULEN          colSize,
@@ -1158,31 +1990,54 @@ void JavaDataset::AddStringColumnInternal(
 	SQLPOINTER       data,
 	const SQLINTEGER *nullMap)
 {
-	LOG("JavaDataset::AddStringColumnInternal");
+	LOG("JavaDataset::AddColumnBufferInternal");
 
-	jclass stringClass = m_env->FindClass("java/lang/String");
-	jobjectArray jArray = m_env->NewObjectArray(numRows, stringClass, nullptr);
-	JniHelper::ThrowOnJavaException(m_env);
+	jobject jDataBuffer = nullptr;
+	jobject jNullMapBuffer = nullptr;
 
-	JniTypeHelper::CopyStringInputData<isUTF8>(m_env,
-											   numRows,
-											   data,
-											   nullMap,
-											   jArray);
+	if (data != nullptr && numRows > 0)
+	{
+		jDataBuffer = m_env->NewDirectByteBuffer(
+			data,
+			static_cast<jlong>(numRows) * sizeof(cType));
 
-	jmethodID method = FindAddColumnMethod(colType);
+		JniHelper::ThrowOnJavaException(m_env);
 
-	m_env->CallVoidMethod(m_object, method, colId, jArray);
+		if (jDataBuffer == nullptr)
+		{
+			throw runtime_error("The JVM does not support direct buffer access, could not add column ID " +
+								to_string(colId));
+		}
+	}
+
+	if (nullMap != nullptr && numRows > 0)
+	{
+		jNullMapBuffer = m_env->NewDirectByteBuffer(
+			const_cast<SQLINTEGER*>(nullMap),
+			static_cast<jlong>(numRows) * sizeof(SQLINTEGER));
+
+		JniHelper::ThrowOnJavaException(m_env);
+
+		if (jNullMapBuffer == nullptr)
+		{
+			throw runtime_error("The JVM does not support direct buffer access, could not add column ID " +
+								to_string(colId));
+		}
+	}
+
+	jmethodID method = FindDatasetMethod(x_addColumnBufferFuncName, x_addColumnBufferFuncSignature);
+
+	m_env->CallVoidMethod(m_object, method, colId, numRows, jDataBuffer, jNullMapBuffer);
 	JniHelper::ThrowOnJavaException(m_env);
 }
 
 //--------------------------------------------------------------------------------------------------
-// Name: JavaDataset::AddGuidColumnInternal
+// Name: JavaDataset::AddStringColumnInternal
 //
 // Description:
-//	Internal function to add the guid column data.
+//	Internal function to add the Unicode string column data.
 //
-void JavaDataset::AddGuidColumnInternal(
+void JavaDataset::AddStringColumnInternal(
 	jint             colId,
 	SQLSMALLINT      colType,
 	SQLULEN          colSize,
@@ -1191,17 +2046,17 @@ void JavaDataset::AddGuidColumnInternal(
 	SQLPOINTER       data,
 	const SQLINTEGER *nullMap)
 {
-	LOG("JavaDataset::AddGuidColumnInternal");
+	LOG("JavaDataset::AddStringColumnInternal");
 
 	jclass stringClass = m_env->FindClass("java/lang/String");
 	jobjectArray jArray = m_env->NewObjectArray(numRows, stringClass, nullptr);
 	JniHelper::ThrowOnJavaException(m_env);
 
-	JniTypeHelper::CopyGuidInputData(m_env,
-									 numRows,
-									 data,
-									 nullMap,
-									 jArray);
+	JniTypeHelper::CopyStringInputData<false>(m_env,
+											  numRows,
+											  data,
+											  nullMap,
+											  jArray);
 
 	jmethodID method = FindAddColumnMethod(colType);
 
@@ -1210,12 +2065,16 @@ void JavaDataset::AddGuidColumnInternal(
 }
 
 //--------------------------------------------------------------------------------------------------
-// Name: JavaDataset::AddBinaryColumnInternal
+// Name: JavaDataset::AddUtf8StringColumnInternal
 //
 // Description:
-//	Internal function to add the binary column data.
+//	Internal function to add the UTF-8 string column data.
+//	The whole column is sent as one byte array holding the concatenated UTF-8 bytes and an int
+//	array holding the length of each row (SQL_NULL_DATA for null rows). The strings are decoded
+//	on the Java side, which avoids creating a Java string through JNI for every row.
+//	Datasets of older SDKs without this method get the column as a String array instead.
 //
-void JavaDataset::AddBinaryColumnInternal(
+void JavaDataset::AddUtf8StringColumnInternal(
 	jint             colId,
 	SQLSMALLINT      colType,
 	SQLULEN          colSize,
@@ -1224,24 +2083,279 @@ void JavaDataset::AddBinaryColumnInternal(
 	SQLPOINTER       data,
 	const SQLINTEGER *nullMap)
 {
-	LOG("JavaDataset::AddBinaryColumnInternal");
+	LOG("JavaDataset::AddUtf8StringColumnInternal");
 
-	jclass byteArrayClass = m_env->FindClass("[B");
-	jobjectArray jArray = m_env->NewObjectArray(numRows, byteArrayClass, nullptr);
-	JniHelper::ThrowOnJavaException(m_env);
+	jmethodID method = FindOptionalDatasetMethod(x_addUtf8StringColumnFuncName,
+												 x_addUtf8StringColumnFuncSignature);
 
-	JniTypeHelper::CopyBinaryInputData(m_env,
-									   numRows,
-									   data,
-									   nullMap,
-									   jArray);
+	if (method == nullptr)
+	{
+		jclass stringClass = m_env->FindClass("java/lang/String");
+		jobjectArray jArray = m_env->NewObjectArray(numRows, stringClass, nullptr);
+		JniHelper::ThrowOnJavaException(m_env);
 
-	jmethodID method = FindAddColumnMethod(colType);
+		JniTypeHelper::CopyStringInputData<true>(m_env,
+												 numRows,
+												 data,
+												 nullMap,
+												 jArray);
+
+		m_env->CallVoidMethod(m_object, FindAddColumnMethod(colType), colId, jArray);
+		JniHelper::ThrowOnJavaException(m_env);
+		return;
+	}
+
+	// The total length (in bytes) of all the strings in the column
+	//
+	jsize totalSizeInBytes = 0;
+
+	if (data != nullptr && nullMap != nullptr)
+	{
+		for (jsize i = 0; i < numRows; ++i)
+		{
+			if (nullMap[i] != SQL_NULL_DATA)
+			{
+				totalSizeInBytes += nullMap[i];
+			}
+		}
+	}
+
+	jbyteArray jByteArray = m_env->NewByteArray(totalSizeInBytes);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jintArray jLengthArray = JniTypeHelper::CreateJniArray<jintArray>(m_env, numRows);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	JniTypeHelper::CopyUtf8StringInputData(m_env,
+										   numRows,
+										   data,
+										   nullMap,
+										   totalSizeInBytes,
+										   jByteArray,
+										   jLengthArray);
+
+	m_env->CallVoidMethod(m_object, method, colId, jByteArray, jLengthArray);
+	JniHelper::ThrowOnJavaException(m_env);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddGuidColumnInternal
+//
+// Description:
+//	Internal function to add the guid column data.
+//
+void JavaDataset::AddGuidColumnInternal(
+	jint             colId,
+	SQLSMALLINT      colType,
+	SQLULEN          colSize,
+	SQLSMALLINT      decimalDigits,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddGuidColumnInternal");
+
+	if (AddGuidBitsColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
+	jclass stringClass = m_env->FindClass("java/lang/String");
+	jobjectArray jArray = m_env->NewObjectArray(numRows, stringClass, nullptr);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	JniTypeHelper::CopyGuidInputData(m_env,
+									 numRows,
+									 data,
+									 nullMap,
+									 jArray);
+
+	jmethodID method = FindAddColumnMethod(colType);
+
+	m_env->CallVoidMethod(m_object, method, colId, jArray);
+	JniHelper::ThrowOnJavaException(m_env);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddBinaryColumnInternal
+//
+// Description:
+//	Internal function to add the binary column data.
+//
+void JavaDataset::AddBinaryColumnInternal(
+	jint             colId,
+	SQLSMALLINT      colType,
+	SQLULEN          colSize,
+	SQLSMALLINT      decimalDigits,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddBinaryColumnInternal");
+
+	if (AddOffsetBinaryColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
+	jclass byteArrayClass = m_env->FindClass("[B");
+	jobjectArray jArray = m_env->NewObjectArray(numRows, byteArrayClass, nullptr);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	JniTypeHelper::CopyBinaryInputData(m_env,
+									   numRows,
+									   data,
+									   nullMap,
+									   jArray);
+
+	jmethodID method = FindAddColumnMethod(colType);
 
 	m_env->CallVoidMethod(m_object, method, colId, jArray);
 	JniHelper::ThrowOnJavaException(m_env);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddGuidBitsColumnInternal
+//
+// Description:
+//	Internal function to add the guid column data as long arrays of the most and least
+//	significant 64 bits of each GUID, instead of formatting a Java string per row through JNI.
+//
+// Returns:
+//	false if the Dataset does not support GUID columns as bits
+//
+bool JavaDataset::AddGuidBitsColumnInternal(
+	jint             colId,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddGuidBitsColumnInternal");
+
+	jmethodID method = FindOptionalDatasetMethod(x_addGuidBitsColumnFuncName,
+												 x_addGuidBitsColumnFuncSignature);
+
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jMostSigBitsArray = GetReusableArray<jlongArray>(m_columnArrays, colId, numRows);
+	jlongArray jLeastSigBitsArray = GetReusableArray<jlongArray>(m_secondaryArrays, colId, numRows);
+
+	if (numRows > 0 && data != nullptr)
+	{
+		jlong *jMostSigBits =
+			JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jMostSigBitsArray);
+		jlong *jLeastSigBits =
+			JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jLeastSigBitsArray);
+
+		if (jMostSigBits == nullptr || jLeastSigBits == nullptr)
+		{
+			throw runtime_error("Could not get elements for input column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyGuidBitsInputData(numRows, data, nullMap, jMostSigBits, jLeastSigBits);
+
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jMostSigBitsArray, jMostSigBits);
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env,
+															  jLeastSigBitsArray,
+															  jLeastSigBits);
+	}
+
+	jbooleanArray jNullMapArray = nullptr;
+
+	if (nullMap != nullptr)
+	{
+		jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+		assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
+	}
+
+	m_env->CallVoidMethod(m_object,
+						  method,
+						  colId,
+						  jMostSigBitsArray,
+						  jLeastSigBitsArray,
+						  jNullMapArray);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	SetJniNullBitmap(colId, numRows, nullMap);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddOffsetBinaryColumnInternal
+//
+// Description:
+//	Internal function to add the binary column data as one byte array holding the concatenated
+//	values and an int array holding the offset of each row, instead of creating a byte array per
+//	row through JNI. Null rows are marked by the null map.
+//
+// Returns:
+//	false if the Dataset does not support binary columns with offsets
+//
+bool JavaDataset::AddOffsetBinaryColumnInternal(
+	jint             colId,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddOffsetBinaryColumnInternal");
+
+	// The lengths of the values are in the null map, without it every value is null and the
+	// column is added as an array of nulls
+	//
+	if (data == nullptr || nullMap == nullptr)
+	{
+		return false;
+	}
+
+	jmethodID method = FindOptionalDatasetMethod(x_addOffsetBinaryColumnFuncName,
+												 x_addOffsetBinaryColumnFuncSignature);
+
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	// The total length (in bytes) of all the values in the column
+	//
+	jsize totalSizeInBytes = 0;
+
+	for (jsize i = 0; i < numRows; ++i)
+	{
+		if (nullMap[i] != SQL_NULL_DATA)
+		{
+			totalSizeInBytes += nullMap[i];
+		}
+	}
+
+	jbyteArray jByteArray = m_env->NewByteArray(totalSizeInBytes);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	jintArray jOffsetArray = JniTypeHelper::CreateJniArray<jintArray>(m_env, numRows + 1);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	JniTypeHelper::CopyOffsetBinaryInputData(m_env,
+											 numRows,
+											 data,
+											 nullMap,
+											 totalSizeInBytes,
+											 jByteArray,
+											 jOffsetArray);
+
+	jbooleanArray jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+	assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
+
+	m_env->CallVoidMethod(m_object, method, colId, jByteArray, jOffsetArray, jNullMapArray);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	SetJniNullBitmap(colId, numRows, nullMap);
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::AddDateColumnInternal
 //
@@ -1259,6 +2373,11 @@ void JavaDataset::AddDateColumnInternal(
 {
 	LOG("JavaDataset::AddDateColumnInternal");
 
+	if (AddEpochDateColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
 	jclass dateClass = m_env->FindClass("java/sql/Date");
 
 	jobjectArray jArray = m_env->NewObjectArray(numRows, dateClass, nullptr);
@@ -1277,6 +2396,64 @@ void JavaDataset::AddDateColumnInternal(
 	JniHelper::ThrowOnJavaException(m_env);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddEpochDateColumnInternal
+//
+// Description:
+//	Internal function to add the date column data as a long array of days since 1970-01-01,
+//	instead of creating a java.sql.Date instance per row through JNI.
+//
+// Returns:
+//	false if the Dataset does not support epoch based date columns
+//
+bool JavaDataset::AddEpochDateColumnInternal(
+	jint             colId,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddEpochDateColumnInternal");
+
+	jmethodID method = FindOptionalDatasetMethod(x_addEpochDateColumnFuncName,
+												 x_addEpochDateColumnFuncSignature);
+
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jArray = GetReusableArray<jlongArray>(m_columnArrays, colId, numRows);
+
+	if (numRows > 0 && data != nullptr)
+	{
+		jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jArray);
+
+		if (jData == nullptr)
+		{
+			throw runtime_error("Could not get elements for input column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyEpochDateInputData(numRows, data, nullMap, jData);
+
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jArray, jData);
+	}
+
+	jbooleanArray jNullMapArray = nullptr;
+
+	if (nullMap != nullptr)
+	{
+		jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+		assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
+	}
+
+	m_env->CallVoidMethod(m_object, method, colId, jArray, jNullMapArray);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	SetJniNullBitmap(colId, numRows, nullMap);
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::AddNumericColumnInternal
 //
@@ -1294,6 +2471,12 @@ void JavaDataset::AddNumericColumnInternal(
 {
 	LOG("JavaDataset::AddNumericColumnInternal");
 
+	if (colSize <= x_maxUnscaledNumericPrecision &&
+		AddUnscaledNumericColumnInternal(colId, decimalDigits, numRows, data, nullMap))
+	{
+		return;
+	}
+
 	jclass bigDecimalClass = m_env->FindClass("java/math/BigDecimal");
 
 	jobjectArray jArray = m_env->NewObjectArray(numRows, bigDecimalClass, nullptr);
@@ -1313,6 +2496,77 @@ void JavaDataset::AddNumericColumnInternal(
 	JniHelper::ThrowOnJavaException(m_env);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddUnscaledNumericColumnInternal
+//
+// Description:
+//	Internal function to add the numeric column data as a long array of unscaled values, so the
+//	Dataset can create all the BigDecimal instances in one call instead of two JNI object
+//	allocations per row.
+//
+// Returns:
+//	false if the Dataset does not support unscaled numeric columns, or if a value does not fit
+//	in a long, and nothing was added
+//
+bool JavaDataset::AddUnscaledNumericColumnInternal(
+	jint             colId,
+	SQLSMALLINT      decimalDigits,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddUnscaledNumericColumnInternal");
+
+	jmethodID method = FindOptionalDatasetMethod(x_addUnscaledNumericColumnFuncName,
+												 x_addUnscaledNumericColumnFuncSignature);
+
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jArray = GetReusableArray<jlongArray>(m_columnArrays, colId, numRows);
+
+	bool result = true;
+
+	if (numRows > 0 && data != nullptr)
+	{
+		jlong *jData = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jArray);
+
+		if (jData == nullptr)
+		{
+			throw runtime_error("Could not get elements for input column ID " + to_string(colId));
+		}
+
+		result = JniTypeHelper::CopyUnscaledNumericInputData(numRows, data, nullMap, jData);
+
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jArray, jData);
+	}
+
+	if (result)
+	{
+		jbooleanArray jNullMapArray = nullptr;
+
+		if (nullMap != nullptr)
+		{
+			jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+			assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
+		}
+
+		m_env->CallVoidMethod(m_object,
+							  method,
+							  colId,
+							  jArray,
+							  static_cast<jint>(decimalDigits),
+							  jNullMapArray);
+		JniHelper::ThrowOnJavaException(m_env);
+
+		SetJniNullBitmap(colId, numRows, nullMap);
+	}
+
+	return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::AddTimestampColumnInternal
 //
@@ -1330,6 +2584,11 @@ void JavaDataset::AddTimestampColumnInternal(
 {
 	LOG("JavaDataset::AddTimestampColumnInternal");
 
+	if (AddEpochTimestampColumnInternal(colId, numRows, data, nullMap))
+	{
+		return;
+	}
+
 	jclass timestampClass = m_env->FindClass("java/sql/Timestamp");
 
 	jobjectArray jArray = m_env->NewObjectArray(numRows, timestampClass, nullptr);
@@ -1348,6 +2607,68 @@ void JavaDataset::AddTimestampColumnInternal(
 	JniHelper::ThrowOnJavaException(m_env);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::AddEpochTimestampColumnInternal
+//
+// Description:
+//	Internal function to add the timestamp column data as a long array of seconds since
+//	1970-01-01 00:00:00 and an int array of nanoseconds, instead of creating a
+//	java.sql.Timestamp instance per row through JNI.
+//
+// Returns:
+//	false if the Dataset does not support epoch based timestamp columns
+//
+bool JavaDataset::AddEpochTimestampColumnInternal(
+	jint             colId,
+	jsize            numRows,
+	SQLPOINTER       data,
+	const SQLINTEGER *nullMap)
+{
+	LOG("JavaDataset::AddEpochTimestampColumnInternal");
+
+	jmethodID method = FindOptionalDatasetMethod(x_addEpochTimestampColumnFuncName,
+												 x_addEpochTimestampColumnFuncSignature);
+
+	if (method == nullptr)
+	{
+		return false;
+	}
+
+	jlongArray jSecondsArray = GetReusableArray<jlongArray>(m_columnArrays, colId, numRows);
+	jintArray jNanosArray = GetReusableArray<jintArray>(m_secondaryArrays, colId, numRows);
+
+	if (numRows > 0 && data != nullptr)
+	{
+		jlong *jSeconds = JniTypeHelper::GetJniArrayElems<jlongArray, jlong>(m_env, jSecondsArray);
+		jint *jNanos = JniTypeHelper::GetJniArrayElems<jintArray, jint>(m_env, jNanosArray);
+
+		if (jSeconds == nullptr || jNanos == nullptr)
+		{
+			throw runtime_error("Could not get elements for input column ID " + to_string(colId));
+		}
+
+		JniTypeHelper::CopyEpochTimestampInputData(numRows, data, nullMap, jSeconds, jNanos);
+
+		JniTypeHelper::ReleaseJniArrayElems<jintArray, jint>(m_env, jNanosArray, jNanos);
+		JniTypeHelper::ReleaseJniArrayElems<jlongArray, jlong>(m_env, jSecondsArray, jSeconds);
+	}
+
+	jbooleanArray jNullMapArray = nullptr;
+
+	if (nullMap != nullptr)
+	{
+		jNullMapArray = CreateJniNullMap(colId, numRows, nullMap);
+		assert(jNullMapArray != nullptr || m_setColumnNullBitmapMethod != nullptr);
+	}
+
+	m_env->CallVoidMethod(m_object, method, colId, jSecondsArray, jNanosArray, jNullMapArray);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	SetJniNullBitmap(colId, numRows, nullMap);
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::AddColumn
 //
@@ -1365,14 +2686,33 @@ void JavaDataset::AddColumn(
 {
 	LOG("JavaDataset::AddColumn");
 
-	AddColumnFnMap::const_iterator it = m_fnAddColumnMap.find(colType);
+	fnAddColumn addColumnFn = nullptr;
 
-	if (it == m_fnAddColumnMap.end())
+	// Fixed width columns of a DirectBufferDataset are added without copying
+	//
+	if (m_isDirectBufferDataset)
 	{
-		throw runtime_error("Unsupported column type encountered");
+		AddColumnFnMap::const_iterator bufferIt = m_fnAddColumnBufferMap.find(colType);
+
+		if (bufferIt != m_fnAddColumnBufferMap.end())
+		{
+			addColumnFn = bufferIt->second;
+		}
 	}
 
-	(this->*it->second)(
+	if (addColumnFn == nullptr)
+	{
+		AddColumnFnMap::const_iterator it = m_fnAddColumnMap.find(colType);
+
+		if (it == m_fnAddColumnMap.end())
+		{
+			throw runtime_error("Unsupported column type encountered");
+		}
+
+		addColumnFn = it->second;
+	}
+
+	(this->*addColumnFn)(
 		static_cast<jint>(colId),
 		colType,
 		colSize,
@@ -1382,6 +2722,124 @@ void JavaDataset::AddColumn(
 		nullMap);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaDataset::GetColumnBuffer
+//
+// Description:
+//	Gets a fixed width column that the executor wrote into direct buffers of a
+//	DirectBufferDataset. The returned data and null map point into the buffers, which are kept
+//	alive by the returned global references until the caller deletes them.
+//
+// Returns:
+//	false if the column is not an output direct buffer column and has to be copied instead.
+//
+bool JavaDataset::GetColumnBuffer(
+	jint        colId,
+	SQLSMALLINT &colType,
+	SQLULEN     &colSize,
+	SQLULEN     &numRows,
+	SQLPOINTER  *data,
+	SQLINTEGER  **nullMap,
+	jobject     &dataBuffer,
+	jobject     &nullMapBuffer)
+{
+	LOG("JavaDataset::GetColumnBuffer");
+
+	colType = 0;
+	colSize = 0;
+	*data = nullptr;
+	*nullMap = nullptr;
+	dataBuffer = nullptr;
+	nullMapBuffer = nullptr;
+
+	GetColumnType(colId, colType);
+
+	unordered_map<SQLSMALLINT, SQLULEN>::const_iterator it = x_columnBufferTypeSizeMap.find(colType);
+
+	if (it == x_columnBufferTypeSizeMap.end())
+	{
+		return false;
+	}
+
+	jmethodID method = FindDatasetMethod("getOutputColumnBuffer", "(I)Ljava/nio/ByteBuffer;");
+
+	jobject jData = m_env->CallObjectMethod(m_object, method, colId);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	if (jData == nullptr)
+	{
+		return false;
+	}
+
+	method = FindDatasetMethod("getRowCount", "(I)I");
+
+	jint rowCount = m_env->CallIntMethod(m_object, method, colId);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	method = FindDatasetMethod("getOutputColumnNullBuffer", "(I)Ljava/nio/ByteBuffer;");
+
+	jobject jNullMap = m_env->CallObjectMethod(m_object, method, colId);
+	JniHelper::ThrowOnJavaException(m_env);
+
+	colSize = it->second;
+	numRows = static_cast<SQLULEN>(rowCount);
+
+	*data = m_env->GetDirectBufferAddress(jData);
+
+	if ((*data == nullptr && numRows > 0) ||
+		m_env->GetDirectBufferCapacity(jData) < static_cast<jlong>(numRows * colSize))
+	{
+		throw runtime_error("Invalid direct buffer for output column ID " + to_string(colId));
+	}
+
+	if (jNullMap != nullptr)
+	{
+		*nullMap = static_cast<SQLINTEGER*>(m_env->GetDirectBufferAddress(jNullMap));
+
+		if ((*nullMap == nullptr && numRows > 0) ||
+			m_env->GetDirectBufferCapacity(jNullMap) <
+				static_cast<jlong>(numRows * sizeof(SQLINTEGER)))
+		{
+			throw runtime_error("Invalid direct null buffer for output column ID " +
+								to_string(colId));
+		}
+
+		nullMapBuffer = m_env->NewGlobalRef(jNullMap);
+
+		if (nullMapBuffer == nullptr)
+		{
+			throw runtime_error("Could not create global reference for null buffer of column ID " +
+								to_string(colId));
+		}
+	}
+
+	dataBuffer = m_env->NewGlobalRef(jData);
+
+	if (dataBuffer == nullptr)
+	{
+		if (nullMapBuffer != nullptr)
+		{
+			m_env->DeleteGlobalRef(nullMapBuffer);
+			nullMapBuffer = nullptr;
+		}
+
+		throw runtime_error("Could not create global reference for buffer of column ID " +
+							to_string(colId));
+	}
+
+	// The buffers are kept alive by the global references, so release the local references
+	// instead of holding them in the caller's local frame, which only has room for GetColumn.
+	//
+	m_env->DeleteLocalRef(jData);
+
+	if (jNullMap != nullptr)
+	{
+		m_env->DeleteLocalRef(jNullMap);
+	}
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaDataset::GetColumn
 //
@@ -12,6 +12,11 @@
 #include "JavaExtensionUtils.h"
 #include "JavaLibraryUtils.h"
 #include "Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <cstring> // Needed for memset in Linux
 
@@ -21,6 +26,26 @@ using namespace std;
 //
 static JavaVM *g_jvm = nullptr;
 
+// Environment variable naming the directory of the class data sharing archives. Class data
+// sharing (AppCDS) is only managed by the extension when it is set.
+//
+const string x_cdsArchiveDirEnvVariable = "JAVA_CDS_ARCHIVE_DIR";
+
+// JVM options for using an existing archive and for creating one when the JVM exits
+//
+const string x_sharedArchiveFileOption = "-XX:SharedArchiveFile";
+const string x_archiveClassesAtExitOption = "-XX:ArchiveClassesAtExit";
+
+// Dynamic class data sharing archives are supported from this Java version on
+//
+const int x_minCdsJavaVersion = 13;
+
+// Path of the archive written by this process, and of the temporary file the JVM writes it to
+// when it is destroyed. Both are empty if no archive is written.
+//
+static string g_cdsArchive;
+static string g_cdsArchiveTemp;
+
 //----------------------------------------------------------------------------
 // Name: JavaExtensionUtils::GetClassPath
 //
@@ -211,6 +236,19 @@ JNIEnv* JavaExtensionUtils::CreateJvm()
 	//
 	string javaOpts = GetEnvVariable("JAVA_OPTS");
 	vector<string> splitOptions = SplitString(javaOpts, ' ');
+
+	string classPath = GetClassPath();
+
+	// Options set for class data sharing in JAVA_OPTS take precedence over the archive
+	// managed by the extension
+	//
+	if (javaOpts.find(x_sharedArchiveFileOption) == string::npos &&
+		javaOpts.find(x_archiveClassesAtExitOption) == string::npos)
+	{
+		vector<string> cdsOptions = GetClassDataSharingOptions(GetJvmPath(), classPath);
+		splitOptions.insert(splitOptions.end(), cdsOptions.begin(), cdsOptions.end());
+	}
+
 	int numOptions = splitOptions.size();
 
 	// Prepare loading for the JVM by declaring the initialization
@@ -220,7 +258,7 @@ JNIEnv* JavaExtensionUtils::CreateJvm()
 	vector<JavaVMOption> options(numOptions + 2); // +2 to make space for classpath and file encoding
 
 	string classPathPrefix = "-Djava.class.path";
-	string optionStringClassPath = classPathPrefix + "=" + GetClassPath();
+	string optionStringClassPath = classPathPrefix + "=" + classPath;
 	options[0].optionString = const_cast<char*>(optionStringClassPath.c_str());
 	options[0].extraInfo = 0;
 
@@ -263,7 +301,15 @@ JNIEnv* JavaExtensionUtils::CreateJvm()
 
 	// Load and initialize Java VM and JNI interface
 	//
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
 	jint rc = fnCreateJvm(&g_jvm, reinterpret_cast<void**>(&result), &vm_args);
+
+	chrono::milliseconds elapsed = chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now() - start);
+
+	LOG("JVM creation took " + to_string(elapsed.count()) + " ms.");
+
 	if (rc == JNI_OK)
 	{
 		// Display JVM version. Since the version is displayed like 0x90000, we right
@@ -304,3 +350,263 @@ void JavaExtensionUtils::CleanupJvm()
 	//
 	UnloadJvm();
 }
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::AttachCurrentThread
+//
+// Description:
+//  Gets the JNI environment of the calling thread. Threads that are not attached to the JVM
+//  yet are attached as daemon threads, so they do not keep the JVM from shutting down.
+//
+// Returns:
+//  Pointer to the JNIEnv of the thread, nullptr if there is no JVM or the thread could not be
+//  attached. attached is set to true if the thread was attached by this call.
+//
+JNIEnv* JavaExtensionUtils::AttachCurrentThread(bool &attached)
+{
+	JNIEnv *env = nullptr;
+	attached = false;
+
+	if (g_jvm != nullptr)
+	{
+		jint rc = g_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_10);
+
+		if (rc == JNI_EDETACHED)
+		{
+			rc = g_jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env), nullptr);
+
+			if (rc == JNI_OK)
+			{
+				attached = true;
+			}
+			else
+			{
+				env = nullptr;
+
+				LOG_ERROR("Failed to attach thread to the Java Virtual Machine. JNI error code: " +
+						  to_string(rc) + ".");
+			}
+		}
+		else if (rc != JNI_OK)
+		{
+			env = nullptr;
+
+			LOG_ERROR("Failed to get the JNI environment of the thread. JNI error code: " +
+					  to_string(rc) + ".");
+		}
+	}
+
+	return env;
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::DetachCurrentThread
+//
+// Description:
+//  Detaches the calling thread from the JVM, releasing all its local references
+//
+void JavaExtensionUtils::DetachCurrentThread()
+{
+	if (g_jvm != nullptr)
+	{
+		g_jvm->DetachCurrentThread();
+	}
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetClassDataSharingOptions
+//
+// Description:
+//  Gets the JVM options for the class data sharing archive of the classpath, so that the
+//  classes of the SDK and the user libraries are mapped from the archive instead of being
+//  loaded and verified on every JVM start. Archives are named after a fingerprint of the JVM
+//  and the classpath, so installing or changing a library leads to a new archive.
+//  If the archive exists it is used. Otherwise, on platforms where the JVM is destroyed at
+//  cleanup, the JVM writes it to a file unique to this process which is renamed to the archive
+//  once the JVM is destroyed, so concurrent sessions never see a partial archive. On other
+//  platforms the archive must be created offline. A stale or incompatible archive is ignored by
+//  the JVM. The options are only used with JDK 13 or later, older JVMs reject them.
+//
+// Returns:
+//  The JVM options, empty if class data sharing is not enabled
+//
+vector<string> JavaExtensionUtils::GetClassDataSharingOptions(
+	const string &jvmPath,
+	const string &classPath)
+{
+	vector<string> options;
+
+	string archiveDir = GetEnvVariable(x_cdsArchiveDirEnvVariable);
+
+	if (!archiveDir.empty())
+	{
+		int javaVersion = GetJavaMajorVersion();
+
+		if (javaVersion < x_minCdsJavaVersion)
+		{
+			LOG("Class data sharing archives require Java " + to_string(x_minCdsJavaVersion) +
+				" or later, detected Java version: " + to_string(javaVersion));
+			return options;
+		}
+
+		string archivePath = CombinePath(
+			archiveDir,
+			"java-extension-" + GetClassPathFingerprint(jvmPath, classPath) + ".jsa");
+
+		if (IsValidFile(archivePath))
+		{
+			LOG("Using class data sharing archive: " + archivePath);
+
+			options.push_back(x_sharedArchiveFileOption + "=" + archivePath);
+		}
+		else if (CanArchiveClassesAtExit())
+		{
+			LOG("Creating class data sharing archive when the JVM exits: " + archivePath);
+
+			g_cdsArchive = archivePath;
+			g_cdsArchiveTemp = archivePath + "." + to_string(GetCurrentProcessIdentifier()) + ".tmp";
+
+			options.push_back(x_archiveClassesAtExitOption + "=" + g_cdsArchiveTemp);
+		}
+		else
+		{
+			LOG("Class data sharing archive not found, it can be created offline with " +
+				x_archiveClassesAtExitOption + "=" + archivePath + " and classpath: " + classPath);
+		}
+	}
+
+	return options;
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetJavaMajorVersion
+//
+// Description:
+//  Reads the major Java version from the JAVA_VERSION entry of the release file in JRE_HOME,
+//  e.g. JAVA_VERSION="11.0.2" or JAVA_VERSION="1.8.0_242".
+//
+// Returns:
+//  The major version, 0 if it cannot be determined
+//
+int JavaExtensionUtils::GetJavaMajorVersion()
+{
+	int result = 0;
+
+	string jreHome = GetEnvVariable("JRE_HOME");
+
+	if (!jreHome.empty())
+	{
+		const string versionPrefix = "JAVA_VERSION=\"";
+
+		ifstream releaseFile(CombinePath(jreHome, "release"));
+		string line;
+
+		while (getline(releaseFile, line))
+		{
+			if (line.compare(0, versionPrefix.length(), versionPrefix) == 0)
+			{
+				vector<string> parts = SplitString(line.substr(versionPrefix.length()), '.');
+
+				// Versions before Java 9 are numbered 1.x
+				//
+				size_t index = (parts.size() > 1 && parts[0] == "1") ? 1 : 0;
+
+				if (index < parts.size())
+				{
+					result = atoi(parts[index].c_str());
+				}
+
+				break;
+			}
+		}
+	}
+
+	return result;
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::PublishClassDataSharingArchive
+//
+// Description:
+//  Renames the archive written by the destroyed JVM to its final name. If another process
+//  published the archive first or the rename fails, the temporary file is removed. Failures
+//  are only logged, the archive is then created again by a later session.
+//
+void JavaExtensionUtils::PublishClassDataSharingArchive()
+{
+	if (!g_cdsArchiveTemp.empty())
+	{
+		if (!IsValidFile(g_cdsArchiveTemp))
+		{
+			LOG("Class data sharing archive was not written: " + g_cdsArchiveTemp);
+		}
+		else if (rename(g_cdsArchiveTemp.c_str(), g_cdsArchive.c_str()) == 0)
+		{
+			LOG("Created class data sharing archive: " + g_cdsArchive);
+		}
+		else
+		{
+			LOG("Failed to create class data sharing archive: " + g_cdsArchive);
+			remove(g_cdsArchiveTemp.c_str());
+		}
+
+		g_cdsArchive.clear();
+		g_cdsArchiveTemp.clear();
+	}
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetClassPathFingerprint
+//
+// Description:
+//  Computes a 64 bit FNV-1a hash of the JVM path, the classpath and the size and last
+//  modification time of each classpath entry. Directories and wildcard entries are covered by
+//  the modification time of the directory, which changes when files are added or removed.
+//
+// Returns:
+//  The fingerprint as a hexadecimal string
+//
+string JavaExtensionUtils::GetClassPathFingerprint(const string &jvmPath, const string &classPath)
+{
+	const unsigned long long fnvPrime = 1099511628211ULL;
+	unsigned long long hash = 14695981039346656037ULL;
+
+	auto hashBytes = [&hash, fnvPrime](const void *data, size_t size)
+	{
+		const unsigned char *bytes = static_cast<const unsigned char*>(data);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * fnvPrime;
+		}
+	};
+
+	hashBytes(jvmPath.data(), jvmPath.size());
+	hashBytes(classPath.data(), classPath.size());
+
+	vector<string> entries = SplitString(classPath, GetClassPathSeparator());
+
+	for (string &entry : entries)
+	{
+		// A wildcard entry covers all the jars of the directory
+		//
+		if (!entry.empty() && entry.back() == '*')
+		{
+			entry.pop_back();
+		}
+
+		unsigned long long size = 0;
+		long long lastWriteTime = 0;
+
+		if (GetFileInfo(entry, size, lastWriteTime))
+		{
+			hashBytes(&size, sizeof(size));
+			hashBytes(&lastWriteTime, sizeof(lastWriteTime));
+		}
+	}
+
+	ostringstream fingerprint;
+	fingerprint << hex << setw(16) << setfill('0') << hash;
+
+	return fingerprint.str();
+}
@@ -10,11 +10,22 @@
 //
 //*********************************************************************
 #include "JavaLibraryUtils.h"
+#include "JavaExtensionUtils.h"
 #include "JavaPathSettings.h"
 #include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 
+// Extension of the file caching the list of files of a library directory. The cache is stored
+// next to the library directory, since writing into the directory would change it.
+//
+const string x_classPathCacheExtension = ".classpath";
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaLibraryUtils::GetLibrariesClassPath
 //
@@ -24,7 +35,8 @@ using namespace std;
 //	that the full path for jars in the class path.
 //
 // Notes:
-//	First private libraries are added to the classpath then public libraries.
+//	First private libraries are added to the classpath then public libraries. The jars of a
+//	directory are sorted by name, so the classpath does not depend on the directory order.
 //
 // Returns:
 //  The classpath of all the jars in the library management directories
@@ -39,7 +51,7 @@ string JavaLibraryUtils::GetLibrariesClassPath()
 
 	if (!privateLibraryPath.empty())
 	{
-		FindAppendFileNames(privateLibraryPath, classPath);
+		AppendLibraryFileNames(privateLibraryPath, classPath);
 	}
 
 	// Check if the public library path was sent from SQL Server.
@@ -48,8 +60,163 @@ string JavaLibraryUtils::GetLibrariesClassPath()
 
 	if (!publicLibraryPath.empty())
 	{
-		FindAppendFileNames(publicLibraryPath, classPath);
+		AppendLibraryFileNames(publicLibraryPath, classPath);
 	}
 
 	return classPath;
 }
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaLibraryUtils::AppendLibraryFileNames
+//
+// Description:
+//	Appends the files of a library directory to the classpath. Scanning a directory with many jars,
+//	possibly on network storage, is costly, so the list of files is cached on disk with the last
+//	modification time of the directory. Installing or removing a library changes the modification
+//	time, in which case the directory is scanned again and the cache rewritten.
+//
+// Notes:
+//	Failing to read or write the cache is not an error, the directory is scanned instead.
+//
+void JavaLibraryUtils::AppendLibraryFileNames(const string &libraryPath, string &classPath)
+{
+	vector<string> fileNames;
+
+	string cachePath = libraryPath;
+	while (cachePath.size() > 1 && (cachePath.back() == '/' || cachePath.back() == '\\'))
+	{
+		cachePath.pop_back();
+	}
+
+	cachePath += x_classPathCacheExtension;
+
+	unsigned long long size = 0;
+	long long lastWriteTime = 0;
+	bool isCacheable = JavaExtensionUtils::GetFileInfo(libraryPath, size, lastWriteTime);
+
+	if (!isCacheable || !ReadClassPathCache(cachePath, lastWriteTime, fileNames))
+	{
+		FindFileNames(libraryPath, fileNames);
+		sort(fileNames.begin(), fileNames.end());
+
+		if (isCacheable)
+		{
+			WriteClassPathCache(cachePath, lastWriteTime, fileNames);
+		}
+	}
+
+	for (const string &fileName : fileNames)
+	{
+		// Add the separator if needed.
+		//
+		if (!classPath.empty())
+		{
+			classPath += JavaExtensionUtils::GetClassPathSeparator();
+		}
+
+		classPath += fileName;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaLibraryUtils::ReadClassPathCache
+//
+// Description:
+//	Reads the cached list of files of a library directory. The first line of the cache holds the
+//	last modification time of the directory and the number of files, followed by a file per line.
+//
+// Returns:
+//	true if the cache exists, is complete and matches the modification time, else false
+//
+bool JavaLibraryUtils::ReadClassPathCache(
+	const string   &cachePath,
+	long long      lastWriteTime,
+	vector<string> &fileNames)
+{
+	bool result = false;
+
+	ifstream cache(cachePath);
+	long long cachedWriteTime = 0;
+	size_t numFiles = 0;
+
+	if (cache >> cachedWriteTime >> numFiles && cachedWriteTime == lastWriteTime)
+	{
+		string fileName;
+
+		// Skip the end of the first line
+		//
+		getline(cache, fileName);
+
+		while (fileNames.size() < numFiles && getline(cache, fileName))
+		{
+			fileNames.push_back(fileName);
+		}
+
+		// A cache written concurrently by another process may be incomplete
+		//
+		result = fileNames.size() == numFiles;
+		if (!result)
+		{
+			fileNames.clear();
+		}
+	}
+
+	return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaLibraryUtils::WriteClassPathCache
+//
+// Description:
+//	Writes the list of files of a library directory to the cache. The list is written to a file
+//	unique to the process and thread and then renamed over the cache, so that concurrent readers
+//	see either the previous or the new cache but never a partial one.
+//
+// Notes:
+//	Failures are only logged, the directory is then scanned again by the next session.
+//
+void JavaLibraryUtils::WriteClassPathCache(
+	const string         &cachePath,
+	long long            lastWriteTime,
+	const vector<string> &fileNames)
+{
+	ostringstream tempPath;
+	tempPath << cachePath << "." << JavaExtensionUtils::GetCurrentProcessIdentifier() << "."
+		<< hash<thread::id>()(this_thread::get_id()) << ".tmp";
+
+	bool written = false;
+
+	{
+		ofstream cache(tempPath.str(), ios::trunc);
+
+		if (cache)
+		{
+			cache << lastWriteTime << " " << fileNames.size() << "\n";
+
+			for (const string &fileName : fileNames)
+			{
+				cache << fileName << "\n";
+			}
+
+			cache.close();
+		}
+
+		written = !cache.fail();
+	}
+
+	// rename() does not replace an existing file on Windows, so the stale cache is removed and
+	// the rename retried
+	//
+	if (written &&
+		rename(tempPath.str().c_str(), cachePath.c_str()) != 0 &&
+		(remove(cachePath.c_str()) != 0 || rename(tempPath.str().c_str(), cachePath.c_str()) != 0))
+	{
+		written = false;
+	}
+
+	if (!written)
+	{
+		LOG("Could not write the classpath cache " + cachePath);
+		remove(tempPath.str().c_str());
+	}
+}
@@ -15,6 +15,7 @@
 #include "JniTypeHelper.h"
 #include "Logger.h"
 #include <cassert>
+#include <chrono>
 #include <regex>
 
 using namespace std;
@@ -88,10 +89,17 @@ void JavaSession::Init(
 	//
 	m_mainClassName = GetUserDefinedClass(script, scriptLength);
 
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
 	InitUserClassObject();
 
 	GetUserClassInfo();
 
+	chrono::milliseconds elapsed = chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now() - start);
+
+	LOG("Loading user class " + m_mainClassName + " took " + to_string(elapsed.count()) + " ms.");
+
 	CallUserInit();
 
 	m_args.Init(parametersNumber);
@@ -193,11 +201,44 @@ void JavaSession::ExecuteWorkflow(
 
 	*outputSchemaColumnsNumber = 0;
 
+	// The statistics are only collected when they are logged, through the host or in debug builds
+	//
+#ifdef DEBUG
+	m_collectStats = true;
+#else
+	m_collectStats = Logger::HasLogXEventCallback();
+#endif
+
+	m_stats = JavaExecutionStats();
+
+	jlong gcCount = 0;
+	jlong gcTimeMs = 0;
+
+	if (m_collectStats)
+	{
+		JniHelper::GetGarbageCollectionStats(m_env, gcCount, gcTimeMs);
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
 	// In case of streaming clean up the previous stream batch's output buffers
 	//
 	CleanupOutputDataBuffers();
 
+	m_stats.cleanupTime = chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now() - start);
+
 	CallUserExecute(rowsNumber, data, strLen_or_Ind, outputSchemaColumnsNumber);
+
+	if (m_collectStats)
+	{
+		JniHelper::GetGarbageCollectionStats(m_env, m_stats.gcCount, m_stats.gcTimeMs);
+
+		m_stats.gcCount -= gcCount;
+		m_stats.gcTimeMs -= gcTimeMs;
+
+		LogExecutionStats();
+	}
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -273,13 +314,23 @@ void JavaSession::CallUserExecute(
 
 	*outputSchemaColumnsNumber = 0;
 
-	JavaDataset inputDataset;
+	// The input dataset and the parameter map are created for the first batch and reused by
+	// the following batches of a stream, which only replace the column data
+	//
+	if (m_inputDataset == nullptr)
+	{
+		unique_ptr<JavaDataset> inputDataset(new JavaDataset());
+
+		inputDataset->Init(m_env, m_inputDatasetClassName);
+
+		m_inputDataset = move(inputDataset);
+	}
 
-	inputDataset.Init(m_env, m_inputDatasetClassName);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
 
 	// Add the input columns
 	//
-	inputDataset.AddColumns(
+	m_inputDataset->AddColumns(
 		m_inputSchemaColumnsNumber,
 		rowsNumber,
 		m_inputDataTypes,
@@ -292,7 +343,12 @@ void JavaSession::CallUserExecute(
 
 	// Create the map for input/output parameters
 	//
-	m_argMap = m_args.CreateArgMap(m_env);
+	if (m_argMap == nullptr)
+	{
+		m_argMap = m_args.CreateArgMap(m_env);
+	}
+
+	chrono::steady_clock::time_point inputEnd = chrono::steady_clock::now();
 
 	// Find the execute() method to call
 	//
@@ -300,11 +356,13 @@ void JavaSession::CallUserExecute(
 
 	jobject outputDatasetObj = m_env->CallObjectMethod(m_userObject,
 													   methodId,
-													   inputDataset.GetJavaObject(),
+													   m_inputDataset->GetJavaObject(),
 													   m_argMap);
 
 	JniHelper::ThrowOnJavaException(m_env);
 
+	chrono::steady_clock::time_point executeEnd = chrono::steady_clock::now();
+
 	// Get the results if there are any
 	//
 	if (outputDatasetObj != nullptr)
@@ -321,10 +379,63 @@ void JavaSession::CallUserExecute(
 			m_outputDecimalDigits,
 			m_outputNullColumns,
 			m_outputData,
-			m_outputNullMap);
+			m_outputNullMap,
+			m_outputDataBuffers,
+			m_outputNullMapBuffers);
 
 		*outputSchemaColumnsNumber = m_outputSchemaColumnsNumber;
 	}
+
+	m_stats.inputTime = chrono::duration_cast<chrono::microseconds>(inputEnd - start);
+	m_stats.executeTime = chrono::duration_cast<chrono::microseconds>(executeEnd - inputEnd);
+	m_stats.outputTime = chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now() - executeEnd);
+
+	if (m_collectStats)
+	{
+		m_stats.inputRows = rowsNumber;
+		m_stats.inputBytes = JavaDataset::GetColumnsSizeInBytes(m_inputSchemaColumnsNumber,
+																rowsNumber,
+																m_inputDataTypes,
+																strLen_or_Ind);
+
+		if (outputDatasetObj != nullptr)
+		{
+			m_stats.outputRows = m_numberOfOutputRows;
+			m_stats.outputBytes = JavaDataset::GetColumnsSizeInBytes(m_outputSchemaColumnsNumber,
+																	 m_numberOfOutputRows,
+																	 m_outputDataTypes,
+																	 m_outputNullMap.data());
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: JavaSession::LogExecutionStats
+//
+// Description:
+//	Logs the timings, sizes and garbage collections of the phases of the last execution as an
+//	XEvent of the session when the host provided a LogXEvent callback, and to the extension log
+//	otherwise.
+//
+void JavaSession::LogExecutionStats()
+{
+	string msg = "Java execution statistics: cleanup " + to_string(m_stats.cleanupTime.count()) +
+		" us; input " + to_string(m_stats.inputRows) + " rows, " +
+		to_string(m_stats.inputBytes) + " bytes, " + to_string(m_stats.inputTime.count()) +
+		" us; execute " + to_string(m_stats.executeTime.count()) + " us; output " +
+		to_string(m_stats.outputRows) + " rows, " + to_string(m_stats.outputBytes) + " bytes, " +
+		to_string(m_stats.outputTime.count()) + " us; GC " + to_string(m_stats.gcCount) +
+		" collections, " + to_string(m_stats.gcTimeMs) + " ms.";
+
+	if (Logger::HasLogXEventCallback())
+	{
+		Logger::LogXEvent(m_sessionId, m_taskId, Extension_Verbose, msg);
+	}
+	else
+	{
+		LOG(msg);
+	}
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -617,6 +728,31 @@ void JavaSession::CleanupOutputDataBuffers()
 	//
 	for (unsigned int i = 0; i < m_outputData.size(); ++i)
 	{
+		// Columns returned in direct buffers are owned by the Java buffer objects,
+		// release the global references instead of deleting the data
+		//
+		if (i < m_outputDataBuffers.size() && m_outputDataBuffers[i] != nullptr)
+		{
+			if (m_env != nullptr)
+			{
+				m_env->DeleteGlobalRef(m_outputDataBuffers[i]);
+			}
+
+			m_outputDataBuffers[i] = nullptr;
+			m_outputData[i] = nullptr;
+		}
+
+		if (i < m_outputNullMapBuffers.size() && m_outputNullMapBuffers[i] != nullptr)
+		{
+			if (m_env != nullptr)
+			{
+				m_env->DeleteGlobalRef(m_outputNullMapBuffers[i]);
+			}
+
+			m_outputNullMapBuffers[i] = nullptr;
+			m_outputNullMap[i] = nullptr;
+		}
+
 		if (m_outputData[i] != nullptr)
 		{
 			// Since we store the pointers to output data buffers as void pointers,
@@ -78,3 +78,68 @@ jmethodID JniHelper::FindMethod(
 
 	return result;
 }
+
+//--------------------------------------------------------------------------------------------------
+// Name: JniHelper::GetGarbageCollectionStats
+//
+// Description:
+//  Sums the collection count and the collection time of the GarbageCollectorMXBeans of the JVM.
+//  Collectors that do not report a value, returning -1, are not counted.
+//
+void JniHelper::GetGarbageCollectionStats(
+	JNIEnv *env,
+	jlong  &collectionCount,
+	jlong  &collectionTimeMs)
+{
+	collectionCount = 0;
+	collectionTimeMs = 0;
+
+	// Max number of local references for this function are 5:
+	// 1 for the ManagementFactory class
+	// 1 for the list of collectors and 1 for its class
+	// 1 for the GarbageCollectorMXBean class
+	// 1 for the collector being read
+	//
+	AutoJniLocalFrame jFrame(env, 5);
+
+	jclass factoryClass = env->FindClass("java/lang/management/ManagementFactory");
+	ThrowOnJavaException(env);
+
+	jmethodID getCollectorsMethod = env->GetStaticMethodID(factoryClass,
+														   "getGarbageCollectorMXBeans",
+														   "()Ljava/util/List;");
+	ThrowOnJavaException(env);
+
+	jobject collectors = env->CallStaticObjectMethod(factoryClass, getCollectorsMethod);
+	ThrowOnJavaException(env);
+
+	jclass listClass = env->GetObjectClass(collectors);
+	jmethodID sizeMethod = FindMethod(env, listClass, "size", "()I");
+	jmethodID getMethod = FindMethod(env, listClass, "get", "(I)Ljava/lang/Object;");
+
+	jclass collectorClass = env->FindClass("java/lang/management/GarbageCollectorMXBean");
+	ThrowOnJavaException(env);
+
+	jmethodID countMethod = FindMethod(env, collectorClass, "getCollectionCount", "()J");
+	jmethodID timeMethod = FindMethod(env, collectorClass, "getCollectionTime", "()J");
+
+	jint numCollectors = env->CallIntMethod(collectors, sizeMethod);
+	ThrowOnJavaException(env);
+
+	for (jint i = 0; i < numCollectors; ++i)
+	{
+		jobject collector = env->CallObjectMethod(collectors, getMethod, i);
+		ThrowOnJavaException(env);
+
+		jlong count = env->CallLongMethod(collector, countMethod);
+		ThrowOnJavaException(env);
+
+		jlong timeMs = env->CallLongMethod(collector, timeMethod);
+		ThrowOnJavaException(env);
+
+		collectionCount += count > 0 ? count : 0;
+		collectionTimeMs += timeMs > 0 ? timeMs : 0;
+
+		env->DeleteLocalRef(collector);
+	}
+}
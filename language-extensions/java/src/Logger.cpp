@@ -14,6 +14,12 @@
 
 using namespace std;
 
+// Extension name reported in the XEvents of the extension
+//
+const string x_extensionName = "Java";
+
+atomic<PFunc_ExtensionLogXEvent> Logger::logXEventCallback(nullptr);
+
 //---------------------------------------------------------------------
 // Name: LogError
 //
@@ -61,3 +67,53 @@ void Logger::Log(const string &msg)
 	cout << GetCurrentTimestamp() << msg << endl;
 #endif
 }
+
+//---------------------------------------------------------------------
+// Name: SetLogXEventCallback
+//
+// Description:
+//  Set the LogXEvent callback received from the host in SetHostCallbacks.
+//
+void Logger::SetLogXEventCallback(PFunc_ExtensionLogXEvent callback)
+{
+	logXEventCallback.store(callback);
+}
+
+//---------------------------------------------------------------------
+// Name: HasLogXEventCallback
+//
+// Description:
+//  Returns true if the host provided a LogXEvent callback.
+//
+bool Logger::HasLogXEventCallback()
+{
+	return logXEventCallback.load() != nullptr;
+}
+
+//---------------------------------------------------------------------
+// Name: LogXEvent
+//
+// Description:
+//  Log a message as an XEvent of the session through the LogXEvent
+//  callback of the host. Does nothing if there is no callback.
+//
+void Logger::LogXEvent(
+	const SQLGUID       &sessionId,
+	SQLUSMALLINT        taskId,
+	ExtensionTraceLevel traceLevel,
+	const string        &msg)
+{
+	PFunc_ExtensionLogXEvent callback = logXEventCallback.load();
+
+	if (callback != nullptr)
+	{
+		callback(reinterpret_cast<const SQLCHAR*>(x_extensionName.c_str()),
+				 x_extensionName.length(),
+				 sessionId,
+				 taskId,
+				 static_cast<SQLUSMALLINT>(traceLevel),
+				 0,
+				 reinterpret_cast<const SQLCHAR*>(msg.c_str()),
+				 msg.length());
+	}
+}
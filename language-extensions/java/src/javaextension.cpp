@@ -18,35 +18,102 @@
 #include "JavaPathSettings.h"
 #include "Logger.h"
 #include "sqlexternallanguage.h"
+#include "sqlextensionhostcallbacks.h"
+#include <cstddef>
+#include <mutex>
 
 using namespace std;
 
-// Pointer to native interface
+// Sessions initialized by ExtHost keyed by session ID and task ID. Each session keeps track of its
+// input data information, java class information, and output data information. All sessions
+// share the one JVM, so the tasks of a parallel query can execute concurrently.
 //
-static JNIEnv *g_env = nullptr;
+static unordered_map<string, JavaSession*> g_sessions;
 
-// A global object to keep track of the input data information,
-// java class information, and output data information
+// Guards g_sessions. ExtHost does not call into a single session concurrently, so the sessions
+// themselves do not need to be guarded.
 //
-static JavaSession *g_sessionData = nullptr;
+static mutex g_sessionsMutex;
 
 //--------------------------------------------------------------------------------------------------
-// Name: CheckSessionEnvInitialized
+// Name: GetSessionKey
 //
 // Description:
-//	Throws a runtime_error exception of a function is called before the session environment has
-//	been initialized
+//	Returns the key of a session in the session map
 //
-void CheckSessionEnvInitialized(string &&FuncName)
+string GetSessionKey(const SQLGUID &SessionId, SQLUSMALLINT TaskId)
 {
-	if (g_env == nullptr)
+	return JniTypeHelper::ConvertGuidToString(&SessionId) + ":" + to_string(TaskId);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: GetSession
+//
+// Description:
+//	Returns the session for the session ID and task ID, set up to use the JNI environment of the
+//	calling thread. Throws a runtime_error exception if a function is called before the extension
+//	or the session has been initialized.
+//
+JavaSession* GetSession(
+	string       &&FuncName,
+	JNIEnv       *env,
+	const SQLGUID &SessionId,
+	SQLUSMALLINT TaskId)
+{
+	if (env == nullptr)
 	{
 		throw runtime_error("Function " + FuncName + " called before extension is initialized");
 	}
-	else if (g_sessionData == nullptr)
+
+	JavaSession *session = nullptr;
+
+	{
+		lock_guard<mutex> lock(g_sessionsMutex);
+
+		unordered_map<string, JavaSession*>::const_iterator it =
+			g_sessions.find(GetSessionKey(SessionId, TaskId));
+
+		if (it != g_sessions.end())
+		{
+			session = it->second;
+		}
+	}
+
+	if (session == nullptr)
 	{
 		throw runtime_error("Function " + FuncName + " called before session is initialized");
 	}
+
+	session->SetEnv(env);
+
+	return session;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Name: RemoveSession
+//
+// Description:
+//	Removes the session for the session ID and task ID from the session map
+//
+// Returns:
+//	The removed session, nullptr if there is no such session
+//
+JavaSession* RemoveSession(const SQLGUID &SessionId, SQLUSMALLINT TaskId)
+{
+	JavaSession *session = nullptr;
+
+	lock_guard<mutex> lock(g_sessionsMutex);
+
+	unordered_map<string, JavaSession*>::iterator it =
+		g_sessions.find(GetSessionKey(SessionId, TaskId));
+
+	if (it != g_sessions.end())
+	{
+		session = it->second;
+		g_sessions.erase(it);
+	}
+
+	return session;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -93,7 +160,7 @@ SQLRETURN Init(
 			languagePath,
 			publicLibraryPath,
 			privateLibraryPath);
-		g_env = JavaExtensionUtils::CreateJvm();
+		JavaExtensionUtils::CreateJvm();
 	}
 	catch (exception &ex)
 	{
@@ -139,34 +206,55 @@ SQLRETURN InitSession(
 	LOG(msg);
 
 	SQLRETURN result = SQL_SUCCESS;
+	AutoJniThreadAttach jThread;
 
 	try
 	{
-		if (g_env == nullptr)
+		if (jThread.GetEnv() == nullptr)
 		{
 			throw runtime_error("Function InitSession() called before extension is initialized");
 		}
 
-		g_sessionData = new JavaSession();
-
 		string guidToString = JniTypeHelper::ConvertGuidToString(&SessionId);
 
 		msg = "Starting session: " + guidToString + " with task id: " +
 			  to_string(TaskId) + ".";
 		LOG(msg);
 
-		g_sessionData->Init(g_env,
-							SessionId,
-							TaskId,
-							NumTasks,
-							Script,
-							ScriptLength,
-							InputSchemaColumnsNumber,
-							ParametersNumber,
-							InputDataName,
-							InputDataNameLength,
-							OutputDataName,
-							OutputDataNameLength);
+		unique_ptr<JavaSession> session(new JavaSession());
+
+		session->Init(jThread.GetEnv(),
+					  SessionId,
+					  TaskId,
+					  NumTasks,
+					  Script,
+					  ScriptLength,
+					  InputSchemaColumnsNumber,
+					  ParametersNumber,
+					  InputDataName,
+					  InputDataNameLength,
+					  OutputDataName,
+					  OutputDataNameLength);
+
+		JavaSession *previousSession = nullptr;
+
+		{
+			lock_guard<mutex> lock(g_sessionsMutex);
+
+			JavaSession *&entry = g_sessions[GetSessionKey(SessionId, TaskId)];
+			previousSession = entry;
+			entry = session.release();
+		}
+
+		// Clean up a session that was initialized again without being cleaned up
+		//
+		if (previousSession != nullptr)
+		{
+			previousSession->SetEnv(jThread.GetEnv());
+			previousSession->Cleanup();
+
+			delete previousSession;
+		}
 	}
 	catch (java_exception_error &ex)
 	{
@@ -174,7 +262,7 @@ SQLRETURN InitSession(
 
 		LOG_JAVA_EXCEPTION(ex.what());
 
-		JniHelper::LogJavaException(g_env);
+		JniHelper::LogJavaException(jThread.GetEnv());
 	}
 	catch (exception &ex)
 	{
@@ -221,11 +309,17 @@ SQLRETURN InitColumn(
 
 	SQLRETURN result = SQL_SUCCESS;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("InitColumn");
+		JavaSession *session = GetSession(
+			"InitColumn",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->InitColumn(
+		session->InitColumn(
 			ColumnNumber,
 			ColumnName,
 			ColumnNameLength,
@@ -242,7 +336,7 @@ SQLRETURN InitColumn(
 
 		LOG_JAVA_EXCEPTION(ex.what());
 
-		JniHelper::LogJavaException(g_env);
+		JniHelper::LogJavaException(jThread.GetEnv());
 	}
 	catch (exception &ex)
 	{
@@ -288,11 +382,17 @@ SQLRETURN InitParam(
 
 	SQLRETURN result = SQL_SUCCESS;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("InitParam");
+		JavaSession *session = GetSession(
+			"InitParam",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->InitParam(
+		session->InitParam(
 			ParamNumber,
 			ParamName,
 			ParamNameLength,
@@ -309,7 +409,7 @@ SQLRETURN InitParam(
 
 		LOG_JAVA_EXCEPTION(ex.what());
 
-		JniHelper::LogJavaException(g_env);
+		JniHelper::LogJavaException(jThread.GetEnv());
 	}
 	catch (exception &ex)
 	{
@@ -353,11 +453,17 @@ SQLRETURN Execute(
 	SQLRETURN result = SQL_SUCCESS;
 	*OutputSchemaColumnsNumber = 0;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("Execute");
+		JavaSession *session = GetSession(
+			"Execute",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->ExecuteWorkflow(
+		session->ExecuteWorkflow(
 			RowsNumber,
 			Data,
 			StrLen_or_Ind,
@@ -369,7 +475,7 @@ SQLRETURN Execute(
 
 		LOG_JAVA_EXCEPTION(ex.what());
 
-		JniHelper::LogJavaException(g_env);
+		JniHelper::LogJavaException(jThread.GetEnv());
 	}
 	catch (exception &ex)
 	{
@@ -410,11 +516,17 @@ SQLRETURN GetResultColumn(
 
 	SQLRETURN result = SQL_SUCCESS;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("GetResultColumn");
+		JavaSession *session = GetSession(
+			"GetResultColumn",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->GetResultColumn(
+		session->GetResultColumn(
 			ColumnNumber,
 			DataType,
 			ColumnSize,
@@ -458,11 +570,17 @@ SQLRETURN GetResults(
 
 	SQLRETURN result = SQL_SUCCESS;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("GetResults");
+		JavaSession *session = GetSession(
+			"GetResults",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->GetResults(
+		session->GetResults(
 			RowsNumber,
 			Data,
 			StrLen_or_Ind);
@@ -503,11 +621,17 @@ SQLRETURN GetOutputParam(
 
 	SQLRETURN result = SQL_SUCCESS;
 
+	AutoJniThreadAttach jThread;
+
 	try
 	{
-		CheckSessionEnvInitialized("GetOutputParam");
+		JavaSession *session = GetSession(
+			"GetOutputParam",
+			jThread.GetEnv(),
+			SessionId,
+			TaskId);
 
-		g_sessionData->GetOutputParam(
+		session->GetOutputParam(
 			ParamNumber,
 			ParamValue,
 			StrLen_or_Ind);
@@ -518,7 +642,7 @@ SQLRETURN GetOutputParam(
 
 		LOG_JAVA_EXCEPTION(ex.what());
 
-		JniHelper::LogJavaException(g_env);
+		JniHelper::LogJavaException(jThread.GetEnv());
 	}
 	catch (const exception &ex)
 	{
@@ -550,14 +674,18 @@ SQLRETURN CleanupSession(SQLGUID SessionId, SQLUSMALLINT TaskId)
 {
 	LOG("JavaExtension::CleanupSession");
 
+	AutoJniThreadAttach jThread;
+
 	// Clean up the session
 	//
-	if (g_sessionData != nullptr)
+	JavaSession *session = RemoveSession(SessionId, TaskId);
+
+	if (session != nullptr)
 	{
-		g_sessionData->Cleanup();
+		session->SetEnv(jThread.GetEnv());
+		session->Cleanup();
 
-		delete g_sessionData;
-		g_sessionData = nullptr;
+		delete session;
 	}
 
 	return SQL_SUCCESS;
@@ -577,9 +705,49 @@ SQLRETURN Cleanup()
 	string msg = "Calling cleanup";
 	LOG(msg);
 
+	// Stop logging through the host before it unloads the extension
+	//
+	Logger::SetLogXEventCallback(nullptr);
+
 	// Cleanup JVM
 	//
 	JavaExtensionUtils::CleanupJvm();
 
 	return SQL_SUCCESS;
 }
+
+//--------------------------------------------------------------------------------------------------
+// Name: SetHostCallbacks
+//
+// Description:
+//	Receives the callbacks of the host. The LogXEvent callback is used to log the execution
+//	statistics of the sessions as XEvents.
+//
+// Returns:
+//	SQL_SUCCESS on success, else SQL_ERROR
+//
+SQLRETURN SetHostCallbacks(
+	SQLEXTENSION_HOST_CALLBACKS *Callbacks)
+{
+	LOG("JavaExtension::SetHostCallbacks");
+
+	if (Callbacks == nullptr)
+	{
+		LOG_ERROR("SetHostCallbacks called with null pointer");
+		return SQL_ERROR;
+	}
+
+	// Validate the version and size of the struct before reading the callbacks
+	//
+	if (Callbacks->Version < SQLEXTENSION_HOST_CALLBACKS_MIN_SUPPORTED_VERSION ||
+		Callbacks->SizeInBytes < offsetof(SQLEXTENSION_HOST_CALLBACKS, LogXEvent) +
+			sizeof(PFunc_ExtensionLogXEvent))
+	{
+		LOG_ERROR("SetHostCallbacks called with unsupported host callbacks version");
+		return SQL_ERROR;
+	}
+
+	Logger::SetLogXEventCallback(Callbacks->LogXEvent);
+
+	return SQL_SUCCESS;
+}
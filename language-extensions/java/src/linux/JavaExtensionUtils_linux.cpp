@@ -130,6 +130,34 @@ bool JavaExtensionUtils::IsValidFile(const string &file)
 	return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetFileInfo
+//
+// Description:
+//  Gets the size and last modification time of a file or directory. The modification time is
+//  in nanoseconds, so that changes within the same second are told apart.
+//
+// Returns:
+//  Returns true if the path exists, else false
+//
+bool JavaExtensionUtils::GetFileInfo(
+	const string       &path,
+	unsigned long long &size,
+	long long          &lastWriteTime)
+{
+	struct stat st;
+	bool result = false;
+
+	if (stat(path.c_str(), &st) == 0)
+	{
+		size = static_cast<unsigned long long>(st.st_size);
+		lastWriteTime = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+		result = true;
+	}
+
+	return result;
+}
+
 //----------------------------------------------------------------------------
 // Name: JavaExtensionUtils::LoadJvm
 //
@@ -179,6 +207,29 @@ void JavaExtensionUtils::ShutdownJvm(JavaVM *jvm)
 	jvm = nullptr;
 }
 
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::CanArchiveClassesAtExit
+//
+// Description:
+//  The JVM is never destroyed on Linux (see ShutdownJvm), so it cannot write a class data
+//  sharing archive at exit. The archive has to be created offline.
+//
+bool JavaExtensionUtils::CanArchiveClassesAtExit()
+{
+	return false;
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetCurrentProcessIdentifier
+//
+// Description:
+//  Gets the id of the current process
+//
+unsigned long JavaExtensionUtils::GetCurrentProcessIdentifier()
+{
+	return static_cast<unsigned long>(getpid());
+}
+
 //----------------------------------------------------------------------------
 // Name: JavaExtensionUtils::UnloadJvm
 //
@@ -18,10 +18,10 @@
 using namespace std;
 
 //----------------------------------------------------------------------------
-// Name: JavaLibraryUtils::AppendFileNames
+// Name: JavaLibraryUtils::FindFileNames
 //
 // Description:
-//	Finds all files under the base directory and appends them to the output.
+//	Finds all files under the base directory and adds their paths to fileNames.
 //
 // Notes:
 //	This function will silently fail if an error occurs, this is expected
@@ -30,7 +30,7 @@ using namespace std;
 // Returns:
 //  none
 //
-void JavaLibraryUtils::FindAppendFileNames(const string &basePath, string &output)
+void JavaLibraryUtils::FindFileNames(const string &basePath, vector<string> &fileNames)
 {
 	DIR *directory = nullptr;
 	struct dirent *entry = nullptr;
@@ -45,14 +45,7 @@ void JavaLibraryUtils::FindAppendFileNames(const string &basePath, string &outpu
 
 			if (fileName.compare("..") != 0 && fileName.compare(".") != 0)
 			{
-				// Add the separator if needed.
-				//
-				if (!output.empty())
-				{
-					output += JavaExtensionUtils::GetClassPathSeparator();
-				}
-
-				output += basePath + "/" + fileName;
+				fileNames.push_back(basePath + "/" + fileName);
 			}
 
 			// Get next entry
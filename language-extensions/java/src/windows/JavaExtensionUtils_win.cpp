@@ -91,6 +91,35 @@ bool JavaExtensionUtils::IsValidFile(const string &file)
 	return GetFileAttributesA(file.c_str()) != INVALID_FILE_ATTRIBUTES;
 }
 
+//--------------------------------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetFileInfo
+//
+// Description:
+//  Gets the size and last modification time of a file or directory
+//
+// Returns:
+//  Returns true if the path exists, else false
+//
+bool JavaExtensionUtils::GetFileInfo(
+	const string       &path,
+	unsigned long long &size,
+	long long          &lastWriteTime)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	bool result = false;
+
+	if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+	{
+		size = (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+		lastWriteTime = static_cast<long long>(
+			(static_cast<unsigned long long>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+			data.ftLastWriteTime.dwLowDateTime);
+		result = true;
+	}
+
+	return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Name: JavaExtensionUtils::GetEnvVariable
 //
@@ -164,6 +193,10 @@ void JavaExtensionUtils::ShutdownJvm(JavaVM *jvm)
 		if (rc == 0)
 		{
 			jvm = nullptr;
+
+			// The class data sharing archive requested at start has been written now
+			//
+			PublishClassDataSharingArchive();
 		}
 		else
 		{
@@ -173,6 +206,29 @@ void JavaExtensionUtils::ShutdownJvm(JavaVM *jvm)
 	}
 }
 
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::CanArchiveClassesAtExit
+//
+// Description:
+//  The JVM is destroyed on Windows (see ShutdownJvm), so it can write a class data sharing
+//  archive at exit
+//
+bool JavaExtensionUtils::CanArchiveClassesAtExit()
+{
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Name: JavaExtensionUtils::GetCurrentProcessIdentifier
+//
+// Description:
+//  Gets the id of the current process
+//
+unsigned long JavaExtensionUtils::GetCurrentProcessIdentifier()
+{
+	return static_cast<unsigned long>(GetCurrentProcessId());
+}
+
 //----------------------------------------------------------------------------
 // Name: JavaExtensionUtils::UnloadJvm
 //
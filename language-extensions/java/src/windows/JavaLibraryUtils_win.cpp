@@ -15,10 +15,10 @@
 using namespace std;
 
 //----------------------------------------------------------------------------
-// Name: JavaLibraryUtils::AppendFileNames
+// Name: JavaLibraryUtils::FindFileNames
 //
 // Description:
-//	Finds all files under the base directory and appends them to the output.
+//	Finds all files under the base directory and adds their paths to fileNames.
 //
 // Notes:
 //	This function will silently fail if an error occurs, this is expected
@@ -27,7 +27,7 @@ using namespace std;
 // Returns:
 //  none
 //
-void JavaLibraryUtils::FindAppendFileNames(const string &basePath, string &output)
+void JavaLibraryUtils::FindFileNames(const string &basePath, vector<string> &fileNames)
 {
 	// String to indicate we should find all files under this directory
 	//
@@ -61,14 +61,7 @@ void JavaLibraryUtils::FindAppendFileNames(const string &basePath, string &outpu
 				continue;
 			}
 
-			// Add the separator if needed.
-			//
-			if (!output.empty())
-			{
-				output += JavaExtensionUtils::GetClassPathSeparator();
-			}
-
-			output += basePath + "\\" + string(ffa.cFileName);
+			fileNames.push_back(basePath + "\\" + string(ffa.cFileName));
 		} while (FindNextFileA(hFind, &ffa) != 0);
 
 		FindClose(hFind);
@@ -0,0 +1,242 @@
+//*********************************************************************
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// @File: JniTypeHelperBenchmark.cpp
+//
+// Purpose:
+//  Measures the copies of fixed width columns between ODBC buffers and Java arrays done by
+//  JniTypeHelper::CopyInputData and CopyOutputData against the per element loops they replaced,
+//  for each primitive type and several ratios of null rows. The copies do not call JNI, so the
+//  benchmark runs them on plain buffers without a JVM.
+//
+//  Usage: JavaExtension-benchmark [rowsNumber] [repetitions]
+//
+//*********************************************************************
+#include "JniHelper.h"
+#include "JniTypeHelper.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	// Percentages of null rows of the measured input columns
+	//
+	const int x_nullPercentages[] = { 0, 10, 50 };
+
+	//----------------------------------------------------------------------------------------------
+	// Name: PreviousCopyInputData
+	//
+	// Description:
+	//  The per element input copy that CopyInputData replaced: each value is assigned and then
+	//  overwritten with the default value when the row is null.
+	//
+	template<typename jType, typename cType>
+	__attribute__((noinline)) void PreviousCopyInputData(
+		jsize            numRows,
+		const cType      *odbcData,
+		const SQLINTEGER *nullMap,
+		jType            *jData)
+	{
+		char defaultNullVal = 0;
+
+		for (SQLULEN i = 0; i < static_cast<SQLULEN>(numRows); ++i)
+		{
+			jData[i] = odbcData[i];
+			if (nullMap != nullptr && nullMap[i] == SQL_NULL_DATA)
+			{
+				jData[i] = defaultNullVal;
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: PreviousCopyOutputData
+	//
+	// Description:
+	//  The per element output copy that CopyOutputData replaced
+	//
+	template<typename jType, typename cType>
+	__attribute__((noinline)) void PreviousCopyOutputData(
+		jsize       numRows,
+		const jType *outputColData,
+		cType       *returnData)
+	{
+		for (jint i = 0; i < numRows; ++i)
+		{
+			returnData[i] = static_cast<cType>(outputColData[i]);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CurrentCopyInputData
+	//
+	// Description:
+	//  Calls JniTypeHelper::CopyInputData, kept out of line like the previous copy
+	//
+	template<typename jType, typename cType>
+	__attribute__((noinline)) void CurrentCopyInputData(
+		jsize            numRows,
+		const cType      *odbcData,
+		const SQLINTEGER *nullMap,
+		jType            *jData)
+	{
+		JniTypeHelper::CopyInputData<jType, cType>(
+			nullptr, // env
+			numRows,
+			const_cast<cType*>(odbcData),
+			nullMap,
+			jData);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CurrentCopyOutputData
+	//
+	// Description:
+	//  Calls JniTypeHelper::CopyOutputData, kept out of line like the previous copy
+	//
+	template<typename jType, typename cType>
+	__attribute__((noinline)) void CurrentCopyOutputData(
+		jsize       numRows,
+		const jType *outputColData,
+		cType       *returnData)
+	{
+		SQLULEN dataSizeInBytes = 0;
+		JniTypeHelper::CopyOutputData<jType, cType>(outputColData, numRows, returnData, dataSizeInBytes);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: Measure
+	//
+	// Description:
+	//  Runs the given copy the given number of times.
+	//
+	// Returns:
+	//  The shortest time of one run, in nanoseconds per row
+	//
+	template<typename CopyFunction>
+	double Measure(
+		jsize        numRows,
+		int          repetitions,
+		CopyFunction copy)
+	{
+		double best = 0;
+
+		for (int repetition = 0; repetition < repetitions; ++repetition)
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			copy();
+			chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+
+			if (repetition == 0 || elapsed.count() < best)
+			{
+				best = elapsed.count();
+			}
+		}
+
+		return best / numRows;
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: RunBenchmark
+	//
+	// Description:
+	//  Measures the input copy of a column of the given type for each percentage of null rows,
+	//  then the output copy, and prints one line for each with the previous and current times.
+	//  Exits with a failure if the copies do not produce the same Java array or ODBC buffer.
+	//
+	template<typename jType, typename cType>
+	void RunBenchmark(
+		const string &typeName,
+		jsize        numRows,
+		int          repetitions)
+	{
+		vector<cType> odbcData(numRows);
+		for (jsize i = 0; i < numRows; ++i)
+		{
+			odbcData[i] = static_cast<cType>(i % 101);
+		}
+
+		vector<jType> previousData(numRows);
+		vector<jType> currentData(numRows);
+
+		for (int nullPercentage : x_nullPercentages)
+		{
+			// Scatter the null rows pseudo randomly, so that branches on them are not predicted
+			//
+			vector<SQLINTEGER> nullMap(numRows, sizeof(cType));
+			unsigned int seed = 1;
+			for (jsize i = 0; i < numRows; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				if (static_cast<int>((seed >> 16) % 100) < nullPercentage)
+				{
+					nullMap[i] = SQL_NULL_DATA;
+				}
+			}
+
+			const SQLINTEGER *nullMapData = nullPercentage == 0 ? nullptr : nullMap.data();
+
+			double previous = Measure(numRows, repetitions, [&]()
+				{ PreviousCopyInputData(numRows, odbcData.data(), nullMapData, previousData.data()); });
+			double current = Measure(numRows, repetitions, [&]()
+				{ CurrentCopyInputData(numRows, odbcData.data(), nullMapData, currentData.data()); });
+
+			if (previousData != currentData)
+			{
+				printf("%s input copies differ\n", typeName.c_str());
+				exit(EXIT_FAILURE);
+			}
+
+			printf("%-9s input   %3d%% nulls  %8.3f  %8.3f  %6.2fx\n",
+				typeName.c_str(), nullPercentage, previous, current, previous / current);
+		}
+
+		vector<cType> previousOutput(numRows);
+		vector<cType> currentOutput(numRows);
+
+		double previous = Measure(numRows, repetitions, [&]()
+			{ PreviousCopyOutputData(numRows, currentData.data(), previousOutput.data()); });
+		double current = Measure(numRows, repetitions, [&]()
+			{ CurrentCopyOutputData(numRows, currentData.data(), currentOutput.data()); });
+
+		if (previousOutput != currentOutput)
+		{
+			printf("%s output copies differ\n", typeName.c_str());
+			exit(EXIT_FAILURE);
+		}
+
+		printf("%-9s output             %8.3f  %8.3f  %6.2fx\n",
+			typeName.c_str(), previous, current, previous / current);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	jsize numRows = argc > 1 ? atoi(argv[1]) : 1000000;
+	int repetitions = argc > 2 ? atoi(argv[2]) : 30;
+
+	if (numRows <= 0 || repetitions <= 0)
+	{
+		printf("Usage: JavaExtension-benchmark [rowsNumber] [repetitions]\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("Best of %d runs over %d rows, in nanoseconds per row\n\n", repetitions, numRows);
+	printf("%-9s %-7s %-11s %8s  %8s  %7s\n", "Type", "Copy", "", "Previous", "Current", "Speedup");
+
+	RunBenchmark<jint, SQLINTEGER>("INTEGER", numRows, repetitions);
+	RunBenchmark<jlong, SQLBIGINT>("BIGINT", numRows, repetitions);
+	RunBenchmark<jshort, SQLSMALLINT>("SMALLINT", numRows, repetitions);
+	RunBenchmark<jshort, SQLCHAR>("TINYINT", numRows, repetitions);
+	RunBenchmark<jboolean, SQLCHAR>("BIT", numRows, repetitions);
+	RunBenchmark<jfloat, SQLREAL>("REAL", numRows, repetitions);
+	RunBenchmark<jdouble, SQLDOUBLE>("FLOAT", numRows, repetitions);
+
+	return EXIT_SUCCESS;
+}
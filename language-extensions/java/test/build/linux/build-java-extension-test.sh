@@ -0,0 +1,78 @@
+#!/bin/bash
+
+function check_exit_code {
+	EXIT_CODE=$?
+	if [ ${EXIT_CODE} -eq 0 ]; then
+		echo $1
+	else
+		echo $2
+		exit ${EXIT_CODE}
+	fi
+}
+
+function build {
+	# Set cmake config to first arg
+	#
+	CMAKE_CONFIGURATION=$1
+	if [ -z "${CMAKE_CONFIGURATION}" ]; then
+		CMAKE_CONFIGURATION=release
+	fi
+
+	rm -rf ${JAVAEXTENSIONTEST_WORKING_DIR}/${CMAKE_CONFIGURATION}
+	mkdir -p ${JAVAEXTENSIONTEST_WORKING_DIR}/${CMAKE_CONFIGURATION}
+
+	pushd ${JAVAEXTENSIONTEST_WORKING_DIR}
+
+	# Compile
+	#
+	cmake -DCMAKE_INSTALL_PREFIX:PATH=${JAVAEXTENSIONTEST_WORKING_DIR}/${CMAKE_CONFIGURATION} \
+		-DCMAKE_BUILD_TYPE=${CMAKE_CONFIGURATION} \
+		-DENL_ROOT=${ENL_ROOT} \
+		-DPLATFORM=linux \
+		-DJAVA_HOME=${JAVA_HOME} \
+		${JAVAEXTENSIONTEST_SRC_DIR}
+	cmake --build ${JAVAEXTENSIONTEST_WORKING_DIR} --target install
+
+	# Check the exit code of the compiler and exit appropriately so that build will fail.
+	#
+	check_exit_code "Success: Built JavaExtension-test" "Error: Failed to build JavaExtension-test"
+
+	popd
+}
+
+# Enlistment root and location of JavaExtension-test
+#
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+ENL_ROOT=${SCRIPTDIR}/../../../../..
+JAVAEXTENSIONTEST_HOME=${ENL_ROOT}/language-extensions/java/test
+
+# Set environment variables required in Cmake
+#
+JAVAEXTENSIONTEST_SRC_DIR=${JAVAEXTENSIONTEST_HOME}/src
+JAVAEXTENSIONTEST_WORKING_DIR=${ENL_ROOT}/build-output/JavaExtension-test/linux
+DEFAULT_JAVA_HOME=/usr/lib/jvm/java-17-openjdk-amd64
+
+# Find JAVA_HOME from user, or set to default for tests.
+# Error code 1 is generic bash error.
+#
+if [ -z "${JAVA_HOME}" ]; then
+	if [ -d "${DEFAULT_JAVA_HOME}" ]; then
+		JAVA_HOME=${DEFAULT_JAVA_HOME}
+	else
+		echo "JAVA_HOME is empty"
+		exit 1
+	fi
+fi
+
+# Build in release mode if nothing is specified
+#
+if [ "$1" == "" ]; then
+	set -- release
+fi
+
+while [ "$1" != "" ]; do
+	# Advance arg passed to build.sh
+	#
+	build $1
+	shift
+done;
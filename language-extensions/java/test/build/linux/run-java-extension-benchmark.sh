@@ -0,0 +1,48 @@
+#!/bin/bash
+
+function check_exit_code {
+	EXIT_CODE=$?
+	if [ ${EXIT_CODE} -eq 0 ]; then
+		echo $1
+	else
+		echo $2
+		exit ${EXIT_CODE}
+	fi
+}
+
+function run {
+	# Set cmake config to first arg
+	CMAKE_CONFIGURATION=$1
+	if [ -z "${CMAKE_CONFIGURATION}" ]; then
+		CMAKE_CONFIGURATION=release
+	fi
+
+	pushd ${JAVAEXTENSIONTEST_WORKING_DIR}/${CMAKE_CONFIGURATION}
+	./JavaExtension-benchmark ${BENCHMARK_ARGS}
+
+	# Check the exit code of the benchmark.
+	check_exit_code "Success: Ran JavaExtension-benchmark" "Error: JavaExtension-benchmark failed"
+
+	popd
+}
+
+# Enlistment root and location of JavaExtension-benchmark, which is installed with JavaExtension-test
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+ENL_ROOT=${SCRIPTDIR}/../../../../..
+JAVAEXTENSIONTEST_WORKING_DIR=${ENL_ROOT}/build-output/JavaExtension-test/linux
+
+# Number of rows and repetitions passed to the benchmark, e.g. BENCHMARK_ARGS="1000000 30"
+#
+BENCHMARK_ARGS=${BENCHMARK_ARGS:-}
+
+# Benchmark in release mode if nothing is specified
+#
+if [ "$1" == "" ]; then
+	set -- release
+fi
+
+while [ "$1" != "" ]; do
+	# Advance arg passed to run-java-extension-benchmark.sh
+	run $1
+	shift
+done;
@@ -0,0 +1,44 @@
+#!/bin/bash
+
+function check_exit_code {
+	EXIT_CODE=$?
+	if [ ${EXIT_CODE} -eq 0 ]; then
+		echo $1
+	else
+		echo $2
+		exit ${EXIT_CODE}
+	fi
+}
+
+function run {
+	# Set cmake config to first arg
+	CMAKE_CONFIGURATION=$1
+	if [ -z "${CMAKE_CONFIGURATION}" ]; then
+		CMAKE_CONFIGURATION=release
+	fi
+
+	pushd ${JAVAEXTENSIONTEST_WORKING_DIR}/${CMAKE_CONFIGURATION}
+	./JavaExtension-test --gtest_output=xml:${ENL_ROOT}/out/TestReport_JavaExtension-test.xml
+
+	# Check the exit code of the tests.
+	check_exit_code "Success: Ran JavaExtension-test" "Error: JavaExtension-test failed"
+
+	popd
+}
+
+# Enlistment root and location of JavaExtension-test
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+ENL_ROOT=${SCRIPTDIR}/../../../../..
+JAVAEXTENSIONTEST_WORKING_DIR=${ENL_ROOT}/build-output/JavaExtension-test/linux
+
+# Test in release mode if nothing is specified
+#
+if [ "$1" == "" ]; then
+	set -- release
+fi
+
+while [ "$1" != "" ]; do
+	# Advance arg passed to run-java-extension-test.sh
+	run $1
+	shift
+done;
@@ -0,0 +1,54 @@
+#!/bin/bash
+
+function check_exit_code {
+	EXIT_CODE=$?
+	if [ ${EXIT_CODE} -eq 0 ]; then
+		echo $1
+	else
+		echo $2
+		exit ${EXIT_CODE}
+	fi
+}
+
+# Enlistment root and location of the SDK sources and tests
+#
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+ENL_ROOT=${SCRIPTDIR}/../../../../..
+SDK_SRC_DIR=${ENL_ROOT}/language-extensions/java/sdk/src/java
+SDKTEST_WORKING_DIR=${ENL_ROOT}/build-output/java-sdk-test/linux
+DEFAULT_JAVA_HOME=/usr/lib/jvm/java-17-openjdk-amd64
+
+# JUnit 4 and Hamcrest jars, installed by the junit4 package of restore-packages.sh
+#
+if [ -z "${JUNIT_CLASSPATH}" ]; then
+	JUNIT_CLASSPATH=/usr/share/java/junit4.jar:/usr/share/java/hamcrest-core.jar
+fi
+
+# Find JAVA_HOME from user, or set to default for tests.
+# Error code 1 is generic bash error.
+#
+if [ -z "${JAVA_HOME}" ]; then
+	if [ -d "${DEFAULT_JAVA_HOME}" ]; then
+		JAVA_HOME=${DEFAULT_JAVA_HOME}
+	else
+		echo "JAVA_HOME is empty"
+		exit 1
+	fi
+fi
+
+rm -rf ${SDKTEST_WORKING_DIR}
+mkdir -p ${SDKTEST_WORKING_DIR}/classes
+
+# Compile the SDK and its tests
+#
+find ${SDK_SRC_DIR}/main/java ${SDK_SRC_DIR}/test/java -name "*.java" > ${SDKTEST_WORKING_DIR}/sources.txt
+${JAVA_HOME}/bin/javac -encoding UTF-8 -cp ${JUNIT_CLASSPATH} -d ${SDKTEST_WORKING_DIR}/classes @${SDKTEST_WORKING_DIR}/sources.txt
+
+check_exit_code "Success: Built the SDK tests" "Error: Failed to build the SDK tests"
+
+# Run every test class
+#
+TEST_CLASSES=$(cd ${SDK_SRC_DIR}/test/java && find . -name "*Tests.java" | sed -e 's|^\./||' -e 's|\.java$||' -e 's|/|.|g')
+${JAVA_HOME}/bin/java -cp ${SDKTEST_WORKING_DIR}/classes:${JUNIT_CLASSPATH} org.junit.runner.JUnitCore ${TEST_CLASSES}
+
+check_exit_code "Success: Ran the SDK tests" "Error: SDK tests failed"
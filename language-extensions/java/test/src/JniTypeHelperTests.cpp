@@ -0,0 +1,354 @@
+//*********************************************************************
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// @File: JniTypeHelperTests.cpp
+//
+// Purpose:
+//  Tests the round trip of fixed width columns and null maps through the JniTypeHelper copies
+//  between ODBC buffers and Java arrays. These copies run inside critical array regions and do
+//  not call JNI, so the tests run them on plain buffers without a JVM.
+//
+//*********************************************************************
+#include "JniHelper.h"
+#include "JniTypeHelper.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace std;
+
+namespace JavaExtensionTest
+{
+	//----------------------------------------------------------------------------------------------
+	// Name: CheckInputOutputRoundTrip
+	//
+	// Description:
+	//  Copies the ODBC values into a Java array, checks that null rows hold the default value and
+	//  the other rows the converted value, then copies the Java array back and checks that the
+	//  values of the rows that are not null are unchanged.
+	//
+	template<typename jType, typename cType>
+	void CheckInputOutputRoundTrip(
+		const vector<cType>      &values,
+		const vector<SQLINTEGER> &nullMap)
+	{
+		jsize numRows = static_cast<jsize>(values.size());
+		const SQLINTEGER *nullMapData = nullMap.empty() ? nullptr : nullMap.data();
+
+		// Fill the Java array with a value that is neither the default nor an input value, as
+		// an array reused from a previous batch would be
+		//
+		vector<jType> jData(values.size(), static_cast<jType>(42));
+
+		JniTypeHelper::CopyInputData<jType, cType>(
+			nullptr, // env
+			numRows,
+			const_cast<cType*>(values.data()),
+			nullMapData,
+			jData.data());
+
+		for (jsize i = 0; i < numRows; ++i)
+		{
+			if (nullMapData != nullptr && nullMapData[i] == SQL_NULL_DATA)
+			{
+				EXPECT_EQ(jData[i], jType());
+			}
+			else
+			{
+				EXPECT_EQ(jData[i], static_cast<jType>(values[i]));
+			}
+		}
+
+		vector<cType> outputData(values.size());
+		SQLULEN dataSizeInBytes = 0;
+
+		JniTypeHelper::CopyOutputData<jType, cType>(
+			jData.data(),
+			numRows,
+			outputData.data(),
+			dataSizeInBytes);
+
+		EXPECT_EQ(dataSizeInBytes, sizeof(cType));
+
+		for (jsize i = 0; i < numRows; ++i)
+		{
+			if (nullMapData == nullptr || nullMapData[i] != SQL_NULL_DATA)
+			{
+				EXPECT_EQ(outputData[i], values[i]);
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyIntegerInputDataTest
+	//
+	// Description:
+	//  Round trip of an INTEGER column with and without null rows
+	//
+	TEST(JniTypeHelperTests, CopyIntegerInputDataTest)
+	{
+		vector<SQLINTEGER> values = { 1, -2, numeric_limits<SQLINTEGER>::max(), 0,
+			numeric_limits<SQLINTEGER>::min() };
+
+		CheckInputOutputRoundTrip<jint, SQLINTEGER>(values, {});
+		CheckInputOutputRoundTrip<jint, SQLINTEGER>(
+			values,
+			{ sizeof(SQLINTEGER), SQL_NULL_DATA, sizeof(SQLINTEGER), SQL_NULL_DATA,
+			  sizeof(SQLINTEGER) });
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyBigIntInputDataTest
+	//
+	// Description:
+	//  Round trip of a BIGINT column with and without null rows
+	//
+	TEST(JniTypeHelperTests, CopyBigIntInputDataTest)
+	{
+		vector<SQLBIGINT> values = { numeric_limits<SQLBIGINT>::min(), -1, 0,
+			numeric_limits<SQLBIGINT>::max() };
+
+		CheckInputOutputRoundTrip<jlong, SQLBIGINT>(values, {});
+		CheckInputOutputRoundTrip<jlong, SQLBIGINT>(
+			values,
+			{ SQL_NULL_DATA, sizeof(SQLBIGINT), sizeof(SQLBIGINT), SQL_NULL_DATA });
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopySmallIntInputDataTest
+	//
+	// Description:
+	//  Round trip of a SMALLINT column with null rows
+	//
+	TEST(JniTypeHelperTests, CopySmallIntInputDataTest)
+	{
+		vector<SQLSMALLINT> values = { numeric_limits<SQLSMALLINT>::min(), 7,
+			numeric_limits<SQLSMALLINT>::max() };
+
+		CheckInputOutputRoundTrip<jshort, SQLSMALLINT>(
+			values,
+			{ sizeof(SQLSMALLINT), SQL_NULL_DATA, sizeof(SQLSMALLINT) });
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyTinyIntInputDataTest
+	//
+	// Description:
+	//  Round trip of a TINYINT column, which is widened to short in Java. Values above 127 must
+	//  stay positive.
+	//
+	TEST(JniTypeHelperTests, CopyTinyIntInputDataTest)
+	{
+		vector<SQLCHAR> values = { 0, 1, 127, 128, 255 };
+
+		CheckInputOutputRoundTrip<jshort, SQLCHAR>(values, {});
+		CheckInputOutputRoundTrip<jshort, SQLCHAR>(
+			values,
+			{ sizeof(SQLCHAR), sizeof(SQLCHAR), SQL_NULL_DATA, sizeof(SQLCHAR), sizeof(SQLCHAR) });
+
+		vector<jshort> jData(values.size());
+
+		JniTypeHelper::CopyInputData<jshort, SQLCHAR>(
+			nullptr, // env
+			static_cast<jsize>(values.size()),
+			values.data(),
+			nullptr, // nullMap
+			jData.data());
+
+		EXPECT_EQ(jData[3], 128);
+		EXPECT_EQ(jData[4], 255);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyBitInputDataTest
+	//
+	// Description:
+	//  Round trip of a BIT column with null rows
+	//
+	TEST(JniTypeHelperTests, CopyBitInputDataTest)
+	{
+		CheckInputOutputRoundTrip<jboolean, SQLCHAR>(
+			{ 1, 0, 1, 1 },
+			{ sizeof(SQLCHAR), sizeof(SQLCHAR), SQL_NULL_DATA, sizeof(SQLCHAR) });
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyFloatInputDataTest
+	//
+	// Description:
+	//  Round trip of FLOAT and REAL columns with null rows, including infinite, negative zero and
+	//  NaN values
+	//
+	TEST(JniTypeHelperTests, CopyFloatInputDataTest)
+	{
+		CheckInputOutputRoundTrip<jdouble, SQLDOUBLE>(
+			{ 1.5, -0.0, numeric_limits<SQLDOUBLE>::infinity(), numeric_limits<SQLDOUBLE>::max() },
+			{ sizeof(SQLDOUBLE), sizeof(SQLDOUBLE), sizeof(SQLDOUBLE), SQL_NULL_DATA });
+
+		CheckInputOutputRoundTrip<jfloat, SQLREAL>(
+			{ -2.25f, numeric_limits<SQLREAL>::lowest(), 3.0f },
+			{ SQL_NULL_DATA, sizeof(SQLREAL), sizeof(SQLREAL) });
+
+		// Negative zero is kept, not mistaken for a null row
+		//
+		vector<SQLDOUBLE> values = { -0.0 };
+		vector<SQLINTEGER> nullMap = { sizeof(SQLDOUBLE) };
+		jdouble jData = 42;
+
+		JniTypeHelper::CopyInputData<jdouble, SQLDOUBLE>(
+			nullptr, // env
+			1,
+			values.data(),
+			nullMap.data(),
+			&jData);
+
+		EXPECT_EQ(jData, 0.0);
+		EXPECT_TRUE(signbit(jData));
+
+		// NaN values are kept and null rows are positive zero, whatever the buffer holds
+		//
+		vector<SQLREAL> realValues = { numeric_limits<SQLREAL>::quiet_NaN(), numeric_limits<SQLREAL>::quiet_NaN() };
+		vector<SQLINTEGER> realNullMap = { sizeof(SQLREAL), SQL_NULL_DATA };
+		vector<jfloat> jRealData(realValues.size(), 42);
+
+		JniTypeHelper::CopyInputData<jfloat, SQLREAL>(
+			nullptr, // env
+			static_cast<jsize>(realValues.size()),
+			realValues.data(),
+			realNullMap.data(),
+			jRealData.data());
+
+		EXPECT_TRUE(isnan(jRealData[0]));
+		EXPECT_EQ(jRealData[1], 0.0f);
+		EXPECT_FALSE(signbit(jRealData[1]));
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyAllNullInputDataTest
+	//
+	// Description:
+	//  A column of only null rows resets every value of a reused Java array to the default
+	//
+	TEST(JniTypeHelperTests, CopyAllNullInputDataTest)
+	{
+		const jsize numRows = 100;
+
+		vector<SQLINTEGER> values(numRows, 5);
+		vector<SQLINTEGER> nullMap(numRows, SQL_NULL_DATA);
+		vector<jint> jData(numRows, 42);
+
+		JniTypeHelper::CopyInputData<jint, SQLINTEGER>(
+			nullptr, // env
+			numRows,
+			values.data(),
+			nullMap.data(),
+			jData.data());
+
+		for (jint value : jData)
+		{
+			EXPECT_EQ(value, 0);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: CopyEmptyInputDataTest
+	//
+	// Description:
+	//  No values or no rows leave the Java array unchanged
+	//
+	TEST(JniTypeHelperTests, CopyEmptyInputDataTest)
+	{
+		vector<SQLINTEGER> values = { 1, 2 };
+		vector<SQLINTEGER> nullMap = { SQL_NULL_DATA, SQL_NULL_DATA };
+		vector<jint> jData = { 42, 42 };
+
+		JniTypeHelper::CopyInputData<jint, SQLINTEGER>(
+			nullptr, // env
+			2,
+			nullptr, // values
+			nullMap.data(),
+			jData.data());
+
+		JniTypeHelper::CopyInputData<jint, SQLINTEGER>(
+			nullptr, // env
+			0,
+			values.data(),
+			nullMap.data(),
+			jData.data());
+
+		EXPECT_EQ(jData[0], 42);
+		EXPECT_EQ(jData[1], 42);
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: NullBitmapRoundTripTest
+	//
+	// Description:
+	//  Round trip of a null map through the Java null bitmap, with null rows at the boundaries of
+	//  the 64 bit words
+	//
+	TEST(JniTypeHelperTests, NullBitmapRoundTripTest)
+	{
+		const SQLULEN numRows = 130;
+
+		vector<SQLINTEGER> nullMap(numRows, sizeof(SQLINTEGER));
+		nullMap[0] = SQL_NULL_DATA;
+		nullMap[63] = SQL_NULL_DATA;
+		nullMap[64] = SQL_NULL_DATA;
+		nullMap[129] = SQL_NULL_DATA;
+
+		EXPECT_TRUE(JniTypeHelper::HasNullData(numRows, nullMap.data()));
+
+		vector<jlong> jNullBitmap((numRows + 63) / 64, -1);
+
+		JniTypeHelper::CopyNullBitmapInputData(numRows, nullMap.data(), jNullBitmap.data());
+
+		EXPECT_EQ(static_cast<unsigned long long>(jNullBitmap[0]), (1ULL << 63) | 1ULL);
+		EXPECT_EQ(jNullBitmap[1], 1);
+		EXPECT_EQ(jNullBitmap[2], 2);
+
+		vector<SQLINTEGER> outputNullMap(numRows, SQL_NULL_DATA);
+
+		JniTypeHelper::CopyNullBitmapOutputData(jNullBitmap.data(), numRows, outputNullMap.data());
+
+		for (SQLULEN i = 0; i < numRows; ++i)
+		{
+			EXPECT_EQ(outputNullMap[i] == SQL_NULL_DATA, nullMap[i] == SQL_NULL_DATA);
+		}
+
+		vector<SQLINTEGER> noNulls(numRows, sizeof(SQLINTEGER));
+
+		EXPECT_FALSE(JniTypeHelper::HasNullData(numRows, noNulls.data()));
+	}
+
+	//----------------------------------------------------------------------------------------------
+	// Name: NullBitmapRowsPastEndTest
+	//
+	// Description:
+	//  Checks that bits past the last row of a null bitmap are detected when the number of rows is
+	//  not a multiple of 64, and that the last row itself is not mistaken for one of them
+	//
+	TEST(JniTypeHelperTests, NullBitmapRowsPastEndTest)
+	{
+		const SQLULEN numRows = 70;
+
+		vector<jlong> jNullBitmap((numRows + 63) / 64, 0);
+		jNullBitmap[0] = -1;
+		jNullBitmap[1] = 1LL << 5;
+
+		EXPECT_FALSE(JniTypeHelper::HasNullBitmapRowsPastEnd(jNullBitmap.data(), numRows));
+
+		jNullBitmap[1] |= 1LL << 6;
+
+		EXPECT_TRUE(JniTypeHelper::HasNullBitmapRowsPastEnd(jNullBitmap.data(), numRows));
+
+		jNullBitmap[1] = static_cast<jlong>(1ULL << 63);
+
+		EXPECT_TRUE(JniTypeHelper::HasNullBitmapRowsPastEnd(jNullBitmap.data(), numRows));
+
+		// Every bit of the last element is a row when the number of rows is a multiple of 64
+		//
+		EXPECT_FALSE(JniTypeHelper::HasNullBitmapRowsPastEnd(jNullBitmap.data(), 128));
+	}
+}
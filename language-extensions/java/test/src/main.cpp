@@ -0,0 +1,26 @@
+//*********************************************************************
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// @File: main.cpp
+//
+// Purpose:
+//  Runs the C++ unit tests of the Java extension.
+//
+//*********************************************************************
+#include <gtest/gtest.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+	// Banner
+	//
+	std::cout << "Running JavaExtension C++ unit tests.\n";
+
+	// First, initiate Google Test framework - this will remove
+	// framework-specific parameters from argc and argv
+	//
+	::testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}